@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crc32c.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NFD_HAVE_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace nfd {
+
+// reflected Castagnoli polynomial
+const uint32_t CRC32C_POLY = 0x82F63B78;
+
+static std::array<uint32_t, 256>
+makeCrc32cTable()
+{
+  std::array<uint32_t, 256> table;
+  for (uint32_t i = 0; i < table.size(); ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) != 0 ? CRC32C_POLY : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+uint32_t
+crc32cPortable(const uint8_t* data, size_t length, uint32_t crc)
+{
+  static const auto table = makeCrc32cTable();
+
+  crc = ~crc;
+  for (size_t i = 0; i < length; ++i) {
+    crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+  }
+  return ~crc;
+}
+
+#ifdef NFD_HAVE_CRC32C_SSE42
+
+__attribute__((target("sse4.2"))) uint32_t
+crc32cSse42(const uint8_t* data, size_t length, uint32_t crc)
+{
+  uint64_t crc64 = ~crc;
+  for (; length >= 8; data += 8, length -= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+
+  uint32_t crc32 = static_cast<uint32_t>(crc64);
+  if (length >= 4) {
+    uint32_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc32 = _mm_crc32_u32(crc32, word);
+    data += 4;
+    length -= 4;
+  }
+  for (; length > 0; ++data, --length) {
+    crc32 = _mm_crc32_u8(crc32, *data);
+  }
+  return ~crc32;
+}
+
+bool
+hasCrc32cInstruction()
+{
+  static const bool hasSse42 = __builtin_cpu_supports("sse4.2");
+  return hasSse42;
+}
+
+#else
+
+uint32_t
+crc32cSse42(const uint8_t* data, size_t length, uint32_t crc)
+{
+  BOOST_ASSERT_MSG(false, "SSE4.2 is not supported on this platform");
+  return crc32cPortable(data, length, crc);
+}
+
+bool
+hasCrc32cInstruction()
+{
+  return false;
+}
+
+#endif // NFD_HAVE_CRC32C_SSE42
+
+uint32_t
+crc32c(const uint8_t* data, size_t length, uint32_t crc)
+{
+  static const bool useSse42 = hasCrc32cInstruction();
+  return useSse42 ? crc32cSse42(data, length, crc) : crc32cPortable(data, length, crc);
+}
+
+} // namespace nfd
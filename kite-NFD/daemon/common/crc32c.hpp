@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_CRC32C_HPP
+#define NFD_DAEMON_COMMON_CRC32C_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+
+/** \brief Computes CRC-32C (Castagnoli) of a buffer.
+ *
+ *  This uses the SSE4.2 CRC32 instruction if the CPU supports it, and crc32cPortable otherwise.
+ *  Both produce the same result.
+ *
+ *  \param data input buffer
+ *  \param length size of input buffer
+ *  \param crc CRC of preceding data, or zero to start a new computation
+ */
+uint32_t
+crc32c(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+/** \brief Computes CRC-32C with a lookup table, without special CPU instructions.
+ */
+uint32_t
+crc32cPortable(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+/** \brief Computes CRC-32C with the SSE4.2 CRC32 instruction.
+ *  \pre hasCrc32cInstruction()
+ */
+uint32_t
+crc32cSse42(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+/** \return whether the CPU supports the SSE4.2 CRC32 instruction
+ */
+bool
+hasCrc32cInstruction();
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_CRC32C_HPP
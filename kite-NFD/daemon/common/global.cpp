@@ -27,7 +27,8 @@
 
 namespace nfd {
 
-static thread_local unique_ptr<boost::asio::io_service> g_ioService;
+static thread_local unique_ptr<boost::asio::io_service> g_ownIoService;
+static thread_local boost::asio::io_service* g_ioService = nullptr;
 static thread_local unique_ptr<Scheduler> g_scheduler;
 static boost::asio::io_service* g_mainIoService = nullptr;
 static boost::asio::io_service* g_ribIoService = nullptr;
@@ -36,11 +37,19 @@ boost::asio::io_service&
 getGlobalIoService()
 {
   if (g_ioService == nullptr) {
-    g_ioService = make_unique<boost::asio::io_service>();
+    g_ownIoService = make_unique<boost::asio::io_service>();
+    g_ioService = g_ownIoService.get();
   }
   return *g_ioService;
 }
 
+void
+setGlobalIoService(boost::asio::io_service& io)
+{
+  BOOST_ASSERT(g_ioService == nullptr);
+  g_ioService = &io;
+}
+
 Scheduler&
 getScheduler()
 {
@@ -55,7 +64,8 @@ void
 resetGlobalIoService()
 {
   g_scheduler.reset();
-  g_ioService.reset();
+  g_ioService = nullptr;
+  g_ownIoService.reset();
 }
 #endif
 
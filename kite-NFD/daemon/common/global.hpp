@@ -34,6 +34,14 @@ namespace nfd {
 boost::asio::io_service&
 getGlobalIoService();
 
+/** \brief Makes \p io the global io_service instance for the calling thread.
+ *
+ *  \p io is not owned and must outlive the thread.
+ *  \pre getGlobalIoService() has not been called on the calling thread
+ */
+void
+setGlobalIoService(boost::asio::io_service& io);
+
 /** \brief Returns the global Scheduler instance for the calling thread.
  */
 Scheduler&
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pool-allocator.hpp"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace nfd {
+namespace detail {
+
+namespace {
+
+struct SharedPool
+{
+  std::mutex mutex;
+  std::vector<unique_ptr<uint8_t[]>> slabs;
+  /// chains of blocks moved out of per-thread free lists, by block size
+  std::map<size_t, std::vector<std::pair<PoolFreeList::Block*, size_t>>> spilled;
+};
+
+SharedPool&
+getSharedPool()
+{
+  // the pool is intentionally never freed, not even by static destructors,
+  // because objects in static storage may still hold blocks at that time
+  static auto pool = new SharedPool;
+  return *pool;
+}
+
+} // namespace
+
+void
+refillPool(PoolFreeList& freeList, size_t blockSize, size_t nBlocks)
+{
+  BOOST_ASSERT(freeList.head == nullptr);
+
+  SharedPool& pool = getSharedPool();
+  uint8_t* slab = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    auto& chains = pool.spilled[blockSize];
+    if (!chains.empty()) {
+      std::tie(freeList.head, freeList.size) = chains.back();
+      chains.pop_back();
+      return;
+    }
+    pool.slabs.push_back(make_unique<uint8_t[]>(blockSize * nBlocks));
+    slab = pool.slabs.back().get();
+  }
+
+  for (size_t i = nBlocks; i > 0; --i) {
+    auto block = reinterpret_cast<PoolFreeList::Block*>(slab + blockSize * (i - 1));
+    block->next = freeList.head;
+    freeList.head = block;
+  }
+  freeList.size = nBlocks;
+}
+
+void
+spillPool(PoolFreeList& freeList, size_t blockSize, size_t nBlocks)
+{
+  BOOST_ASSERT(nBlocks > 0 && freeList.size >= nBlocks);
+
+  auto first = freeList.head;
+  auto last = first;
+  for (size_t i = 1; i < nBlocks; ++i) {
+    last = last->next;
+  }
+  freeList.head = last->next;
+  freeList.size -= nBlocks;
+  last->next = nullptr;
+
+  SharedPool& pool = getSharedPool();
+  std::lock_guard<std::mutex> lock(pool.mutex);
+  pool.spilled[blockSize].emplace_back(first, nBlocks);
+}
+
+} // namespace detail
+} // namespace nfd
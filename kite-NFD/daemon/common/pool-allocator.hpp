@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
+#define NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
+
+#include "core/common.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+
+namespace detail {
+
+/** \brief a free list of equally sized memory blocks, owned by one thread
+ */
+struct PoolFreeList
+{
+  struct Block
+  {
+    Block* next;
+  };
+
+  Block* head = nullptr;
+  size_t size = 0;
+};
+
+/** \brief add \p nBlocks blocks to \p freeList, taking a chain of blocks spilled by
+ *         spillPool() if there is one, or else a new slab
+ *
+ *  Slabs are never returned to the heap, so that a block may be deallocated by a thread
+ *  other than the one that allocated it, even after the allocating thread has exited.
+ *  \pre \p freeList is empty
+ */
+void
+refillPool(PoolFreeList& freeList, size_t blockSize, size_t nBlocks);
+
+/** \brief move the first \p nBlocks blocks of \p freeList to the list shared by all threads
+ *  \pre freeList.size >= nBlocks
+ */
+void
+spillPool(PoolFreeList& freeList, size_t blockSize, size_t nBlocks);
+
+} // namespace detail
+
+/** \brief An allocator that serves single objects from per-thread pools.
+ *
+ *  Each thread keeps a free list of blocks for each object type. Allocating or deallocating
+ *  one object takes the first block from, or puts the block in front of, the free list of the
+ *  calling thread, without locking. Slabs of blocks are obtained from the heap when the free
+ *  list is empty. Allocations of more than one object go to the global heap.
+ *
+ *  When objects allocated by one thread are freed by another, the free list of the freeing
+ *  thread would grow without bound. Once it holds more than MAX_FREE_BLOCKS blocks, a chain of
+ *  N_PER_SLAB blocks is moved, under a mutex, to a list shared by all threads, from which the
+ *  next refill of any thread is taken before a new slab is allocated. Each thread therefore
+ *  holds at most MAX_FREE_BLOCKS free blocks per object type, and the pool as a whole at most
+ *  that much per thread beyond the peak number of live objects, rounded up to whole slabs.
+ *
+ *  This allocator suits node-based containers and std::allocate_shared, whose nodes and
+ *  control blocks are allocated one at a time.
+ *
+ *  \tparam T object type
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  static constexpr size_t N_PER_SLAB = 256;
+  static constexpr size_t MAX_FREE_BLOCKS = 4 * N_PER_SLAB;
+
+  PoolAllocator() noexcept = default;
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>&) noexcept
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    detail::PoolFreeList& freeList = getFreeList();
+    if (freeList.head == nullptr) {
+      detail::refillPool(freeList, BLOCK_SIZE, N_PER_SLAB);
+    }
+    auto block = freeList.head;
+    freeList.head = block->next;
+    --freeList.size;
+    return reinterpret_cast<T*>(block);
+  }
+
+  void
+  deallocate(T* p, size_t n) noexcept
+  {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+
+    detail::PoolFreeList& freeList = getFreeList();
+    auto block = reinterpret_cast<detail::PoolFreeList::Block*>(p);
+    block->next = freeList.head;
+    freeList.head = block;
+    if (++freeList.size > MAX_FREE_BLOCKS) {
+      detail::spillPool(freeList, BLOCK_SIZE, N_PER_SLAB);
+    }
+  }
+
+private:
+  static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are unsupported");
+
+  static constexpr size_t BLOCK_SIZE = (std::max(sizeof(T), sizeof(detail::PoolFreeList::Block)) +
+                                        alignof(std::max_align_t) - 1) /
+                                       alignof(std::max_align_t) * alignof(std::max_align_t);
+
+  static detail::PoolFreeList&
+  getFreeList() noexcept
+  {
+    static thread_local detail::PoolFreeList freeList;
+    return freeList;
+  }
+};
+
+template<typename T, typename U>
+bool
+operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool
+operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+  return false;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_POOL_ALLOCATOR_HPP
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_SLAB_POOL_HPP
+#define NFD_DAEMON_COMMON_SLAB_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief Allocates objects of type T from large slabs.
+ *
+ *  Memory of destroyed objects is kept in a free list and reused by later create() calls,
+ *  so that a steady stream of allocations and deallocations does not reach the global heap.
+ *  The slabs are released when the pool is destroyed; every object must have been destroyed
+ *  by then. The pool is not thread-safe.
+ *
+ *  \tparam T object type
+ *  \tparam N_PER_SLAB number of objects in each slab
+ */
+template<typename T, size_t N_PER_SLAB = 256>
+class SlabPool : noncopyable
+{
+public:
+  /** \brief construct an object in the pool
+   */
+  template<typename... Args>
+  T*
+  create(Args&&... args)
+  {
+    if (m_freeList == nullptr) {
+      this->addSlab();
+    }
+
+    Slot* slot = m_freeList;
+    m_freeList = slot->next;
+    try {
+      T* obj = new (&slot->storage) T(std::forward<Args>(args)...);
+      ++m_nObjects;
+      return obj;
+    }
+    catch (...) {
+      slot->next = m_freeList;
+      m_freeList = slot;
+      throw;
+    }
+  }
+
+  /** \brief destruct an object created by this pool, and keep its memory for reuse
+   */
+  void
+  destroy(T* obj)
+  {
+    BOOST_ASSERT(obj != nullptr);
+    BOOST_ASSERT(m_nObjects > 0);
+
+    obj->~T();
+    Slot* slot = reinterpret_cast<Slot*>(obj);
+    slot->next = m_freeList;
+    m_freeList = slot;
+    --m_nObjects;
+  }
+
+  /** \return number of live objects
+   */
+  size_t
+  size() const
+  {
+    return m_nObjects;
+  }
+
+  /** \return number of objects that fit in the allocated slabs
+   */
+  size_t
+  capacity() const
+  {
+    return m_slabs.size() * N_PER_SLAB;
+  }
+
+private:
+  void
+  addSlab()
+  {
+    m_slabs.push_back(make_unique<Slot[]>(N_PER_SLAB));
+    Slot* slab = m_slabs.back().get();
+    for (size_t i = N_PER_SLAB; i > 0; --i) {
+      slab[i - 1].next = m_freeList;
+      m_freeList = &slab[i - 1];
+    }
+  }
+
+private:
+  union Slot
+  {
+    Slot* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  std::vector<unique_ptr<Slot[]>> m_slabs;
+  Slot* m_freeList = nullptr;
+  size_t m_nObjects = 0;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_SLAB_POOL_HPP
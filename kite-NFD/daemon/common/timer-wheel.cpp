@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+#include "common/global.hpp"
+
+namespace nfd {
+
+constexpr time::nanoseconds TimerWheel::DEFAULT_TICK;
+
+void
+TimerWheel::Timer::cancel()
+{
+  if (m_wheel == nullptr) {
+    return;
+  }
+
+  unlink(*this);
+  --m_wheel->m_size;
+  m_wheel = nullptr;
+  m_callback = nullptr;
+}
+
+TimerWheel::TimerWheel(time::nanoseconds tickDuration)
+  : m_tickDuration(tickDuration)
+  , m_epoch(time::steady_clock::now())
+{
+  BOOST_ASSERT(m_tickDuration > 0_ns);
+}
+
+TimerWheel::~TimerWheel()
+{
+  auto cancelAll = [] (Link& head) {
+    while (head.next != &head) {
+      static_cast<Timer*>(head.next)->cancel();
+    }
+  };
+
+  cancelAll(m_due);
+  for (auto& level : m_slots) {
+    for (Link& slot : level) {
+      cancelAll(slot);
+    }
+  }
+}
+
+void
+TimerWheel::setTickDuration(time::nanoseconds tickDuration)
+{
+  BOOST_ASSERT(tickDuration > 0_ns);
+  if (tickDuration == m_tickDuration) {
+    return;
+  }
+
+  // gather pending timers, then redistribute them according to their expiry times
+  Link pending;
+  auto gather = [&pending] (Link& head) {
+    while (head.next != &head) {
+      Link& node = *head.next;
+      unlink(node);
+      link(pending, node);
+    }
+  };
+  gather(m_due);
+  for (auto& level : m_slots) {
+    for (Link& slot : level) {
+      gather(slot);
+    }
+  }
+
+  m_tickDuration = tickDuration;
+  m_epoch = time::steady_clock::now();
+  m_nextTick = 0;
+
+  while (pending.next != &pending) {
+    Timer& timer = static_cast<Timer&>(*pending.next);
+    unlink(timer);
+    timer.m_tick = this->toTick(timer.m_expiry);
+    if (timer.m_tick < m_nextTick) {
+      link(m_due, timer);
+    }
+    else {
+      this->place(timer);
+    }
+  }
+
+  m_event.cancel();
+  m_eventTime = time::steady_clock::TimePoint::max();
+  if (m_size > 0) {
+    this->arm(time::steady_clock::now());
+  }
+}
+
+void
+TimerWheel::schedule(Timer& timer, time::nanoseconds delay, std::function<void()> callback)
+{
+  timer.cancel();
+
+  auto now = time::steady_clock::now();
+  if (m_size == 0) {
+    // no timer is waiting for the ticks before now; skip them
+    m_nextTick = std::max(m_nextTick, this->toTick(now));
+  }
+
+  timer.m_wheel = this;
+  timer.m_expiry = now + std::max(delay, 0_ns);
+  timer.m_tick = this->toTick(timer.m_expiry);
+  timer.m_callback = std::move(callback);
+  ++m_size;
+
+  if (delay <= 0_ns || timer.m_tick < m_nextTick) {
+    link(m_due, timer);
+    this->arm(now);
+  }
+  else {
+    this->place(timer);
+    this->arm(this->fromTick(timer.m_tick));
+  }
+}
+
+uint64_t
+TimerWheel::toTick(time::steady_clock::TimePoint t) const
+{
+  if (t <= m_epoch) {
+    return 0;
+  }
+  // round up, so that a timer never fires early
+  auto elapsed = t - m_epoch;
+  return static_cast<uint64_t>((elapsed + m_tickDuration - 1_ns) / m_tickDuration);
+}
+
+time::steady_clock::TimePoint
+TimerWheel::fromTick(uint64_t tick) const
+{
+  return m_epoch + m_tickDuration * static_cast<int64_t>(tick);
+}
+
+void
+TimerWheel::link(Link& head, Link& node)
+{
+  node.prev = head.prev;
+  node.next = &head;
+  head.prev->next = &node;
+  head.prev = &node;
+}
+
+void
+TimerWheel::unlink(Link& node)
+{
+  node.prev->next = node.next;
+  node.next->prev = node.prev;
+  node.prev = node.next = &node;
+}
+
+void
+TimerWheel::place(Timer& timer)
+{
+  BOOST_ASSERT(timer.m_tick >= m_nextTick);
+  uint64_t delta = timer.m_tick - m_nextTick;
+  uint64_t tick = timer.m_tick;
+
+  size_t level = 0;
+  while (level + 1 < N_LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+    ++level;
+  }
+  if (delta >= (uint64_t(1) << (SLOT_BITS * N_LEVELS))) {
+    // beyond the range of the wheel: park in the farthest slot, and re-place when cascaded
+    tick = m_nextTick + (uint64_t(1) << (SLOT_BITS * N_LEVELS)) - 1;
+  }
+
+  size_t slot = (tick >> (SLOT_BITS * level)) & (N_SLOTS - 1);
+  link(m_slots[level][slot], timer);
+}
+
+void
+TimerWheel::expire(Link& batch)
+{
+  while (batch.next != &batch) {
+    Timer& timer = static_cast<Timer&>(*batch.next);
+    auto callback = std::move(timer.m_callback);
+    timer.cancel();
+    callback();
+  }
+}
+
+void
+TimerWheel::run()
+{
+  auto now = time::steady_clock::now();
+
+  // take a batch before firing it, because callbacks may schedule more timers
+  Link batch;
+  auto takeAll = [&batch] (Link& head) {
+    while (head.next != &head) {
+      Link& node = *head.next;
+      unlink(node);
+      link(batch, node);
+    }
+  };
+
+  takeAll(m_due);
+  this->expire(batch);
+
+  while (m_size > 0 && this->fromTick(m_nextTick) <= now) {
+    uint64_t tick = m_nextTick;
+
+    // move timers of the next coarser slot into finer slots when a wheel wraps around
+    for (size_t level = 1; level < N_LEVELS; ++level) {
+      if (((tick >> (SLOT_BITS * (level - 1))) & (N_SLOTS - 1)) != 0) {
+        break;
+      }
+      Link cascaded;
+      Link& slot = m_slots[level][(tick >> (SLOT_BITS * level)) & (N_SLOTS - 1)];
+      while (slot.next != &slot) {
+        Link& node = *slot.next;
+        unlink(node);
+        link(cascaded, node);
+      }
+      while (cascaded.next != &cascaded) {
+        Timer& timer = static_cast<Timer&>(*cascaded.next);
+        unlink(timer);
+        this->place(timer);
+      }
+    }
+
+    takeAll(m_slots[0][tick & (N_SLOTS - 1)]);
+    m_nextTick = tick + 1;
+    this->expire(batch);
+  }
+
+  if (m_size == 0) {
+    return;
+  }
+
+  if (m_due.next != &m_due) {
+    this->arm(now);
+    return;
+  }
+
+  // wake up at the next tick that has a timer, or where a coarser slot must be cascaded
+  for (uint64_t tick = m_nextTick; ; ++tick) {
+    const Link& slot = m_slots[0][tick & (N_SLOTS - 1)];
+    if (slot.next != &slot || (tick & (N_SLOTS - 1)) == 0) {
+      this->arm(this->fromTick(tick));
+      return;
+    }
+  }
+}
+
+void
+TimerWheel::arm(time::steady_clock::TimePoint when)
+{
+  if (m_event && m_eventTime <= when) {
+    return;
+  }
+
+  m_eventTime = when;
+  auto delay = std::max(when - time::steady_clock::now(), time::steady_clock::Duration::zero());
+  m_event = getScheduler().schedule(delay, [this] {
+    m_eventTime = time::steady_clock::TimePoint::max();
+    this->run();
+  });
+}
+
+} // namespace nfd
@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+#define NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <array>
+
+namespace nfd {
+
+/** \brief A hierarchical timing wheel.
+ *
+ *  Timers are embedded in the objects they belong to, and linked into slots of a few wheels
+ *  of increasing granularity. Scheduling and cancelling a timer are O(1) and do not allocate
+ *  memory, as long as the callback fits in std::function's internal buffer (such as a lambda
+ *  that captures two pointers).
+ *
+ *  Time is divided into ticks of a configurable duration. Timers that expire in the same tick
+ *  are processed together, by a single Scheduler event that the wheel keeps while it has any
+ *  pending timer. A timer never fires before its expiry time, and normally fires within one
+ *  tick after it.
+ */
+class TimerWheel : noncopyable
+{
+private:
+  struct Link
+  {
+    Link* prev = this;
+    Link* next = this;
+  };
+
+public:
+  /** \brief a timer that can be scheduled on a TimerWheel
+   *
+   *  A timer is cancelled when it is destructed.
+   */
+  class Timer : private Link, noncopyable
+  {
+  public:
+    Timer() = default;
+
+    ~Timer()
+    {
+      this->cancel();
+    }
+
+    /** \return whether the timer is scheduled and has not fired or been cancelled
+     */
+    bool
+    isPending() const
+    {
+      return m_wheel != nullptr;
+    }
+
+    /** \brief cancel the timer if it is pending
+     */
+    void
+    cancel();
+
+  private:
+    TimerWheel* m_wheel = nullptr;
+    uint64_t m_tick = 0;
+    time::steady_clock::TimePoint m_expiry;
+    std::function<void()> m_callback;
+
+    friend TimerWheel;
+  };
+
+  /** \brief constructor
+   *  \param tickDuration granularity of the wheel
+   *  \pre tickDuration > 0
+   */
+  explicit
+  TimerWheel(time::nanoseconds tickDuration = DEFAULT_TICK);
+
+  /** \brief cancels all pending timers
+   */
+  ~TimerWheel();
+
+  /** \return granularity of the wheel
+   */
+  time::nanoseconds
+  getTickDuration() const
+  {
+    return m_tickDuration;
+  }
+
+  /** \brief change granularity of the wheel
+   *
+   *  Pending timers keep their expiry times.
+   *  \pre tickDuration > 0
+   */
+  void
+  setTickDuration(time::nanoseconds tickDuration);
+
+  /** \return number of pending timers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \brief schedule \p timer to invoke \p callback after \p delay
+   *
+   *  If \p timer is already pending, it is rescheduled and its previous callback is dropped.
+   *  A negative delay is treated as zero; such timers fire as soon as the event loop polls,
+   *  without waiting for the next tick boundary.
+   */
+  void
+  schedule(Timer& timer, time::nanoseconds delay, std::function<void()> callback);
+
+public:
+  static constexpr time::nanoseconds DEFAULT_TICK = time::milliseconds(1);
+
+private:
+  static constexpr size_t SLOT_BITS = 6;
+  static constexpr size_t N_SLOTS = 1 << SLOT_BITS;
+  static constexpr size_t N_LEVELS = 4;
+
+  uint64_t
+  toTick(time::steady_clock::TimePoint t) const;
+
+  time::steady_clock::TimePoint
+  fromTick(uint64_t tick) const;
+
+  static void
+  link(Link& head, Link& node);
+
+  static void
+  unlink(Link& node);
+
+  /** \brief put a timer into the slot for its expiry tick
+   */
+  void
+  place(Timer& timer);
+
+  /** \brief fire timers in \p batch, in the order they were added
+   */
+  void
+  expire(Link& batch);
+
+  /** \brief process every tick up to the current time
+   */
+  void
+  run();
+
+  /** \brief ensure a Scheduler event exists to run the wheel at \p when
+   */
+  void
+  arm(time::steady_clock::TimePoint when);
+
+private:
+  time::nanoseconds m_tickDuration;
+  time::steady_clock::TimePoint m_epoch;
+  /// every tick before this one has been processed
+  uint64_t m_nextTick = 0;
+  std::array<std::array<Link, N_SLOTS>, N_LEVELS> m_slots;
+  /// timers whose expiry is already reached, to be fired at the next run
+  Link m_due;
+  size_t m_size = 0;
+
+  scheduler::ScopedEventId m_event;
+  time::steady_clock::TimePoint m_eventTime = time::steady_clock::TimePoint::max();
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_COMMON_TIMER_WHEEL_HPP
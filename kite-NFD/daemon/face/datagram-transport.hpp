@@ -200,8 +200,21 @@ template<class T, class U>
 void
 DatagramTransport<T, U>::handleReceive(const boost::system::error_code& error, size_t nBytesReceived)
 {
+  this->beginReceiveBurst();
   receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), error);
 
+  // read the datagrams already queued on the socket, so that they are delivered as one burst
+  boost::system::error_code readError = error;
+  for (size_t nPackets = 1; nPackets < MAX_RECEIVE_BURST && !readError && m_socket.is_open();
+       ++nPackets) {
+    if (m_socket.available(readError) == 0 || readError)
+      break;
+
+    nBytesReceived = m_socket.receive_from(boost::asio::buffer(m_receiveBuffer), m_sender, 0, readError);
+    receiveDatagram(ndn::make_span(m_receiveBuffer).first(nBytesReceived), readError);
+  }
+  this->endReceiveBurst();
+
   if (m_socket.is_open())
     m_socket.async_receive_from(boost::asio::buffer(m_receiveBuffer), m_sender,
                                 [this] (auto&&... args) {
@@ -33,6 +33,7 @@ Face::Face(unique_ptr<LinkService> service, unique_ptr<Transport> transport)
   , afterReceiveData(service->afterReceiveData)
   , afterReceiveNack(service->afterReceiveNack)
   , onDroppedInterest(service->onDroppedInterest)
+  , afterReceiveBurst(transport->afterReceiveBurst)
   , afterStateChange(transport->afterStateChange)
   , m_id(INVALID_FACEID)
   , m_service(std::move(service))
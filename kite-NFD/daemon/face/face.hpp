@@ -106,6 +106,11 @@ public: // upper interface connected to forwarding
    */
   signal::Signal<LinkService, Interest>& onDroppedInterest;
 
+  /** \brief signals after the transport has delivered a burst of received packets
+   *  \sa Transport::afterReceiveBurst
+   */
+  signal::Signal<Transport>& afterReceiveBurst;
+
 public: // properties
   /** \return face ID
    */
@@ -160,6 +165,12 @@ public: // properties
   FaceState
   getState() const;
 
+  /** \return whether the face is receiving a burst of packets
+   *  \sa Transport::isReceivingBurst
+   */
+  bool
+  isReceivingBurst() const;
+
   /** \brief signals after face state changed
    */
   signal::Signal<Transport, FaceState/*old*/, FaceState/*new*/>& afterStateChange;
@@ -304,6 +315,12 @@ Face::getState() const
   return m_transport->getState();
 }
 
+inline bool
+Face::isReceivingBurst() const
+{
+  return m_transport->isReceivingBurst();
+}
+
 inline time::steady_clock::TimePoint
 Face::getExpirationTime() const
 {
@@ -246,7 +246,9 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
   m_receiveBufferSize += nBytesReceived;
   auto bufferView = ndn::make_span(m_receiveBuffer, m_receiveBufferSize);
   size_t offset = 0;
+  size_t nBurstPackets = 0;
   bool isOk = true;
+  this->beginReceiveBurst();
   while (offset < bufferView.size()) {
     Block element;
     std::tie(isOk, element) = Block::fromBuffer(bufferView.subspan(offset));
@@ -256,8 +258,15 @@ StreamTransport<T>::handleReceive(const boost::system::error_code& error,
     offset += element.size();
     BOOST_ASSERT(offset <= bufferView.size());
 
+    if (nBurstPackets == MAX_RECEIVE_BURST) {
+      this->endReceiveBurst();
+      this->beginReceiveBurst();
+      nBurstPackets = 0;
+    }
     this->receive(element);
+    ++nBurstPackets;
   }
+  this->endReceiveBurst();
 
   if (!isOk && m_receiveBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0) {
     NFD_LOG_FACE_ERROR("Failed to parse incoming packet or packet too large to process");
@@ -59,6 +59,7 @@ Transport::Transport()
   , m_mtu(MTU_INVALID)
   , m_sendQueueCapacity(QUEUE_UNSUPPORTED)
   , m_state(TransportState::UP)
+  , m_isReceivingBurst(false)
   , m_expirationTime(time::steady_clock::TimePoint::max())
 {
 }
@@ -122,6 +123,21 @@ Transport::receive(const Block& packet, const EndpointId& endpoint)
   m_service->receivePacket(packet, endpoint);
 }
 
+void
+Transport::beginReceiveBurst()
+{
+  BOOST_ASSERT(!m_isReceivingBurst);
+  m_isReceivingBurst = true;
+}
+
+void
+Transport::endReceiveBurst()
+{
+  BOOST_ASSERT(m_isReceivingBurst);
+  m_isReceivingBurst = false;
+  this->afterReceiveBurst();
+}
+
 void
 Transport::setMtu(ssize_t mtu)
 {
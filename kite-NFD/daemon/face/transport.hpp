@@ -102,6 +102,10 @@ const ssize_t QUEUE_UNSUPPORTED = -1;
  */
 const ssize_t QUEUE_ERROR = -2;
 
+/** \brief maximum number of packets a transport passes to the upper layer in one receive burst
+ */
+const size_t MAX_RECEIVE_BURST = 32;
+
 /** \brief The lower half of a Face.
  *  \sa Face
  */
@@ -242,6 +246,22 @@ public: // dynamic properties
    */
   signal::Signal<Transport, TransportState/*old*/, TransportState/*new*/> afterStateChange;
 
+  /** \return whether the transport is passing a burst of received packets to the upper layer
+   *  \sa beginReceiveBurst
+   */
+  bool
+  isReceivingBurst() const
+  {
+    return m_isReceivingBurst;
+  }
+
+  /** \brief signals after the transport has passed a burst of received packets to the upper layer
+   *
+   *  Packets received within a burst may be held by the forwarder and processed together
+   *  when this signal is emitted.
+   */
+  signal::Signal<Transport> afterReceiveBurst;
+
   /** \return expiration time of the transport
    *  \retval time::steady_clock::TimePoint::max() the transport has indefinite lifetime
    */
@@ -267,6 +287,21 @@ protected: // upper interface to be invoked by subclass
   void
   receive(const Block& packet, const EndpointId& endpoint = 0);
 
+  /** \brief Indicate that the following receive() calls belong to one burst
+   *
+   *  A subclass that can read several packets in one operation (e.g. all datagrams already
+   *  queued on a socket) should call this before passing them to receive(), and call
+   *  endReceiveBurst() afterwards. A burst should contain at most MAX_RECEIVE_BURST packets.
+   */
+  void
+  beginReceiveBurst();
+
+  /** \brief Indicate the end of a burst started with beginReceiveBurst()
+   *  \post isReceivingBurst() == false
+   */
+  void
+  endReceiveBurst();
+
 protected: // properties to be set by subclass
   void
   setLocalUri(const FaceUri& uri);
@@ -348,6 +383,7 @@ private:
   ssize_t m_mtu;
   ssize_t m_sendQueueCapacity;
   TransportState m_state;
+  bool m_isReceivingBurst;
   time::steady_clock::TimePoint m_expirationTime;
 };
 
@@ -53,6 +53,13 @@ public:
   void
   addReserved(shared_ptr<Face> face, FaceId faceId);
 
+  /** \brief add a face under the FaceId that another FaceTable assigned to it
+   *
+   *  This lets the forwarding threads refer to a face by the same FaceId as the main thread.
+   */
+  void
+  addWithId(shared_ptr<Face> face, FaceId faceId);
+
   /** \brief get face by FaceId
    *  \return a face if found, nullptr if not found;
    *          face->shared_from_this() can be used if shared_ptr<Face> is desired
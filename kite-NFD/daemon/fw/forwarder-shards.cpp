@@ -0,0 +1,894 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forwarder-shards.hpp"
+#include "face-table.hpp"
+#include "forwarder.hpp"
+#include "kite-strategy.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "table/cleanup.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT(ForwarderShards);
+
+constexpr time::milliseconds ForwarderShards::STATUS_INTERVAL;
+
+/// maximum number of packets taken from a queue before yielding to other handlers
+const size_t DRAIN_BATCH = 64;
+
+struct ForwarderShards::QueuedPacket
+{
+  enum class Type {
+    INTEREST,
+    DATA,
+    NACK,
+    DROPPED_INTEREST,
+  };
+
+  Type type = Type::INTEREST;
+  /// whether a Data is offered to a shard other than the one selected by its name
+  bool isSecondary = false;
+  FaceId faceId = face::INVALID_FACEID;
+  EndpointId endpointId = 0;
+  shared_ptr<const Interest> interest;
+  shared_ptr<const Data> data;
+  shared_ptr<const lp::Nack> nack;
+};
+
+/** \brief single-producer single-consumer queue of packets between two threads
+ *
+ *  The consumer is woken up by posting the drain function to its io_service when a packet is
+ *  pushed and no drain is pending, so that a burst of packets costs a single post.
+ */
+class ForwarderShards::PacketQueue : noncopyable
+{
+public:
+  explicit
+  PacketQueue(size_t capacity)
+    : m_queue(capacity)
+  {
+  }
+
+  void
+  setConsumer(boost::asio::io_service& io, std::function<void()> drain)
+  {
+    m_io = &io;
+    m_drain = std::move(drain);
+  }
+
+  /** \return false if the queue is full
+   */
+  bool
+  push(const QueuedPacket& packet)
+  {
+    if (!m_queue.push(packet)) {
+      return false;
+    }
+    if (!m_isScheduled.exchange(true)) {
+      m_io->post(m_drain);
+    }
+    return true;
+  }
+
+  template<typename F>
+  void
+  drain(const F& consume)
+  {
+    // clear the flag before popping, so that a packet pushed meanwhile triggers another drain
+    m_isScheduled = false;
+
+    size_t nPackets = 0;
+    while (nPackets < DRAIN_BATCH && m_queue.consume_one(consume)) {
+      ++nPackets;
+    }
+
+    if (nPackets == DRAIN_BATCH && !m_isScheduled.exchange(true)) {
+      m_io->post(m_drain);
+    }
+  }
+
+private:
+  boost::lockfree::spsc_queue<QueuedPacket> m_queue;
+  std::atomic<bool> m_isScheduled{false};
+  boost::asio::io_service* m_io = nullptr;
+  std::function<void()> m_drain;
+};
+
+/** \brief properties of a face on the main thread, copied into its proxies
+ */
+struct ForwarderShards::FaceProperties
+{
+  FaceUri localUri;
+  FaceUri remoteUri;
+  ndn::nfd::FaceScope scope;
+  ndn::nfd::FacePersistency persistency;
+  ndn::nfd::LinkType linkType;
+  face::FaceState state;
+};
+
+/** \brief LinkService of a proxy face
+ *
+ *  Packets received on the face on the main thread are delivered through it to the Forwarder
+ *  of the shard, and packets sent by the shard are queued for the main thread.
+ */
+class ForwarderShards::ProxyLinkService final : public face::LinkService
+{
+public:
+  ProxyLinkService(PacketQueue& egress, uint64_t& nDrops)
+    : m_egress(egress)
+    , m_nDrops(nDrops)
+  {
+  }
+
+  void
+  deliverInterest(const Interest& interest, const EndpointId& endpointId)
+  {
+    this->receiveInterest(interest, endpointId);
+  }
+
+  void
+  deliverData(const Data& data, const EndpointId& endpointId)
+  {
+    this->receiveData(data, endpointId);
+  }
+
+  void
+  deliverNack(const lp::Nack& nack, const EndpointId& endpointId)
+  {
+    this->receiveNack(nack, endpointId);
+  }
+
+  void
+  deliverDroppedInterest(const Interest& interest)
+  {
+    this->notifyDroppedInterest(interest);
+  }
+
+private:
+  void
+  doSendInterest(const Interest& interest) final
+  {
+    QueuedPacket packet;
+    packet.type = QueuedPacket::Type::INTEREST;
+    // a copy, so that the shard can keep modifying the tags of its own Interest
+    packet.interest = make_shared<Interest>(interest);
+    this->enqueue(packet);
+  }
+
+  void
+  doSendData(const Data& data) final
+  {
+    QueuedPacket packet;
+    packet.type = QueuedPacket::Type::DATA;
+    packet.data = make_shared<Data>(data);
+    this->enqueue(packet);
+  }
+
+  void
+  doSendNack(const lp::Nack& nack) final
+  {
+    QueuedPacket packet;
+    packet.type = QueuedPacket::Type::NACK;
+    packet.nack = make_shared<lp::Nack>(nack);
+    this->enqueue(packet);
+  }
+
+  void
+  doReceivePacket(const Block&, const EndpointId&) final
+  {
+    // ProxyTransport never receives anything
+  }
+
+  void
+  enqueue(QueuedPacket& packet)
+  {
+    packet.faceId = this->getFace()->getId();
+    if (!m_egress.push(packet)) {
+      ++m_nDrops;
+    }
+  }
+
+private:
+  PacketQueue& m_egress;
+  uint64_t& m_nDrops;
+};
+
+/** \brief Transport of a proxy face, which mirrors the properties of the face on the main thread
+ */
+class ForwarderShards::ProxyTransport final : public face::Transport
+{
+public:
+  explicit
+  ProxyTransport(const FaceProperties& properties)
+  {
+    this->setLocalUri(properties.localUri);
+    this->setRemoteUri(properties.remoteUri);
+    this->setScope(properties.scope);
+    this->setPersistency(properties.persistency);
+    this->setLinkType(properties.linkType);
+    this->setMtu(face::MTU_UNLIMITED);
+    this->mirrorState(properties.state);
+  }
+
+  /** \brief follow the face on the main thread going up or down
+   *
+   *  Closing is mirrored by closing the proxy face when the face is removed from the FaceTable.
+   */
+  void
+  mirrorState(face::FaceState state)
+  {
+    auto current = this->getState();
+    if (state != current &&
+        (state == face::FaceState::UP || state == face::FaceState::DOWN) &&
+        (current == face::FaceState::UP || current == face::FaceState::DOWN)) {
+      this->setState(state);
+    }
+  }
+
+protected:
+  void
+  doClose() final
+  {
+    this->setState(face::TransportState::CLOSED);
+  }
+
+private:
+  void
+  doSend(const Block&) final
+  {
+  }
+};
+
+/** \brief a forwarding thread
+ *
+ *  The FaceTable and the Forwarder of the shard are created, used, and destroyed on its thread.
+ */
+class ForwarderShards::Shard : noncopyable
+{
+public:
+  Shard(size_t queueCapacity, const ConfigureShard& configure, boost::asio::io_service& mainIo)
+    : ingress(queueCapacity)
+    , egress(queueCapacity)
+  {
+    std::promise<void> ready;
+    auto isReady = ready.get_future();
+    m_thread = std::thread([this, &ready, &configure, &mainIo] { this->run(ready, configure, mainIo); });
+    try {
+      isReady.get();
+    }
+    catch (...) {
+      m_thread.join();
+      throw;
+    }
+  }
+
+  ~Shard()
+  {
+    io.stop();
+    m_thread.join();
+  }
+
+  void
+  addProxy(FaceId faceId, const FaceProperties& properties)
+  {
+    auto face = make_shared<Face>(make_unique<ProxyLinkService>(egress, nEgressDrops),
+                                  make_unique<ProxyTransport>(properties));
+    faceTable->addWithId(std::move(face), faceId);
+  }
+
+  void
+  setProxyState(FaceId faceId, face::FaceState state)
+  {
+    Face* face = faceTable->get(faceId);
+    if (face != nullptr) {
+      static_cast<ProxyTransport*>(face->getTransport())->mirrorState(state);
+    }
+  }
+
+  void
+  closeProxy(FaceId faceId)
+  {
+    Face* face = faceTable->get(faceId);
+    if (face != nullptr) {
+      face->close();
+    }
+  }
+
+  void
+  updateFib(const Name& prefix, const std::vector<std::pair<FaceId, uint64_t>>& nexthops)
+  {
+    Fib& fib = forwarder->getFib();
+    if (nexthops.empty()) {
+      fib.erase(prefix);
+      return;
+    }
+
+    fib::Entry* entry = fib.insert(prefix).first;
+    for (const auto& nexthop : nexthops) {
+      Face* face = faceTable->get(nexthop.first);
+      if (face != nullptr) {
+        fib.addOrUpdateNextHop(*entry, *face, nexthop.second);
+      }
+    }
+
+    std::vector<const Face*> staleFaces;
+    for (const auto& nexthop : entry->getNextHops()) {
+      FaceId faceId = nexthop.getFace().getId();
+      if (std::none_of(nexthops.begin(), nexthops.end(),
+                       [faceId] (const auto& nh) { return nh.first == faceId; })) {
+        staleFaces.push_back(&nexthop.getFace());
+      }
+    }
+    for (const Face* face : staleFaces) {
+      if (fib.removeNextHop(*entry, *face) == Fib::RemoveNextHopResult::FIB_ENTRY_REMOVED) {
+        return;
+      }
+    }
+
+    if (!entry->hasNextHops()) {
+      // none of the nexthops has a proxy face yet
+      fib.erase(*entry);
+    }
+  }
+
+  void
+  updateStrategyChoice(const Name& prefix, const optional<Name>& strategyName)
+  {
+    StrategyChoice& sc = forwarder->getStrategyChoice();
+    if (!strategyName) {
+      sc.erase(prefix);
+      return;
+    }
+
+    auto res = sc.insert(prefix, *strategyName);
+    if (!res) {
+      NFD_LOG_WARN("cannot set strategy " << *strategyName << " for " << prefix << ": " << res);
+    }
+  }
+
+  void
+  deliver(const QueuedPacket& packet)
+  {
+    Face* face = faceTable->get(packet.faceId);
+    if (face == nullptr) {
+      // the face has been closed in the meantime
+      return;
+    }
+    auto linkService = static_cast<ProxyLinkService*>(face->getLinkService());
+
+    switch (packet.type) {
+      case QueuedPacket::Type::INTEREST:
+        linkService->deliverInterest(*packet.interest, packet.endpointId);
+        break;
+      case QueuedPacket::Type::DATA:
+        if (packet.isSecondary && forwarder->getPit().findAllDataMatches(*packet.data).empty()) {
+          // only the shard selected by the name of the Data may treat it as unsolicited
+          break;
+        }
+        linkService->deliverData(*packet.data, packet.endpointId);
+        break;
+      case QueuedPacket::Type::NACK:
+        linkService->deliverNack(*packet.nack, packet.endpointId);
+        break;
+      case QueuedPacket::Type::DROPPED_INTEREST:
+        linkService->deliverDroppedInterest(*packet.interest);
+        break;
+    }
+  }
+
+  Status
+  collectStatus() const
+  {
+    Status status;
+    status.nNameTreeEntries = forwarder->getNameTree().size();
+    status.nPitEntries = forwarder->getPit().size();
+    status.nMeasurementsEntries = forwarder->getMeasurements().size();
+    status.nCsEntries = forwarder->getCs().size();
+
+    const ForwarderCounters& counters = forwarder->getCounters();
+    status.nInInterests = counters.nInInterests;
+    status.nOutInterests = counters.nOutInterests;
+    status.nInData = counters.nInData;
+    status.nOutData = counters.nOutData;
+    status.nInNacks = counters.nInNacks;
+    status.nOutNacks = counters.nOutNacks;
+    status.nSatisfiedInterests = counters.nSatisfiedInterests;
+    status.nUnsatisfiedInterests = counters.nUnsatisfiedInterests;
+    status.nCsHits = counters.nCsHits;
+    status.nCsMisses = counters.nCsMisses;
+    status.nQueueDrops = nEgressDrops;
+    const auto& pauses = forwarder->getNameTree().getResizePauses().getBins();
+    status.nameTreeResizePauses.assign(pauses.begin(), pauses.end());
+    return status;
+  }
+
+private:
+  void
+  run(std::promise<void>& ready, const ConfigureShard& configure, boost::asio::io_service& mainIo)
+  {
+    setGlobalIoService(io);
+    try {
+      faceTable = make_unique<FaceTable>();
+      forwarder = make_unique<Forwarder>(*faceTable);
+      if (configure) {
+        configure(*forwarder);
+      }
+      ingress.setConsumer(io, [this] {
+        ingress.drain([this] (const QueuedPacket& packet) { this->deliver(packet); });
+      });
+    }
+    catch (...) {
+      forwarder.reset();
+      faceTable.reset();
+      ready.set_exception(std::current_exception());
+      return;
+    }
+    // the constructor returns, and `ready` goes out of scope
+    ready.set_value();
+
+    try {
+      boost::asio::io_service::work work(io);
+      io.run();
+    }
+    catch (const std::exception& e) {
+      NFD_LOG_FATAL(boost::diagnostic_information(e));
+      mainIo.stop();
+    }
+
+    forwarder.reset();
+    faceTable.reset();
+  }
+
+public:
+  /// outlives the thread, so that ~Shard and late posts never reach a destroyed io_service
+  boost::asio::io_service io;
+  unique_ptr<FaceTable> faceTable;
+  unique_ptr<Forwarder> forwarder;
+  /// packets received on the main thread, to be processed by this shard
+  PacketQueue ingress;
+  /// packets sent by this shard, to be transmitted by the main thread
+  PacketQueue egress;
+  uint64_t nEgressDrops = 0;
+
+private:
+  std::thread m_thread;
+};
+
+ForwarderShards::ForwarderShards(Forwarder& forwarder, FaceTable& faceTable,
+                                 const Options& options, ConfigureShard configure)
+  : m_forwarder(forwarder)
+  , m_faceTable(faceTable)
+  , m_options(options)
+  , m_configure(std::move(configure))
+  , m_mainIo(getGlobalIoService())
+{
+  BOOST_ASSERT(m_options.nShards > 0);
+
+  weak_ptr<int> alive = m_alive;
+  for (size_t i = 0; i < m_options.nShards; ++i) {
+    auto shard = make_unique<Shard>(m_options.queueCapacity, m_configure, m_mainIo);
+    shard->egress.setConsumer(m_mainIo, [this, alive, s = shard.get()] {
+      if (alive.expired()) {
+        return;
+      }
+      s->egress.drain([this] (const QueuedPacket& packet) {
+        Face* face = m_faceTable.get(packet.faceId);
+        if (face == nullptr) {
+          return;
+        }
+        switch (packet.type) {
+          case QueuedPacket::Type::INTEREST:
+            face->sendInterest(*packet.interest);
+            break;
+          case QueuedPacket::Type::DATA:
+            face->sendData(*packet.data);
+            break;
+          case QueuedPacket::Type::NACK:
+            face->sendNack(*packet.nack);
+            break;
+          case QueuedPacket::Type::DROPPED_INTEREST:
+            BOOST_ASSERT(false);
+            break;
+        }
+      });
+    });
+    m_shards.push_back(std::move(shard));
+  }
+  m_shardStatus.resize(m_shards.size());
+
+  m_afterAddFace = m_faceTable.afterAdd.connect([this] (const Face& face) { this->addFace(face); });
+  m_beforeRemoveFace = m_faceTable.beforeRemove.connect([this] (const Face& face) { this->removeFace(face); });
+  for (const Face& face : m_faceTable) {
+    this->addFace(face);
+  }
+
+  Fib& fib = m_forwarder.getFib();
+  m_afterFibChange = fib.afterEntryChange.connect([this] (const Name& prefix) {
+    this->replicateFib(prefix);
+  });
+  for (const fib::Entry& entry : fib) {
+    this->replicateFib(entry.getPrefix());
+  }
+
+  StrategyChoice& sc = m_forwarder.getStrategyChoice();
+  m_afterStrategyChoiceChange = sc.afterChange.connect([this] (const Name& prefix) {
+    this->replicateStrategyChoice(prefix);
+  });
+  for (const strategy_choice::Entry& entry : sc) {
+    this->replicateStrategyChoice(entry.getPrefix());
+  }
+
+  m_statusEvent = getScheduler().schedule(STATUS_INTERVAL, [this] { this->refreshStatus(); });
+
+  NFD_LOG_INFO("Started " << m_shards.size() << " forwarding threads, dispatch_prefix_length="
+               << m_options.dispatchPrefixLength);
+}
+
+ForwarderShards::~ForwarderShards()
+{
+  // stop the threads before destroying anything they may refer to
+  m_shards.clear();
+}
+
+ForwarderShards::Options
+ForwarderShards::parseConfig(const ConfigSection& section, const ConfigSection& tablesSection)
+{
+  Options options;
+  for (const auto& pair : section) {
+    const std::string& key = pair.first;
+    if (key == "threads") {
+      options.nShards = ConfigFile::parseNumber<size_t>(pair, "forwarder");
+    }
+    else if (key == "dispatch_prefix_length") {
+      options.dispatchPrefixLength = ConfigFile::parseNumber<size_t>(pair, "forwarder");
+      ConfigFile::checkRange(options.dispatchPrefixLength, size_t(1),
+                             std::numeric_limits<size_t>::max(), key, "forwarder");
+    }
+  }
+
+  if (options.nShards > 0) {
+    checkStrategyChoices(tablesSection);
+  }
+  return options;
+}
+
+void
+ForwarderShards::checkStrategyChoices(const ConfigSection& tablesSection)
+{
+  auto choices = tablesSection.get_child_optional("strategy_choice");
+  if (!choices) {
+    return;
+  }
+
+  for (const auto& prefixAndStrategy : *choices) {
+    // malformed names are reported by TablesConfigSection
+    Name strategy;
+    try {
+      strategy = Name(prefixAndStrategy.second.get_value<std::string>());
+    }
+    catch (const Name::Error&) {
+      continue;
+    }
+
+    if (!canRunStrategy(strategy)) {
+      NDN_THROW(ConfigFile::Error("Strategy '" + strategy.toUri() + "' for prefix '" +
+                                  prefixAndStrategy.first + "' cannot be used with forwarder.threads > 0"));
+    }
+  }
+}
+
+bool
+ForwarderShards::canRunStrategy(const Name& strategyName)
+{
+  static const Name kitePrefix = KiteStrategy::getStrategyName().getPrefix(-1);
+  return !kitePrefix.isPrefixOf(strategyName);
+}
+
+size_t
+ForwarderShards::getShardIndex(const Name& name) const
+{
+  // an Interest carrying the implicit digest goes to the same shard as its Data
+  size_t nComps = name.size();
+  if (nComps > 0 && name[-1].isImplicitSha256Digest()) {
+    --nComps;
+  }
+  return name_tree::computeHash(name, std::min(nComps, m_options.dispatchPrefixLength)) % m_shards.size();
+}
+
+void
+ForwarderShards::reconfigure()
+{
+  if (m_configure) {
+    this->forEachShard(m_configure);
+  }
+}
+
+void
+ForwarderShards::forEachShard(std::function<void(Forwarder&)> f, std::function<void()> done)
+{
+  weak_ptr<int> alive = m_alive;
+  auto nPending = make_shared<size_t>(m_shards.size());
+  auto& mainIo = m_mainIo;
+  for (const auto& shard : m_shards) {
+    shard->io.post([=, s = shard.get(), &mainIo] {
+      f(*s->forwarder);
+      if (done) {
+        mainIo.post([=] {
+          if (!alive.expired() && --*nPending == 0) {
+            done();
+          }
+        });
+      }
+    });
+  }
+}
+
+void
+ForwarderShards::runOnShard(size_t index, std::function<void(Forwarder&)> f, std::function<void()> done)
+{
+  weak_ptr<int> alive = m_alive;
+  auto& mainIo = m_mainIo;
+  m_shards.at(index)->io.post([=, s = m_shards[index].get(), &mainIo] {
+    f(*s->forwarder);
+    if (done) {
+      mainIo.post([=] {
+        if (!alive.expired()) {
+          done();
+        }
+      });
+    }
+  });
+}
+
+void
+ForwarderShards::refreshStatus(std::function<void()> done)
+{
+  m_statusEvent = getScheduler().schedule(STATUS_INTERVAL, [this] { this->refreshStatus(); });
+
+  weak_ptr<int> alive = m_alive;
+  auto nPending = make_shared<size_t>(m_shards.size());
+  auto& mainIo = m_mainIo;
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    m_shards[i]->io.post([=, s = m_shards[i].get(), &mainIo] {
+      Status status = s->collectStatus();
+      mainIo.post([=] {
+        if (alive.expired()) {
+          return;
+        }
+        m_shardStatus[i] = status;
+        if (--*nPending > 0) {
+          return;
+        }
+
+        Status total;
+        for (const Status& st : m_shardStatus) {
+          total.nNameTreeEntries += st.nNameTreeEntries;
+          total.nPitEntries += st.nPitEntries;
+          total.nMeasurementsEntries += st.nMeasurementsEntries;
+          total.nCsEntries += st.nCsEntries;
+          total.nInInterests += st.nInInterests;
+          total.nOutInterests += st.nOutInterests;
+          total.nInData += st.nInData;
+          total.nOutData += st.nOutData;
+          total.nInNacks += st.nInNacks;
+          total.nOutNacks += st.nOutNacks;
+          total.nSatisfiedInterests += st.nSatisfiedInterests;
+          total.nUnsatisfiedInterests += st.nUnsatisfiedInterests;
+          total.nCsHits += st.nCsHits;
+          total.nCsMisses += st.nCsMisses;
+          total.nQueueDrops += st.nQueueDrops;
+          total.nameTreeResizePauses.resize(st.nameTreeResizePauses.size());
+          std::transform(st.nameTreeResizePauses.begin(), st.nameTreeResizePauses.end(),
+                         total.nameTreeResizePauses.begin(), total.nameTreeResizePauses.begin(),
+                         std::plus<uint64_t>());
+        }
+        total.nQueueDrops += m_nIngressDrops;
+        m_status = total;
+
+        if (done) {
+          done();
+        }
+      });
+    });
+  }
+}
+
+void
+ForwarderShards::addFace(const Face& face)
+{
+  FaceId faceId = face.getId();
+  FaceProperties properties{face.getLocalUri(), face.getRemoteUri(), face.getScope(),
+                            face.getPersistency(), face.getLinkType(), face.getState()};
+  for (const auto& shard : m_shards) {
+    shard->io.post([s = shard.get(), faceId, properties] { s->addProxy(faceId, properties); });
+  }
+
+  auto& connections = m_faceConnections[faceId];
+  connections.emplace_back(face.afterReceiveInterest.connect(
+    [this, faceId] (const Interest& interest, const EndpointId& endpointId) {
+      this->dispatchInterest(faceId, endpointId, interest);
+    }));
+  connections.emplace_back(face.afterReceiveData.connect(
+    [this, faceId] (const Data& data, const EndpointId& endpointId) {
+      this->dispatchData(faceId, endpointId, data);
+    }));
+  connections.emplace_back(face.afterReceiveNack.connect(
+    [this, faceId] (const lp::Nack& nack, const EndpointId& endpointId) {
+      QueuedPacket packet;
+      packet.type = QueuedPacket::Type::NACK;
+      packet.faceId = faceId;
+      packet.endpointId = endpointId;
+      packet.nack = make_shared<lp::Nack>(nack);
+      this->enqueue(this->getShardIndex(nack.getInterest().getName()), packet);
+    }));
+  connections.emplace_back(face.onDroppedInterest.connect(
+    [this, faceId] (const Interest& interest) {
+      QueuedPacket packet;
+      packet.type = QueuedPacket::Type::DROPPED_INTEREST;
+      packet.faceId = faceId;
+      packet.interest = interest.shared_from_this();
+      this->enqueue(this->getShardIndex(interest.getName()), packet);
+    }));
+  m_faceStateConnections[faceId] = face.afterStateChange.connect(
+    [this, faceId] (face::FaceState, face::FaceState newState) {
+      for (const auto& shard : m_shards) {
+        shard->io.post([s = shard.get(), faceId, newState] { s->setProxyState(faceId, newState); });
+      }
+    });
+}
+
+void
+ForwarderShards::removeFace(const Face& face)
+{
+  FaceId faceId = face.getId();
+  m_faceConnections.erase(faceId);
+  // the face is removed from within its afterStateChange signal, where the handler cannot be
+  // disconnected; a closed face does not change state again
+  auto it = m_faceStateConnections.find(faceId);
+  if (it != m_faceStateConnections.end()) {
+    it->second.release();
+    m_faceStateConnections.erase(it);
+  }
+
+  // the FIB replicated to the shards lives in a Forwarder that does not see this FaceTable
+  cleanupOnFaceRemoval(m_forwarder.getNameTree(), m_forwarder.getFib(), m_forwarder.getPit(), face);
+
+  for (const auto& shard : m_shards) {
+    shard->io.post([s = shard.get(), faceId] { s->closeProxy(faceId); });
+  }
+}
+
+void
+ForwarderShards::dispatchInterest(FaceId faceId, const EndpointId& endpointId, const Interest& interest)
+{
+  const Name& name = interest.getName();
+  if (interest.getCanBePrefix() && name.size() < m_options.dispatchPrefixLength) {
+    // Data satisfying this Interest may have a longer dispatch prefix, see dispatchData
+    auto deadline = time::steady_clock::now() + interest.getInterestLifetime();
+    if (!m_shortNameDeadline || *m_shortNameDeadline < deadline) {
+      m_shortNameDeadline = deadline;
+    }
+  }
+
+  QueuedPacket packet;
+  packet.type = QueuedPacket::Type::INTEREST;
+  packet.faceId = faceId;
+  packet.endpointId = endpointId;
+  packet.interest = interest.shared_from_this();
+  this->enqueue(this->getShardIndex(name), packet);
+}
+
+void
+ForwarderShards::dispatchData(FaceId faceId, const EndpointId& endpointId, const Data& data)
+{
+  const Name& name = data.getName();
+  size_t primary = this->getShardIndex(name);
+
+  QueuedPacket packet;
+  packet.type = QueuedPacket::Type::DATA;
+  packet.faceId = faceId;
+  packet.endpointId = endpointId;
+
+  if (m_shortNameDeadline && time::steady_clock::now() >= *m_shortNameDeadline) {
+    m_shortNameDeadline = nullopt;
+  }
+  if (m_shortNameDeadline) {
+    // offer a copy to every shard that may hold an Interest named by a shorter prefix;
+    // the copies are made before the original is handed over to another thread
+    size_t prefixLen = std::min(name.size(), m_options.dispatchPrefixLength);
+    name_tree::HashSequence hashes = name_tree::computeHashes(name, prefixLen);
+    std::vector<bool> isOffered(m_shards.size());
+    isOffered[primary] = true;
+
+    QueuedPacket secondary = packet;
+    secondary.isSecondary = true;
+    for (size_t i = 0; i < prefixLen; ++i) {
+      size_t index = hashes[i] % m_shards.size();
+      if (!isOffered[index]) {
+        isOffered[index] = true;
+        secondary.data = make_shared<Data>(data);
+        this->enqueue(index, secondary);
+      }
+    }
+  }
+
+  packet.data = data.shared_from_this();
+  this->enqueue(primary, packet);
+}
+
+void
+ForwarderShards::replicateFib(const Name& prefix)
+{
+  std::vector<std::pair<FaceId, uint64_t>> nexthops;
+  const fib::Entry* entry = m_forwarder.getFib().findExactMatch(prefix);
+  if (entry != nullptr) {
+    for (const auto& nexthop : entry->getNextHops()) {
+      nexthops.emplace_back(nexthop.getFace().getId(), nexthop.getCost());
+    }
+  }
+
+  for (const auto& shard : m_shards) {
+    shard->io.post([s = shard.get(), prefix, nexthops] { s->updateFib(prefix, nexthops); });
+  }
+}
+
+void
+ForwarderShards::replicateStrategyChoice(const Name& prefix)
+{
+  optional<Name> strategyName;
+  auto res = m_forwarder.getStrategyChoice().get(prefix);
+  if (res.first) {
+    strategyName = res.second;
+  }
+
+  for (const auto& shard : m_shards) {
+    shard->io.post([s = shard.get(), prefix, strategyName] { s->updateStrategyChoice(prefix, strategyName); });
+  }
+}
+
+void
+ForwarderShards::enqueue(size_t shardIndex, const QueuedPacket& packet)
+{
+  if (!m_shards[shardIndex]->ingress.push(packet)) {
+    ++m_nIngressDrops;
+    NFD_LOG_DEBUG("queue to shard " << shardIndex << " is full, dropping packet");
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FORWARDER_SHARDS_HPP
+#define NFD_DAEMON_FW_FORWARDER_SHARDS_HPP
+
+#include "common/config-file.hpp"
+#include "face/face.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace nfd {
+
+class FaceTable;
+class Forwarder;
+
+namespace fw {
+
+/** \brief Runs the forwarding pipelines on several threads.
+ *
+ *  Each shard is a thread with its own io_service and its own Forwarder, that is, its own
+ *  NameTree, FIB, PIT, CS, Measurements and StrategyChoice. A packet received on a face is
+ *  handed to the shard selected by the hash of the first \c dispatchPrefixLength components
+ *  of its name, so that an Interest, the PIT entry it creates, and the Data that satisfies it
+ *  meet in the same shard. Data may also be offered to other shards while Interests with
+ *  fewer components than \c dispatchPrefixLength are pending, because such Interests are
+ *  dispatched by a shorter prefix than their Data.
+ *
+ *  Faces stay on the thread that owns the FaceTable, normally the main thread. Every shard
+ *  sees them through proxy faces with the same FaceIds. Packets cross threads through
+ *  single-producer single-consumer lock-free queues; the consuming thread is woken up by one
+ *  io_service post per batch of packets rather than per packet.
+ *
+ *  The Forwarder passed to the constructor does not forward packets. It keeps the tables
+ *  that management and the RIB update, and every change to its FIB and StrategyChoice is
+ *  replicated to all shards. The rest of the configuration is applied to each shard by the
+ *  ConfigureShard callback.
+ */
+class ForwarderShards : noncopyable
+{
+public:
+  struct Options
+  {
+    Options() noexcept
+    {
+    }
+
+    /// number of forwarding threads, zero to forward on the main thread
+    size_t nShards = 0;
+    /// number of name components hashed to select a shard
+    size_t dispatchPrefixLength = 2;
+    /// capacity of each queue between the main thread and a shard, in packets
+    size_t queueCapacity = 4096;
+  };
+
+  /** \brief forwarder status summed over all shards
+   */
+  struct Status
+  {
+    uint64_t nNameTreeEntries = 0;
+    uint64_t nPitEntries = 0;
+    uint64_t nMeasurementsEntries = 0;
+    uint64_t nCsEntries = 0;
+    uint64_t nInInterests = 0;
+    uint64_t nOutInterests = 0;
+    uint64_t nInData = 0;
+    uint64_t nOutData = 0;
+    uint64_t nInNacks = 0;
+    uint64_t nOutNacks = 0;
+    uint64_t nSatisfiedInterests = 0;
+    uint64_t nUnsatisfiedInterests = 0;
+    uint64_t nCsHits = 0;
+    uint64_t nCsMisses = 0;
+    /// packets dropped because a queue between threads was full
+    uint64_t nQueueDrops = 0;
+    /// NameTree resize pauses per duration bin, \sa name_tree::PauseHistogram
+    std::vector<uint64_t> nameTreeResizePauses;
+  };
+
+  /** \brief applies the configuration of the forwarder and tables to the Forwarder of a shard
+   *
+   *  It is invoked on the shard thread.
+   */
+  using ConfigureShard = std::function<void(Forwarder&)>;
+
+  /** \brief start the shards
+   *  \param forwarder holds the tables updated by management, and must not be attached to \p faceTable
+   *  \param faceTable faces whose packets are dispatched to the shards
+   *  \pre options.nShards > 0
+   */
+  ForwarderShards(Forwarder& forwarder, FaceTable& faceTable, const Options& options,
+                  ConfigureShard configure = nullptr);
+
+  ~ForwarderShards();
+
+  /** \brief parse the options of the forwarder section of the configuration file
+   *  \param tablesSection the tables section, whose strategy choices are checked with
+   *                       checkStrategyChoices() if forwarding threads are enabled
+   *  \throw ConfigFile::Error an option is invalid, or a chosen strategy cannot run on
+   *                           forwarding threads
+   *  \note Options unrelated to forwarding threads are left to Forwarder.
+   */
+  static Options
+  parseConfig(const ConfigSection& section, const ConfigSection& tablesSection = ConfigSection());
+
+  /** \brief check that every strategy in the strategy_choice subsection of \p tablesSection
+   *         can run on forwarding threads
+   *  \throw ConfigFile::Error
+   */
+  static void
+  checkStrategyChoices(const ConfigSection& tablesSection);
+
+  /** \return whether \p strategyName can run on forwarding threads
+   *
+   *  KITE strategies cannot: the KITE Requests of a producer and the Interests towards it are
+   *  dispatched by different name prefixes, so their per-producer state would be split across
+   *  shards.
+   */
+  static bool
+  canRunStrategy(const Name& strategyName);
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  size_t
+  size() const
+  {
+    return m_shards.size();
+  }
+
+  /** \return index of the shard that handles Interests and Nacks named \p name
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+  /** \brief apply the configuration to every shard again, after the configuration file is reloaded
+   */
+  void
+  reconfigure();
+
+  /** \brief run \p f with the Forwarder of every shard, on the shard threads
+   *  \param done invoked on the calling thread after \p f has returned on all shards
+   */
+  void
+  forEachShard(std::function<void(Forwarder&)> f, std::function<void()> done = nullptr);
+
+  /** \brief run \p f with the Forwarder of shard \p index, on its thread
+   *  \param done invoked on the calling thread after \p f has returned
+   */
+  void
+  runOnShard(size_t index, std::function<void(Forwarder&)> f, std::function<void()> done = nullptr);
+
+  /** \return status of the shards, refreshed every STATUS_INTERVAL
+   */
+  const Status&
+  getStatus() const
+  {
+    return m_status;
+  }
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief collect the status of every shard
+   *  \param done invoked after getStatus() has been updated
+   */
+  void
+  refreshStatus(std::function<void()> done = nullptr);
+
+public:
+  static constexpr time::milliseconds STATUS_INTERVAL = 1_s;
+
+private:
+  class Shard;
+  class PacketQueue;
+  class ProxyLinkService;
+  class ProxyTransport;
+  struct QueuedPacket;
+  struct FaceProperties;
+
+  void
+  addFace(const Face& face);
+
+  void
+  removeFace(const Face& face);
+
+  void
+  dispatchInterest(FaceId faceId, const EndpointId& endpointId, const Interest& interest);
+
+  void
+  dispatchData(FaceId faceId, const EndpointId& endpointId, const Data& data);
+
+  void
+  replicateFib(const Name& prefix);
+
+  void
+  replicateStrategyChoice(const Name& prefix);
+
+  void
+  enqueue(size_t shardIndex, const QueuedPacket& packet);
+
+private:
+  Forwarder& m_forwarder;
+  FaceTable& m_faceTable;
+  const Options m_options;
+  ConfigureShard m_configure;
+  boost::asio::io_service& m_mainIo;
+  shared_ptr<int> m_alive = make_shared<int>();
+  std::vector<unique_ptr<Shard>> m_shards;
+
+  /// until when Interests named shorter than the dispatch prefix may be pending
+  optional<time::steady_clock::TimePoint> m_shortNameDeadline;
+
+  std::map<FaceId, std::vector<signal::ScopedConnection>> m_faceConnections;
+  std::map<FaceId, signal::ScopedConnection> m_faceStateConnections;
+  signal::ScopedConnection m_afterAddFace;
+  signal::ScopedConnection m_beforeRemoveFace;
+  signal::ScopedConnection m_afterFibChange;
+  signal::ScopedConnection m_afterStrategyChoiceChange;
+
+  /// packets dropped because the queue to a shard was full
+  uint64_t m_nIngressDrops = 0;
+  std::vector<Status> m_shardStatus;
+  Status m_status;
+  scheduler::ScopedEventId m_statusEvent;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_FORWARDER_SHARDS_HPP
@@ -60,16 +60,32 @@ Forwarder::Forwarder(FaceTable& faceTable)
   m_faceTable.afterAdd.connect([this] (const Face& face) {
     face.afterReceiveInterest.connect(
       [this, &face] (const Interest& interest, const EndpointId& endpointId) {
-        this->onIncomingInterest(interest, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        FaceEndpoint ingress(const_cast<Face&>(face), endpointId);
+        if (face.isReceivingBurst()) {
+          this->enqueueBurstPacket({ingress, interest.shared_from_this(), nullptr, nullptr});
+          return;
+        }
+        this->onIncomingInterest(interest, ingress);
       });
     face.afterReceiveData.connect(
       [this, &face] (const Data& data, const EndpointId& endpointId) {
-        this->onIncomingData(data, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        FaceEndpoint ingress(const_cast<Face&>(face), endpointId);
+        if (face.isReceivingBurst()) {
+          this->enqueueBurstPacket({ingress, nullptr, data.shared_from_this(), nullptr});
+          return;
+        }
+        this->onIncomingData(data, ingress);
       });
     face.afterReceiveNack.connect(
       [this, &face] (const lp::Nack& nack, const EndpointId& endpointId) {
-        this->onIncomingNack(nack, FaceEndpoint(const_cast<Face&>(face), endpointId));
+        FaceEndpoint ingress(const_cast<Face&>(face), endpointId);
+        if (face.isReceivingBurst()) {
+          this->enqueueBurstPacket({ingress, nullptr, nullptr, make_shared<lp::Nack>(nack)});
+          return;
+        }
+        this->onIncomingNack(nack, ingress);
       });
+    face.afterReceiveBurst.connect([this] { this->processBurst(); });
     face.onDroppedInterest.connect(
       [this, &face] (const Interest& interest) {
         this->onDroppedInterest(interest, const_cast<Face&>(face));
@@ -96,6 +112,7 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
   NFD_LOG_DEBUG("onIncomingInterest in=" << ingress << " interest=" << interest.getName());
   interest.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
   ++m_counters.nInInterests;
+  const auto* hashes = std::exchange(m_burstHashes, nullptr);
 
   // drop if HopLimit zero, decrement otherwise (if present)
   if (interest.getHopLimit()) {
@@ -136,7 +153,8 @@ Forwarder::onIncomingInterest(const Interest& interest, const FaceEndpoint& ingr
   }
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry = (hashes == nullptr ? m_pit.insert(interest) :
+                                                         m_pit.insert(interest, *hashes)).first;
 
   // detect duplicate Nonce in PIT entry
   int dnw = fw::findDuplicateNonce(*pitEntry, interest.getNonce(), ingress.face);
@@ -299,6 +317,7 @@ Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
   NFD_LOG_DEBUG("onIncomingData in=" << ingress << " data=" << data.getName());
   data.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
   ++m_counters.nInData;
+  const auto* hashes = std::exchange(m_burstHashes, nullptr);
 
   // /localhost scope control
   bool isViolatingLocalhost = ingress.face.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL &&
@@ -310,7 +329,8 @@ Forwarder::onIncomingData(const Data& data, const FaceEndpoint& ingress)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches = hashes == nullptr ? m_pit.findAllDataMatches(data) :
+                                                       m_pit.findAllDataMatches(data, *hashes);
   if (pitMatches.size() == 0) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(data, ingress);
@@ -437,6 +457,7 @@ Forwarder::onIncomingNack(const lp::Nack& nack, const FaceEndpoint& ingress)
   // receive Nack
   nack.setTag(make_shared<lp::IncomingFaceIdTag>(ingress.face.getId()));
   ++m_counters.nInNacks;
+  const auto* hashes = std::exchange(m_burstHashes, nullptr);
 
   // if multi-access or ad hoc face, drop
   if (ingress.face.getLinkType() != ndn::nfd::LINK_TYPE_POINT_TO_POINT) {
@@ -447,7 +468,8 @@ Forwarder::onIncomingNack(const lp::Nack& nack, const FaceEndpoint& ingress)
   }
 
   // PIT match
-  shared_ptr<pit::Entry> pitEntry = m_pit.find(nack.getInterest());
+  shared_ptr<pit::Entry> pitEntry = hashes == nullptr ? m_pit.find(nack.getInterest()) :
+                                                        m_pit.find(nack.getInterest(), *hashes);
   // if no PIT entry found, drop
   if (pitEntry == nullptr) {
     NFD_LOG_DEBUG("onIncomingNack in=" << ingress << " nack=" << nack.getInterest().getName()
@@ -569,8 +591,11 @@ Forwarder::setExpiryTimer(const shared_ptr<pit::Entry>& pitEntry, time::millisec
   BOOST_ASSERT(pitEntry);
   duration = std::max(duration, 0_ms);
 
-  pitEntry->expiryTimer.cancel();
-  pitEntry->expiryTimer = getScheduler().schedule(duration, [=] { onInterestFinalize(pitEntry); });
+  // capture a raw pointer, so that the callback is stored without allocating memory;
+  // the timer is cancelled when the entry is destructed, so the entry is alive when it fires
+  m_pitExpiry.schedule(pitEntry->expiryTimer, duration, [this, entry = pitEntry.get()] {
+    onInterestFinalize(entry->shared_from_this());
+  });
 }
 
 void
@@ -605,6 +630,73 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, const Face* upstream)
   }
 }
 
+const Name&
+Forwarder::BurstPacket::getName() const
+{
+  if (interest != nullptr) {
+    return interest->getName();
+  }
+  if (data != nullptr) {
+    return data->getName();
+  }
+  return nack->getInterest().getName();
+}
+
+void
+Forwarder::enqueueBurstPacket(BurstPacket&& packet)
+{
+  m_burst.push_back(std::move(packet));
+  if (m_burst.size() >= face::MAX_RECEIVE_BURST) {
+    this->processBurst();
+  }
+}
+
+void
+Forwarder::processBurst()
+{
+  std::vector<BurstPacket> burst;
+  // packets received while the pipelines run are not part of this burst
+  burst.swap(m_burst);
+  if (burst.empty()) {
+    return;
+  }
+
+  // stage 1: compute the name hashes and prefetch the hashtable buckets
+  std::vector<name_tree::HashSequence> hashes;
+  hashes.reserve(burst.size());
+  for (const auto& packet : burst) {
+    const Name& name = packet.getName();
+    hashes.push_back(name_tree::computeHashes(name, std::min(name.size(), m_nameTree.getMaxDepth())));
+    m_nameTree.prefetchBuckets(hashes.back());
+  }
+
+  // stage 2: prefetch the first node in each bucket, now that the buckets are (likely) cached
+  for (const auto& h : hashes) {
+    m_nameTree.prefetchNodes(h);
+  }
+
+  // stage 3: run the incoming pipelines in arrival order, handing each its hashes
+  for (size_t i = 0; i < burst.size(); ++i) {
+    const auto& packet = burst[i];
+    m_burstHashes = &hashes[i];
+    if (packet.interest != nullptr) {
+      this->onIncomingInterest(*packet.interest, packet.ingress);
+    }
+    else if (packet.data != nullptr) {
+      this->onIncomingData(*packet.data, packet.ingress);
+    }
+    else {
+      this->onIncomingNack(*packet.nack, packet.ingress);
+    }
+  }
+
+  // reuse the storage for the next burst
+  burst.clear();
+  if (m_burst.empty()) {
+    m_burst.swap(burst);
+  }
+}
+
 void
 Forwarder::setConfigFile(ConfigFile& configFile)
 {
@@ -623,6 +715,14 @@ Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, cons
     if (key == "default_hop_limit") {
       config.defaultHopLimit = ConfigFile::parseNumber<uint8_t>(pair, CFG_FORWARDER);
     }
+    else if (key == "pit_timer_tick") {
+      auto tick = ConfigFile::parseNumber<uint32_t>(pair, CFG_FORWARDER);
+      ConfigFile::checkRange(tick, 1U, 1000U, key, CFG_FORWARDER);
+      config.pitTimerTick = time::milliseconds(tick);
+    }
+    else if (key == "threads" || key == "dispatch_prefix_length") {
+      // handled by ForwarderShards at startup, cannot be changed by reloading
+    }
     else {
       NDN_THROW(ConfigFile::Error("Unrecognized option " + CFG_FORWARDER + "." + key));
     }
@@ -630,6 +730,7 @@ Forwarder::processConfig(const ConfigSection& configSection, bool isDryRun, cons
 
   if (!isDryRun) {
     m_config = config;
+    m_pitExpiry.setTickDuration(m_config.pitTimerTick);
   }
 }
 
@@ -30,6 +30,7 @@
 #include "forwarder-counters.hpp"
 #include "unsolicited-data-policy.hpp"
 #include "common/config-file.hpp"
+#include "common/timer-wheel.hpp"
 #include "face/face-endpoint.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
@@ -223,6 +224,36 @@ private:
   processConfig(const ConfigSection& configSection, bool isDryRun,
                 const std::string& filename);
 
+  /** \brief a packet received while its face was receiving a burst
+   *
+   *  Exactly one of \c interest, \c data, and \c nack is set.
+   */
+  struct BurstPacket
+  {
+    const Name&
+    getName() const;
+
+    FaceEndpoint ingress;
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+    shared_ptr<const lp::Nack> nack;
+  };
+
+  /** \brief hold a packet until the end of the current burst
+   */
+  void
+  enqueueBurstPacket(BurstPacket&& packet);
+
+  /** \brief run the incoming pipelines on the packets held during a burst
+   *
+   *  The packets are processed in stages: the name hashes of all packets are computed and
+   *  their NameTree buckets prefetched before any pipeline runs, so that the cache misses of
+   *  the table lookups overlap instead of being paid one packet at a time. The PIT lookup of
+   *  each pipeline then reuses those hashes.
+   */
+  void
+  processBurst();
+
 NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * \brief Configuration options from "forwarder" section
@@ -232,9 +263,15 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     /// Initial value of HopLimit that should be added to Interests that don't have one.
     /// A value of zero disables the feature.
     uint8_t defaultHopLimit = 0;
+
+    /// Granularity of the timer wheel that expires PIT entries.
+    time::milliseconds pitTimerTick = time::duration_cast<time::milliseconds>(TimerWheel::DEFAULT_TICK);
   };
   Config m_config;
 
+  /// expires PIT entries
+  TimerWheel m_pitExpiry;
+
 private:
   ForwarderCounters m_counters;
 
@@ -250,6 +287,10 @@ private:
   DeadNonceList      m_deadNonceList;
   NetworkRegionTable m_networkRegionTable;
 
+  std::vector<BurstPacket> m_burst;
+  /// name hashes of the burst packet entering an incoming pipeline, taken by its PIT lookup
+  const name_tree::HashSequence* m_burstHashes = nullptr;
+
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 };
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-handoff.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+NFD_LOG_INIT(KiteHandoff);
+
+HandoffReforwarder::HandoffReforwarder(SendInterest sendInterest)
+  : m_sendInterest(std::move(sendInterest))
+{
+  BOOST_ASSERT(m_sendInterest != nullptr);
+}
+
+HandoffReforwarder::HandoffReforwarder(SendInterest sendInterest, const Options& options)
+  : HandoffReforwarder(std::move(sendInterest))
+{
+  setOptions(options);
+}
+
+void
+HandoffReforwarder::setOptions(const Options& options)
+{
+  if (options.batchSize == 0 || options.rate == 0 || options.burst == 0) {
+    NDN_THROW(std::invalid_argument("Handoff batch size, rate, and burst must be positive"));
+  }
+  m_options = options;
+}
+
+void
+HandoffReforwarder::enqueue(FaceId faceId, const std::vector<shared_ptr<pit::Entry>>& pitEntries)
+{
+  if (pitEntries.empty()) {
+    return;
+  }
+
+  auto ret = m_queues.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(faceId), std::forward_as_tuple());
+  auto& fq = ret.first->second;
+  if (ret.second) {
+    // a face starts with a full bucket
+    fq.tokens = m_options.burst;
+    fq.lastRefill = time::steady_clock::now();
+  }
+
+  for (const auto& pitEntry : pitEntries) {
+    auto queued = fq.queued.emplace(pitEntry.get(), pitEntry);
+    if (!queued.second) {
+      if (queued.first->second.lock() == pitEntry) {
+        ++m_counters.nDeduplicated;
+        continue;
+      }
+      // the queued item belongs to a dead PIT entry that happened to have the same address
+      queued.first->second = pitEntry;
+    }
+    fq.items.push({getExpiry(*pitEntry), pitEntry, pitEntry.get()});
+  }
+
+  NFD_LOG_DEBUG("enqueue face=" << faceId << " n=" << pitEntries.size() << " queued=" << fq.items.size());
+  if (!fq.isDraining && !fq.items.empty()) {
+    fq.isDraining = true;
+    processBatch(faceId);
+  }
+}
+
+void
+HandoffReforwarder::cancel(FaceId faceId)
+{
+  m_queues.erase(faceId);
+}
+
+void
+HandoffReforwarder::cancel(FaceId faceId, const std::vector<shared_ptr<pit::Entry>>& pitEntries)
+{
+  auto it = m_queues.find(faceId);
+  if (it == m_queues.end()) {
+    return;
+  }
+  auto& fq = it->second;
+
+  // the items stay in the heap, and are skipped when their turn comes
+  for (const auto& pitEntry : pitEntries) {
+    auto queued = fq.queued.find(pitEntry.get());
+    if (queued != fq.queued.end() && queued->second.lock() == pitEntry) {
+      fq.queued.erase(queued);
+    }
+  }
+  if (fq.queued.empty()) {
+    m_queues.erase(it);
+  }
+}
+
+size_t
+HandoffReforwarder::getQueueLength(FaceId faceId) const
+{
+  auto it = m_queues.find(faceId);
+  return it == m_queues.end() ? 0 : it->second.queued.size();
+}
+
+void
+HandoffReforwarder::processBatch(FaceId faceId)
+{
+  auto it = m_queues.find(faceId);
+  if (it == m_queues.end()) {
+    return;
+  }
+  auto& fq = it->second;
+
+  auto now = time::steady_clock::now();
+  auto elapsed = time::duration_cast<time::microseconds>(now - fq.lastRefill);
+  fq.tokens = std::min<double>(m_options.burst,
+                               fq.tokens + static_cast<double>(elapsed.count()) * m_options.rate / 1e6);
+  fq.lastRefill = now;
+
+  size_t nSent = 0;
+  while (!fq.items.empty() && nSent < m_options.batchSize && fq.tokens >= 1.0) {
+    Item item = fq.items.top();
+    fq.items.pop();
+
+    auto queued = fq.queued.find(item.key);
+    bool isQueued = queued != fq.queued.end() &&
+                    !queued->second.owner_before(item.pitEntry) &&
+                    !item.pitEntry.owner_before(queued->second);
+    if (isQueued) {
+      fq.queued.erase(queued);
+    }
+    else if (!item.pitEntry.expired()) {
+      // cancelled
+      continue;
+    }
+
+    auto pitEntry = item.pitEntry.lock();
+    if (pitEntry == nullptr || getExpiry(*pitEntry) <= now) {
+      ++m_counters.nExpiredBeforeResend;
+      continue;
+    }
+
+    if (!m_sendInterest(pitEntry, faceId)) {
+      NFD_LOG_DEBUG("face=" << faceId << " is gone, dropping " << fq.items.size() << " queued");
+      m_queues.erase(it);
+      return;
+    }
+    ++m_counters.nReforwarded;
+    fq.tokens -= 1.0;
+    ++nSent;
+  }
+
+  if (fq.items.empty()) {
+    // a face that has been drained keeps no state, so the map only holds faces being drained
+    m_queues.erase(it);
+    return;
+  }
+
+  NFD_LOG_TRACE("face=" << faceId << " sent=" << nSent << " remaining=" << fq.items.size());
+  fq.nextBatch = getScheduler().schedule(m_options.batchInterval, [this, faceId] { processBatch(faceId); });
+}
+
+time::steady_clock::TimePoint
+HandoffReforwarder::getExpiry(const pit::Entry& pitEntry)
+{
+  auto expiry = time::steady_clock::TimePoint::min();
+  for (const auto& inRecord : pitEntry.getInRecords()) {
+    expiry = std::max(expiry, inRecord.getExpiry());
+  }
+  return expiry;
+}
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_KITE_HANDOFF_HPP
+#define NFD_DAEMON_FW_KITE_HANDOFF_HPP
+
+#include "common/counter.hpp"
+#include "face/face-common.hpp"
+#include "table/pit-entry.hpp"
+
+#include <queue>
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+/** \brief Re-forwards pending Interests to the new face of a mobile producer after a handoff
+ *
+ *  Rather than sending every pending Interest in one event-loop turn, Interests are queued
+ *  per face and drained in batches, paced by a token bucket. Within a face queue, Interests
+ *  whose PIT entries expire first are sent first.
+ */
+class HandoffReforwarder : noncopyable
+{
+public:
+  struct Options
+  {
+    /** \brief maximum number of Interests sent to a face in one batch
+     */
+    size_t batchSize = 64;
+
+    /** \brief interval between two batches on the same face
+     */
+    time::milliseconds batchInterval = 5_ms;
+
+    /** \brief token bucket fill rate, in Interests per second
+     */
+    size_t rate = 10000;
+
+    /** \brief token bucket capacity, in Interests
+     */
+    size_t burst = 256;
+  };
+
+  class Counters
+  {
+  public:
+    /** \brief Interests re-forwarded to a new face
+     */
+    PacketCounter nReforwarded;
+
+    /** \brief Interests whose PIT entry was satisfied, rejected, or expired before its turn came
+     */
+    PacketCounter nExpiredBeforeResend;
+
+    /** \brief Interests that were already queued for the same face
+     */
+    PacketCounter nDeduplicated;
+  };
+
+  /** \brief sends the Interest of a PIT entry to a face
+   *  \return false if the face no longer exists, in which case its queue is dropped
+   */
+  using SendInterest = std::function<bool(const shared_ptr<pit::Entry>&, FaceId)>;
+
+  explicit
+  HandoffReforwarder(SendInterest sendInterest);
+
+  HandoffReforwarder(SendInterest sendInterest, const Options& options);
+
+  /** \brief Queue \p pitEntries for re-forwarding to \p faceId
+   *
+   *  The first batch is sent immediately if the face is not already being drained.
+   */
+  void
+  enqueue(FaceId faceId, const std::vector<shared_ptr<pit::Entry>>& pitEntries);
+
+  /** \brief Drop all Interests queued for \p faceId
+   *
+   *  Used when the producer is no longer reachable on the face, or the face is removed.
+   */
+  void
+  cancel(FaceId faceId);
+
+  /** \brief Drop the Interests of \p pitEntries queued for \p faceId
+   */
+  void
+  cancel(FaceId faceId, const std::vector<shared_ptr<pit::Entry>>& pitEntries);
+
+  /** \return number of Interests queued for \p faceId
+   */
+  size_t
+  getQueueLength(FaceId faceId) const;
+
+  /** \return number of faces whose queues are being drained
+   */
+  size_t
+  getNQueues() const
+  {
+    return m_queues.size();
+  }
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \throw std::invalid_argument batch size, rate, or burst is zero
+   */
+  void
+  setOptions(const Options& options);
+
+  const Counters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+private:
+  struct Item
+  {
+    time::steady_clock::TimePoint expiry;
+    weak_ptr<pit::Entry> pitEntry;
+    const pit::Entry* key;
+  };
+
+  struct ItemCompare
+  {
+    bool
+    operator()(const Item& lhs, const Item& rhs) const
+    {
+      // std::priority_queue is a max-heap, the earliest expiry must compare greatest
+      return lhs.expiry > rhs.expiry;
+    }
+  };
+
+  struct FaceQueue
+  {
+    std::priority_queue<Item, std::vector<Item>, ItemCompare> items;
+    std::unordered_map<const pit::Entry*, weak_ptr<pit::Entry>> queued;
+    double tokens = 0.0;
+    time::steady_clock::TimePoint lastRefill;
+    scheduler::ScopedEventId nextBatch;
+    bool isDraining = false;
+  };
+
+  void
+  processBatch(FaceId faceId);
+
+  static time::steady_clock::TimePoint
+  getExpiry(const pit::Entry& pitEntry);
+
+private:
+  SendInterest m_sendInterest;
+  Options m_options;
+  Counters m_counters;
+  std::unordered_map<FaceId, FaceQueue> m_queues;
+};
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_KITE_HANDOFF_HPP
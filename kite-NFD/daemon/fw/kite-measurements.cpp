@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-measurements.hpp"
+#include "common/logger.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+NFD_LOG_INIT(KiteMeasurements);
+
+constexpr double RvInfo::NACK_RATE_WEIGHT;
+constexpr double RvInfo::NACK_PENALTY;
+
+void
+RvInfo::recordRtt(time::nanoseconds rtt)
+{
+  m_rttEstimator.addMeasurement(rtt);
+  m_nackRate *= 1.0 - NACK_RATE_WEIGHT;
+}
+
+void
+RvInfo::recordNack()
+{
+  m_nackRate = m_nackRate * (1.0 - NACK_RATE_WEIGHT) + NACK_RATE_WEIGHT;
+}
+
+void
+RvInfo::recordTimeout()
+{
+  m_rttEstimator.backoffRto();
+  recordNack();
+}
+
+time::nanoseconds
+RvInfo::getCost() const
+{
+  auto rtt = hasRttMeasurement() ? getSrtt() : getRto();
+  return time::duration_cast<time::nanoseconds>(rtt * (1.0 + NACK_PENALTY * m_nackRate));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+constexpr time::microseconds KiteMeasurements::MEASUREMENTS_LIFETIME;
+
+KiteMeasurements::KiteMeasurements(MeasurementsAccessor& measurements)
+  : m_measurements(measurements)
+  , m_rttEstimatorOpts(make_shared<ndn::util::RttEstimator::Options>())
+{
+}
+
+RvInfo*
+KiteMeasurements::getRvInfo(const Name& rvPrefix, const Name& interestName) const
+{
+  auto* me = m_measurements.findExactMatch(rvPrefix);
+  if (me != nullptr) {
+    return me->getStrategyInfo<RvInfo>();
+  }
+
+  me = findRvInfoTable(interestName);
+  if (me == nullptr) {
+    return nullptr;
+  }
+  auto& rvs = me->getStrategyInfo<RvInfoTable>()->rvs;
+  auto it = rvs.find(rvPrefix);
+  return it == rvs.end() ? nullptr : &it->second;
+}
+
+RvInfo*
+KiteMeasurements::getOrCreateRvInfo(const Name& rvPrefix, const Name& interestName)
+{
+  auto* me = m_measurements.get(rvPrefix);
+  if (me != nullptr) {
+    m_measurements.extendLifetime(*me, MEASUREMENTS_LIFETIME);
+    return me->insertStrategyInfo<RvInfo>(m_rttEstimatorOpts).first;
+  }
+
+  // the RV prefix belongs to another strategy, keep its RvInfo in the KITE namespace
+  me = findRvInfoTable(interestName);
+  for (size_t i = 0; me == nullptr && i <= interestName.size(); ++i) {
+    me = m_measurements.get(interestName.getPrefix(i));
+  }
+  if (me == nullptr) {
+    return nullptr;
+  }
+  m_measurements.extendLifetime(*me, MEASUREMENTS_LIFETIME);
+  auto* table = me->insertStrategyInfo<RvInfoTable>().first;
+  auto it = table->rvs.find(rvPrefix);
+  if (it == table->rvs.end()) {
+    NFD_LOG_DEBUG("rv " << rvPrefix << " is outside the strategy namespace, measured at " << me->getName());
+    it = table->rvs.emplace(std::piecewise_construct, std::forward_as_tuple(rvPrefix),
+                            std::forward_as_tuple(m_rttEstimatorOpts)).first;
+  }
+  return &it->second;
+}
+
+measurements::Entry*
+KiteMeasurements::findRvInfoTable(const Name& interestName) const
+{
+  return m_measurements.findLongestPrefixMatch(interestName, [] (const measurements::Entry& entry) {
+    return entry.getStrategyInfo<RvInfoTable>() != nullptr;
+  });
+}
+
+std::vector<Name>
+KiteMeasurements::rankRvs(span<const Name> rvPrefixes, const Name& interestName) const
+{
+  std::vector<std::pair<time::nanoseconds, const Name*>> ranked;
+  ranked.reserve(rvPrefixes.size());
+  for (const auto& rvPrefix : rvPrefixes) {
+    auto* info = getRvInfo(rvPrefix, interestName);
+    ranked.emplace_back(info != nullptr ? info->getCost() : m_rttEstimatorOpts->initialRto, &rvPrefix);
+  }
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<Name> names;
+  names.reserve(ranked.size());
+  for (const auto& item : ranked) {
+    names.push_back(*item.second);
+  }
+  return names;
+}
+
+time::nanoseconds
+KiteMeasurements::getRvTimeout(const Name& rvPrefix, const Name& interestName) const
+{
+  auto* info = getRvInfo(rvPrefix, interestName);
+  return info != nullptr ? info->getRto() : m_rttEstimatorOpts->initialRto;
+}
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_KITE_MEASUREMENTS_HPP
+#define NFD_DAEMON_FW_KITE_MEASUREMENTS_HPP
+
+#include "fw/strategy-info.hpp"
+#include "table/measurements-accessor.hpp"
+
+#include <ndn-cxx/util/rtt-estimator.hpp>
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+/** \brief Strategy information about a rendezvous server (RV), stored on the RV prefix
+ */
+class RvInfo final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1136;
+  }
+
+  explicit
+  RvInfo(shared_ptr<const ndn::util::RttEstimator::Options> opts)
+    : m_rttEstimator(std::move(opts))
+  {
+  }
+
+  void
+  recordRtt(time::nanoseconds rtt);
+
+  void
+  recordNack();
+
+  void
+  recordTimeout();
+
+  bool
+  hasRttMeasurement() const
+  {
+    return m_rttEstimator.hasSamples();
+  }
+
+  time::nanoseconds
+  getSrtt() const
+  {
+    return m_rttEstimator.getSmoothedRtt();
+  }
+
+  time::nanoseconds
+  getRto() const
+  {
+    return m_rttEstimator.getEstimatedRto();
+  }
+
+  /** \return exponentially weighted fraction of Interests answered by a Nack or a timeout
+   */
+  double
+  getNackRate() const
+  {
+    return m_nackRate;
+  }
+
+  /** \brief Ranking cost of this RV, lower is better
+   *
+   *  The cost is the smoothed RTT, or the initial RTO when there is no measurement yet,
+   *  inflated by the NACK rate.
+   */
+  time::nanoseconds
+  getCost() const;
+
+public:
+  static constexpr double NACK_RATE_WEIGHT = 0.125;
+  static constexpr double NACK_PENALTY = 4.0;
+
+private:
+  ndn::util::RttEstimator m_rttEstimator;
+  double m_nackRate = 0.0;
+};
+
+/** \brief RvInfo of the RVs outside the strategy namespace, keyed by RV prefix
+ *
+ *  The Measurements entry of an RV prefix that another strategy is responsible for is not
+ *  accessible to the KITE strategy. The RvInfo of such an RV is stored in this table instead,
+ *  on a Measurements entry in the KITE namespace of the Interests that reached it.
+ */
+class RvInfoTable final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1139;
+  }
+
+  std::map<Name, RvInfo> rvs;
+};
+
+/** \brief Helper class to retrieve and create KITE strategy measurements
+ *
+ *  Each method takes the name of the Interest sent towards the RV, which locates the
+ *  RvInfoTable when the RV prefix is outside the strategy namespace.
+ */
+class KiteMeasurements : noncopyable
+{
+public:
+  explicit
+  KiteMeasurements(MeasurementsAccessor& measurements);
+
+  /** \return RvInfo of \p rvPrefix, or nullptr if it has no measurements
+   */
+  RvInfo*
+  getRvInfo(const Name& rvPrefix, const Name& interestName) const;
+
+  /** \return RvInfo of \p rvPrefix, or nullptr if \p interestName is outside the strategy namespace
+   */
+  RvInfo*
+  getOrCreateRvInfo(const Name& rvPrefix, const Name& interestName);
+
+  /** \brief Rank RV candidates carried by the KITE delegations of an Interest
+   *  \return \p rvPrefixes sorted by ascending RvInfo::getCost(); RVs without measurements
+   *          are ranked with the initial RTO, ties keep the ForwardingHint order
+   */
+  std::vector<Name>
+  rankRvs(span<const Name> rvPrefixes, const Name& interestName) const;
+
+  /** \return how long to wait for an RV before failing over to the next one
+   */
+  time::nanoseconds
+  getRvTimeout(const Name& rvPrefix, const Name& interestName) const;
+
+public:
+  static constexpr time::microseconds MEASUREMENTS_LIFETIME = 5_min;
+
+private:
+  /** \return the Measurements entry holding the RvInfoTable that serves \p interestName, or nullptr
+   */
+  measurements::Entry*
+  findRvInfoTable(const Name& interestName) const;
+
+private:
+  MeasurementsAccessor& m_measurements;
+  shared_ptr<const ndn::util::RttEstimator::Options> m_rttEstimatorOpts;
+};
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_KITE_MEASUREMENTS_HPP
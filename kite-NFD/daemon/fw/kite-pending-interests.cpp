@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-pending-interests.hpp"
+#include "table/name-tree.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+PendingInterestRecord::PendingInterestRecord(PendingInterestTable& table,
+                                             const shared_ptr<pit::Entry>& pitEntry, size_t hash)
+  : m_table(&table)
+  , m_pitEntry(pitEntry)
+  , m_hash(hash)
+{
+}
+
+PendingInterestRecord::~PendingInterestRecord()
+{
+  if (m_table != nullptr) {
+    m_table->unlink(*this);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+PendingInterestTable::~PendingInterestTable()
+{
+  for (const auto& bucket : m_buckets) {
+    for (PendingInterestRecord* record : bucket.second) {
+      record->m_table = nullptr;
+    }
+  }
+}
+
+bool
+PendingInterestTable::insert(const shared_ptr<pit::Entry>& pitEntry)
+{
+  BOOST_ASSERT(pitEntry != nullptr);
+
+  auto record = pitEntry->getStrategyInfo<PendingInterestRecord>();
+  if (record != nullptr) {
+    if (record->getTable() == this) {
+      return false;
+    }
+    pitEntry->eraseStrategyInfo<PendingInterestRecord>();
+  }
+
+  const name_tree::Entry* nte = name_tree::Entry::get(*pitEntry);
+  size_t hash = nte != nullptr ? nte->getHash() : name_tree::computeHash(pitEntry->getName());
+  record = pitEntry->insertStrategyInfo<PendingInterestRecord>(*this, pitEntry, hash).first;
+
+  auto& bucket = m_buckets[hash];
+  record->m_pos = bucket.size();
+  bucket.push_back(record);
+  ++m_nItems;
+  return true;
+}
+
+bool
+PendingInterestTable::erase(pit::Entry& pitEntry)
+{
+  if (!this->contains(pitEntry)) {
+    return false;
+  }
+  // the record unlinks itself when destroyed
+  pitEntry.eraseStrategyInfo<PendingInterestRecord>();
+  return true;
+}
+
+bool
+PendingInterestTable::contains(const pit::Entry& pitEntry) const
+{
+  auto record = pitEntry.getStrategyInfo<PendingInterestRecord>();
+  return record != nullptr && record->getTable() == this;
+}
+
+std::vector<shared_ptr<pit::Entry>>
+PendingInterestTable::getPitEntries() const
+{
+  std::vector<shared_ptr<pit::Entry>> entries;
+  entries.reserve(m_nItems);
+  for (const auto& bucket : m_buckets) {
+    for (const PendingInterestRecord* record : bucket.second) {
+      auto pitEntry = record->getPitEntry();
+      if (pitEntry != nullptr) {
+        entries.push_back(std::move(pitEntry));
+      }
+    }
+  }
+  return entries;
+}
+
+void
+PendingInterestTable::unlink(PendingInterestRecord& record)
+{
+  auto it = m_buckets.find(record.m_hash);
+  BOOST_ASSERT(it != m_buckets.end());
+  auto& bucket = it->second;
+  BOOST_ASSERT(record.m_pos < bucket.size() && bucket[record.m_pos] == &record);
+
+  // swap with the last record of the bucket, so that erasure is O(1)
+  bucket[record.m_pos] = bucket.back();
+  bucket[record.m_pos]->m_pos = record.m_pos;
+  bucket.pop_back();
+  if (bucket.empty()) {
+    m_buckets.erase(it);
+  }
+
+  record.m_table = nullptr;
+  --m_nItems;
+}
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_KITE_PENDING_INTERESTS_HPP
+#define NFD_DAEMON_FW_KITE_PENDING_INTERESTS_HPP
+
+#include "fw/strategy-info.hpp"
+#include "table/pit-entry.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+class PendingInterestTable;
+
+/** \brief Strategy information attached to a PIT entry that is indexed by a PendingInterestTable
+ *
+ *  The record ties the lifetime of the index item to the PIT entry: when the PIT entry is
+ *  destroyed, or its strategy information is cleared, the record removes itself from the table.
+ */
+class PendingInterestRecord final : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1135;
+  }
+
+  PendingInterestRecord(PendingInterestTable& table, const shared_ptr<pit::Entry>& pitEntry,
+                        size_t hash);
+
+  ~PendingInterestRecord() final;
+
+  /** \return the table this record is indexed in, or nullptr if the table is gone
+   */
+  PendingInterestTable*
+  getTable() const
+  {
+    return m_table;
+  }
+
+  shared_ptr<pit::Entry>
+  getPitEntry() const
+  {
+    return m_pitEntry.lock();
+  }
+
+  size_t
+  getHash() const
+  {
+    return m_hash;
+  }
+
+private:
+  PendingInterestTable* m_table;
+  weak_ptr<pit::Entry> m_pitEntry;
+  size_t m_hash;
+  size_t m_pos = 0; ///< position within the hash bucket
+
+  friend class PendingInterestTable;
+};
+
+/** \brief Index of Interests pending on a mobile producer
+ *
+ *  Items are keyed by the hash of the PIT entry's NameTree entry, so insertion and erasure
+ *  never hash the Interest name again. Each indexed PIT entry carries a PendingInterestRecord,
+ *  through which it can be erased in constant time. An item disappears together with its
+ *  PIT entry, therefore the table never holds expired entries.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  PendingInterestTable() = default;
+
+  ~PendingInterestTable();
+
+  /** \brief Index \p pitEntry
+   *  \retval true the entry was inserted
+   *  \retval false the entry was already indexed in this table
+   *
+   *  If \p pitEntry is indexed in another table, it is moved into this table.
+   */
+  bool
+  insert(const shared_ptr<pit::Entry>& pitEntry);
+
+  /** \brief Remove \p pitEntry from the index, if it is indexed in this table
+   *  \return whether an item was erased
+   */
+  bool
+  erase(pit::Entry& pitEntry);
+
+  /** \return whether \p pitEntry is indexed in this table
+   */
+  bool
+  contains(const pit::Entry& pitEntry) const;
+
+  size_t
+  size() const
+  {
+    return m_nItems;
+  }
+
+  bool
+  empty() const
+  {
+    return m_nItems == 0;
+  }
+
+  /** \return the indexed PIT entries
+   *
+   *  A snapshot is returned so that the caller may forward Interests, which can in turn
+   *  modify this table, while iterating over the result.
+   */
+  std::vector<shared_ptr<pit::Entry>>
+  getPitEntries() const;
+
+private:
+  void
+  unlink(PendingInterestRecord& record);
+
+private:
+  // std::hash<size_t> is the identity function, the NameTree hash is used as is
+  std::unordered_map<size_t, std::vector<PendingInterestRecord*>> m_buckets;
+  size_t m_nItems = 0;
+
+  friend class PendingInterestRecord;
+};
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_KITE_PENDING_INTERESTS_HPP
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-rib-updates.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+#include "rib/service.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+NFD_LOG_INIT(KiteRibUpdates);
+
+RibUpdateCoalescer::RibUpdateCoalescer(Dispatch dispatch)
+  : m_dispatch(dispatch != nullptr ? std::move(dispatch) : &RibUpdateCoalescer::dispatchToRib)
+  , m_stats(make_shared<RouteUpdateStats>())
+{
+}
+
+void
+RibUpdateCoalescer::setDispatch(Dispatch dispatch)
+{
+  m_dispatch = dispatch != nullptr ? std::move(dispatch) : &RibUpdateCoalescer::dispatchToRib;
+}
+
+void
+RibUpdateCoalescer::setWindow(time::milliseconds window)
+{
+  if (window < 0_ms) {
+    NDN_THROW(std::invalid_argument("Coalescing window cannot be negative"));
+  }
+  m_window = window;
+}
+
+void
+RibUpdateCoalescer::announce(const ndn::PrefixAnnouncement& pa, FaceId faceId,
+                             time::milliseconds maxLifetime)
+{
+  RouteUpdate update;
+  update.action = RouteUpdate::Action::ANNOUNCE;
+  update.prefix = pa.getAnnouncedName();
+  update.faceId = faceId;
+  update.announcement = pa;
+  update.maxLifetime = maxLifetime;
+  update.requestTime = time::steady_clock::now();
+  enqueue(std::move(update));
+}
+
+void
+RibUpdateCoalescer::announce(const Name& prefix, const Block& paData, FaceId faceId,
+                             time::milliseconds maxLifetime)
+{
+  RouteUpdate update;
+  update.action = RouteUpdate::Action::ANNOUNCE;
+  update.prefix = prefix;
+  update.faceId = faceId;
+  update.announcementData = paData;
+  update.maxLifetime = maxLifetime;
+  update.requestTime = time::steady_clock::now();
+  enqueue(std::move(update));
+}
+
+void
+RibUpdateCoalescer::withdraw(const Name& prefix, FaceId faceId)
+{
+  RouteUpdate update;
+  update.action = RouteUpdate::Action::WITHDRAW;
+  update.prefix = prefix;
+  update.faceId = faceId;
+  update.requestTime = time::steady_clock::now();
+  enqueue(std::move(update));
+}
+
+void
+RibUpdateCoalescer::enqueue(RouteUpdate update)
+{
+  ++m_stats->nRequested;
+
+  auto key = std::make_pair(update.prefix, update.faceId);
+  auto it = m_pending.find(key);
+  if (it != m_pending.end()) {
+    // the latest update on the same (prefix, face) supersedes the earlier one
+    NFD_LOG_TRACE("coalesce " << update.prefix << " face=" << update.faceId);
+    ++m_stats->nCoalesced;
+    it->second = std::move(update);
+  }
+  else {
+    m_pending.emplace(std::move(key), std::move(update));
+  }
+
+  if (!m_flushEvent) {
+    m_flushEvent = getScheduler().schedule(m_window, [this] { flush(); });
+  }
+}
+
+void
+RibUpdateCoalescer::flush()
+{
+  m_flushEvent.cancel();
+  if (m_pending.empty()) {
+    return;
+  }
+
+  std::vector<RouteUpdate> batch;
+  batch.reserve(m_pending.size());
+  for (auto& item : m_pending) {
+    batch.push_back(std::move(item.second));
+  }
+  m_pending.clear();
+
+  ++m_stats->nBatches;
+  NFD_LOG_DEBUG("flush n=" << batch.size());
+
+  m_dispatch(std::move(batch), [this, weakStats = weak_ptr<RouteUpdateStats>(m_stats)] (
+                                  const RouteUpdate& update, bool isSuccess) {
+    auto stats = weakStats.lock();
+    if (stats == nullptr) {
+      return;
+    }
+    if (!isSuccess) {
+      ++stats->nFailed;
+      return;
+    }
+    if (update.action == RouteUpdate::Action::ANNOUNCE) {
+      auto latency = time::steady_clock::now() - update.requestTime;
+      ++stats->nInstalled;
+      stats->lastInstallLatency = latency;
+      stats->maxInstallLatency = std::max(stats->maxInstallLatency, latency);
+      stats->totalInstallLatency += latency;
+      afterInstall(update, latency);
+    }
+  });
+}
+
+void
+RibUpdateCoalescer::dispatchToRib(std::vector<RouteUpdate> batch, DoneCallback done)
+{
+  // results are delivered on the thread that dispatched the batch, which is a forwarding thread
+  // when the forwarding pipelines are sharded
+  auto& io = getGlobalIoService();
+  runOnRibIoService([batch = std::move(batch), done = std::move(done), &io] {
+    auto& ribManager = rib::Service::get().getRibManager();
+    for (const auto& update : batch) {
+      auto cb = [update, done, &io] (RibManager::SlAnnounceResult res) {
+        NFD_LOG_DEBUG("kite-type route " << update.prefix << " face=" << update.faceId
+                      << (update.action == RouteUpdate::Action::ANNOUNCE ? " announce" : " withdraw")
+                      << " result=" << res);
+        // a withdrawal is carried out as an immediately expiring renewal
+        bool isSuccess = update.action == RouteUpdate::Action::ANNOUNCE ?
+                         res == RibManager::SlAnnounceResult::OK :
+                         res != RibManager::SlAnnounceResult::ERROR;
+        io.post([update, done, isSuccess] { done(update, isSuccess); });
+      };
+
+      if (update.action == RouteUpdate::Action::ANNOUNCE) {
+        optional<ndn::PrefixAnnouncement> pa = update.announcement;
+        if (!pa) {
+          try {
+            pa.emplace(Data(update.announcementData));
+          }
+          catch (const tlv::Error& e) {
+            NFD_LOG_DEBUG("kite-type route " << update.prefix << " face=" << update.faceId
+                          << " malformed announcement: " << e.what());
+            io.post([update, done] { done(update, false); });
+            continue;
+          }
+        }
+        ribManager.slAnnounce(*pa, update.faceId, update.maxLifetime, cb);
+      }
+      else {
+        ribManager.slRenew(update.prefix, update.faceId, 0_ms, cb);
+      }
+    }
+  });
+}
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
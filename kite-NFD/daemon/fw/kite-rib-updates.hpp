@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_KITE_RIB_UPDATES_HPP
+#define NFD_DAEMON_FW_KITE_RIB_UPDATES_HPP
+
+#include "face/face-common.hpp"
+
+#include <ndn-cxx/prefix-announcement.hpp>
+
+#include <map>
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+/** \brief A route change requested by KiteStrategy
+ */
+struct RouteUpdate
+{
+  enum class Action {
+    ANNOUNCE, ///< install a route from a prefix announcement carried in a KITE Ack
+    WITHDRAW, ///< remove a kite-type route after a NACK from the mobile producer
+  };
+
+  Action action;
+  Name prefix;
+  FaceId faceId;
+  /** \brief decoded announcement, set for ANNOUNCE when requested with a PrefixAnnouncement
+   */
+  optional<ndn::PrefixAnnouncement> announcement;
+  /** \brief prefix announcement Data, set for ANNOUNCE when requested with a KITE Ack
+   *
+   *  It shares the buffer of the Ack and is only decoded on the RIB thread.
+   */
+  Block announcementData;
+  time::milliseconds maxLifetime = 0_ms;
+  time::steady_clock::TimePoint requestTime; ///< when the Ack or NACK was received
+};
+
+/** \brief Statistics of route updates, maintained on the forwarding thread
+ */
+struct RouteUpdateStats
+{
+  uint64_t nRequested = 0;  ///< updates requested by the strategy
+  uint64_t nCoalesced = 0;  ///< updates superseded by a later update on the same (prefix, face)
+  uint64_t nBatches = 0;    ///< batches posted to the RIB thread
+  uint64_t nInstalled = 0;  ///< announcements that resulted in a FIB nexthop
+  uint64_t nFailed = 0;     ///< updates rejected by the RIB
+  time::nanoseconds lastInstallLatency = 0_ns; ///< Ack to FIB installation, last announcement
+  time::nanoseconds maxInstallLatency = 0_ns;
+  time::nanoseconds totalInstallLatency = 0_ns;
+};
+
+/** \brief Coalesces KITE route updates before they cross over to the RIB thread
+ *
+ *  Announcements and withdrawals for the same (prefix, FaceId) received within a short window
+ *  are merged, keeping only the latest one, and the survivors are delivered to the RIB thread
+ *  in a single post. The RIB reports the outcome of each update back to the forwarding thread,
+ *  where the latency between the KITE Ack and the FIB installation is recorded.
+ */
+class RibUpdateCoalescer : noncopyable
+{
+public:
+  /** \brief invoked on the forwarding thread when the RIB has processed an update
+   */
+  using DoneCallback = std::function<void(const RouteUpdate&, bool isSuccess)>;
+
+  /** \brief delivers a batch of updates to the RIB
+   *
+   *  \p done must be invoked on the forwarding thread, once per update.
+   */
+  using Dispatch = std::function<void(std::vector<RouteUpdate> batch, DoneCallback done)>;
+
+  /** \param dispatch delivery function, defaults to RibManager on the RIB thread
+   */
+  explicit
+  RibUpdateCoalescer(Dispatch dispatch = nullptr);
+
+  /** \brief Replace the delivery function
+   *  \param dispatch delivery function, nullptr restores the default
+   */
+  void
+  setDispatch(Dispatch dispatch);
+
+  time::milliseconds
+  getWindow() const
+  {
+    return m_window;
+  }
+
+  /** \brief Set the coalescing window
+   *
+   *  A zero window delivers updates in the next event-loop turn, which still coalesces
+   *  updates issued from the same turn.
+   *  \throw std::invalid_argument \p window is negative
+   */
+  void
+  setWindow(time::milliseconds window);
+
+  void
+  announce(const ndn::PrefixAnnouncement& pa, FaceId faceId, time::milliseconds maxLifetime);
+
+  /** \brief Announce \p prefix from the encoded prefix announcement \p paData
+   *  \param prefix the announced name of \p paData
+   */
+  void
+  announce(const Name& prefix, const Block& paData, FaceId faceId, time::milliseconds maxLifetime);
+
+  void
+  withdraw(const Name& prefix, FaceId faceId);
+
+  /** \brief Deliver pending updates immediately
+   */
+  void
+  flush();
+
+  size_t
+  getNPending() const
+  {
+    return m_pending.size();
+  }
+
+  const RouteUpdateStats&
+  getStats() const
+  {
+    return *m_stats;
+  }
+
+public:
+  /** \brief signals on the forwarding thread that an announcement resulted in a FIB nexthop
+   *
+   *  The second argument is the latency between the KITE Ack and the installation.
+   */
+  signal::Signal<RibUpdateCoalescer, RouteUpdate, time::nanoseconds> afterInstall;
+
+private:
+  void
+  enqueue(RouteUpdate update);
+
+  static void
+  dispatchToRib(std::vector<RouteUpdate> batch, DoneCallback done);
+
+private:
+  time::milliseconds m_window = 5_ms;
+  Dispatch m_dispatch;
+  std::map<std::pair<Name, FaceId>, RouteUpdate> m_pending;
+  scheduler::ScopedEventId m_flushEvent;
+  // in-flight completion callbacks, which may outlive the strategy, hold a weak reference
+  // and ignore the outcome once the coalescer is gone
+  shared_ptr<RouteUpdateStats> m_stats;
+};
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_KITE_RIB_UPDATES_HPP
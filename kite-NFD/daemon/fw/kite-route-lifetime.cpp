@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-route-lifetime.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+constexpr double RouteLifetimeEstimator::DWELL_WEIGHT;
+constexpr double RouteLifetimeEstimator::STALE_DECREASE;
+constexpr double RouteLifetimeEstimator::ACK_INCREASE;
+constexpr double RouteLifetimeEstimator::MIN_SCALE;
+constexpr double RouteLifetimeEstimator::REFRESH_MARGIN;
+
+void
+RouteLifetimeEstimator::addAck(bool isHandoff, time::steady_clock::TimePoint now)
+{
+  if (!m_lastHandoff) {
+    // the first Ack marks when the MP attached
+    m_lastHandoff = now;
+    m_lastAck = now;
+    return;
+  }
+  if (!isHandoff) {
+    m_scale = std::min(m_scale * ACK_INCREASE, 1.0);
+    // a handoff triggers an early request, so only Acks on the same face measure the refresh period
+    auto interval = now - m_lastAck;
+    m_lastAck = now;
+    if (interval <= 0_ns) {
+      return;
+    }
+    if (!m_hasRefreshInterval) {
+      m_refreshInterval = interval;
+      m_hasRefreshInterval = true;
+    }
+    else {
+      m_refreshInterval = time::duration_cast<time::nanoseconds>(
+        m_refreshInterval * (1.0 - DWELL_WEIGHT) + interval * DWELL_WEIGHT);
+    }
+    return;
+  }
+  m_lastAck = now;
+
+  auto dwell = now - *m_lastHandoff;
+  if (m_nDwellSamples == 0) {
+    m_dwellTime = dwell;
+  }
+  else {
+    m_dwellTime = time::duration_cast<time::nanoseconds>(
+      m_dwellTime * (1.0 - DWELL_WEIGHT) + dwell * DWELL_WEIGHT);
+  }
+  ++m_nDwellSamples;
+  m_lastHandoff = now;
+}
+
+void
+RouteLifetimeEstimator::addStaleRoute()
+{
+  m_scale = std::max(m_scale * STALE_DECREASE, MIN_SCALE);
+}
+
+time::milliseconds
+RouteLifetimeEstimator::computeLifetime(const Options& options, time::steady_clock::TimePoint now) const
+{
+  if (!hasDwellTime()) {
+    return options.maxLifetime;
+  }
+
+  // an MP that has stayed longer than its usual dwell time is likely to stay even longer
+  auto attached = now - *m_lastHandoff;
+  auto expected = std::max<time::nanoseconds>(m_dwellTime, attached);
+  auto lifetime = time::duration_cast<time::milliseconds>(expected * m_scale);
+  if (m_hasRefreshInterval) {
+    lifetime = std::max(lifetime, time::duration_cast<time::milliseconds>(m_refreshInterval * REFRESH_MARGIN));
+  }
+  return std::min(std::max(lifetime, options.minLifetime), options.maxLifetime);
+}
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_KITE_ROUTE_LIFETIME_HPP
+#define NFD_DAEMON_FW_KITE_ROUTE_LIFETIME_HPP
+
+#include "core/common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+
+/** \brief Picks the lifetime of the routes a mobile producer (MP) announces through KITE Acks
+ *
+ *  A route that outlives the attachment of the MP to its face is stale: Interests follow it
+ *  until the producer side answers with a Nack or stays silent. A route that expires while the
+ *  MP is still attached has to be announced again, which loads the RIB thread.
+ *
+ *  The estimator learns the mobility rate of an MP from the intervals between its handoffs
+ *  and sizes the lifetime after the expected dwell time on the current face. Each stale route
+ *  shrinks later lifetimes; each Ack that is not a handoff lets them grow back. The lifetime
+ *  never drops below REFRESH_MARGIN times the interval at which the MP refreshes its route,
+ *  otherwise the route would expire between two refreshes.
+ */
+class RouteLifetimeEstimator
+{
+public:
+  struct Options
+  {
+    Options() noexcept
+    {
+    }
+
+    /// lower bound of the lifetime
+    time::milliseconds minLifetime = 1_s;
+    /// upper bound of the lifetime, also used until the first handoff is seen
+    time::milliseconds maxLifetime = 5_min;
+  };
+
+  /** \brief record a KITE Ack from the MP
+   *  \param isHandoff whether the Ack arrived on a different face than the previous one
+   */
+  void
+  addAck(bool isHandoff, time::steady_clock::TimePoint now = time::steady_clock::now());
+
+  /** \brief record that a route of the MP turned out to be stale
+   */
+  void
+  addStaleRoute();
+
+  /** \return the lifetime of a route announced now
+   */
+  time::milliseconds
+  computeLifetime(const Options& options, time::steady_clock::TimePoint now = time::steady_clock::now()) const;
+
+  bool
+  hasRefreshInterval() const
+  {
+    return m_hasRefreshInterval;
+  }
+
+  /** \return smoothed interval between two Acks of the MP on the same face
+   *  \pre hasRefreshInterval()
+   */
+  time::nanoseconds
+  getRefreshInterval() const
+  {
+    return m_refreshInterval;
+  }
+
+  bool
+  hasDwellTime() const
+  {
+    return m_nDwellSamples > 0;
+  }
+
+  /** \return smoothed time the MP stays attached to a face
+   *  \pre hasDwellTime()
+   */
+  time::nanoseconds
+  getDwellTime() const
+  {
+    return m_dwellTime;
+  }
+
+  double
+  getScale() const
+  {
+    return m_scale;
+  }
+
+public:
+  static constexpr double DWELL_WEIGHT = 0.25;
+  static constexpr double STALE_DECREASE = 0.5;
+  static constexpr double ACK_INCREASE = 1.25;
+  static constexpr double MIN_SCALE = 0.125;
+  static constexpr double REFRESH_MARGIN = 1.5;
+
+private:
+  optional<time::steady_clock::TimePoint> m_lastHandoff;
+  time::steady_clock::TimePoint m_lastAck;
+  time::nanoseconds m_refreshInterval = 0_ns;
+  bool m_hasRefreshInterval = false;
+  time::nanoseconds m_dwellTime = 0_ns;
+  size_t m_nDwellSamples = 0;
+  double m_scale = 1.0;
+};
+
+} // namespace kite
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_KITE_ROUTE_LIFETIME_HPP
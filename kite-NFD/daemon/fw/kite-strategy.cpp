@@ -30,7 +30,6 @@
 #include "algorithm.hpp"
 #include "common/global.hpp"
 #include "common/logger.hpp"
-#include "rib/service.hpp"
 
 namespace nfd {
 namespace fw {
@@ -38,19 +37,102 @@ namespace fw {
 NFD_LOG_INIT(KiteStrategy);
 NFD_REGISTER_STRATEGY(KiteStrategy);
 
+KiteStrategy::KiteMobileProducerInfo::KiteMobileProducerInfo(const shared_ptr<ProducerRegistry>& registry)
+  : m_registry(registry)
+{
+  registry->insert(this);
+}
+
+KiteStrategy::KiteMobileProducerInfo::~KiteMobileProducerInfo()
+{
+  auto registry = m_registry.lock();
+  if (registry != nullptr) {
+    registry->erase(this);
+  }
+}
 
 KiteStrategy::KiteStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder), ProcessNackTraits(this)
+  , m_measurements(this->getMeasurements())
+  , m_handoff([this] (const shared_ptr<pit::Entry>& pitEntry, FaceId faceId) {
+                Face* face = this->getFace(faceId);
+                if (face == nullptr) {
+                  return false;
+                }
+                this->sendInterest(pitEntry->getInterest(), *face, pitEntry);
+                return true;
+              })
+  , m_removeFaceConn(beforeRemoveFace.connect([this] (const Face& face) { m_handoff.cancel(face.getId()); }))
 {
   ParsedInstanceName parsed = parseInstanceName(name);
-  if (!parsed.parameters.empty()) {
-    NDN_THROW(std::invalid_argument("KiteStrategy does not accept parameters"));
-  }
   if (parsed.version && *parsed.version != getStrategyName()[-1].toVersion()) {
     NDN_THROW(std::invalid_argument(
       "KiteStrategy does not support version " + to_string(*parsed.version)));
   }
+
+  StrategyParameters params = parseParameters(parsed.parameters);
+  m_handoff.setOptions(makeHandoffOptions(params));
+  m_ribUpdates.setWindow(time::milliseconds(
+    params.getOrDefault<time::milliseconds::rep>("rib-update-window", m_ribUpdates.getWindow().count())));
+  m_straightTimeoutMultiplier = params.getOrDefault<double>("mp-timeout-multiplier", m_straightTimeoutMultiplier);
+  if (m_straightTimeoutMultiplier < 1.0) {
+    NDN_THROW(std::invalid_argument("mp-timeout-multiplier cannot be less than 1"));
+  }
+  m_minStraightTimeout = time::milliseconds(
+    params.getOrDefault<time::milliseconds::rep>("mp-timeout-min", m_minStraightTimeout.count()));
+  if (m_minStraightTimeout < 0_ms) {
+    NDN_THROW(std::invalid_argument("mp-timeout-min cannot be negative"));
+  }
+  m_routeLifetimeOptions = makeRouteLifetimeOptions(params);
+
   this->setInstanceName(makeInstanceName(name, getStrategyName()));
+
+  m_ribUpdates.afterInstall.connect([this] (const kite::RouteUpdate& update, time::nanoseconds latency) {
+    auto mpInfo = findMpInfo(update.prefix);
+    if (mpInfo != nullptr) {
+      mpInfo->routeInstallLatency = latency;
+    }
+  });
+
+  const auto& handoffOptions = m_handoff.getOptions();
+  NFD_LOG_DEBUG("handoff-batch-size=" << handoffOptions.batchSize
+                << " handoff-batch-interval=" << handoffOptions.batchInterval
+                << " handoff-rate=" << handoffOptions.rate
+                << " handoff-burst=" << handoffOptions.burst
+                << " rib-update-window=" << m_ribUpdates.getWindow()
+                << " mp-timeout-multiplier=" << m_straightTimeoutMultiplier
+                << " mp-timeout-min=" << m_minStraightTimeout
+                << " route-lifetime-min=" << m_routeLifetimeOptions.minLifetime
+                << " route-lifetime-max=" << m_routeLifetimeOptions.maxLifetime);
+}
+
+kite::HandoffReforwarder::Options
+KiteStrategy::makeHandoffOptions(const StrategyParameters& params)
+{
+  kite::HandoffReforwarder::Options options;
+  options.batchSize = params.getOrDefault<size_t>("handoff-batch-size", options.batchSize);
+  options.batchInterval = time::milliseconds(
+    params.getOrDefault<time::milliseconds::rep>("handoff-batch-interval", options.batchInterval.count()));
+  options.rate = params.getOrDefault<size_t>("handoff-rate", options.rate);
+  options.burst = params.getOrDefault<size_t>("handoff-burst", options.burst);
+  return options;
+}
+
+kite::RouteLifetimeEstimator::Options
+KiteStrategy::makeRouteLifetimeOptions(const StrategyParameters& params)
+{
+  kite::RouteLifetimeEstimator::Options options;
+  options.minLifetime = time::milliseconds(
+    params.getOrDefault<time::milliseconds::rep>("route-lifetime-min", options.minLifetime.count()));
+  options.maxLifetime = time::milliseconds(
+    params.getOrDefault<time::milliseconds::rep>("route-lifetime-max", options.maxLifetime.count()));
+  if (options.minLifetime <= 0_ms) {
+    NDN_THROW(std::invalid_argument("route-lifetime-min must be positive"));
+  }
+  if (options.maxLifetime < options.minLifetime) {
+    NDN_THROW(std::invalid_argument("route-lifetime-max cannot be less than route-lifetime-min"));
+  }
+  return options;
 }
 
 const Name& KiteStrategy::getStrategyName() {
@@ -62,77 +144,80 @@ void
 KiteStrategy::afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
                       const shared_ptr<pit::Entry>& pitEntry)
 {
-  const auto& delegationList = interest.getForwardingHint();
+  const auto& kiteHints = interest.getKiteHints();
   const Face& inFace = ingress.face;
   bool foundNextHops = false;
-  if (!delegationList.empty())
+  if (!kiteHints.empty())
   {
-    // auto kiteHint = delegationList.end();
-    Name kiteHint;
-    for(auto &delegation : delegationList) {
-      if(!delegation.empty() && *delegation.begin() == ndn::kite::KITE_KEYWORD) {
-        kiteHint.append(delegation.getSubName(1));
+    // find fib entry by PIT entry
+    const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+    const fib::NextHopList& nextHops = fibEntry.getNextHops();
+    const auto& mpName = fibEntry.getPrefix();
+    auto inRecordInfo = pitEntry->getInRecord(inFace)->insertStrategyInfo<KiteInterestStatus>().first;
+    inRecordInfo->mpName = mpName;
+    for(auto& nextHop : nextHops) {
+      if(!isNextHopEligible(inFace, interest, nextHop, pitEntry)) {
+        continue;
       }
-    }
-
-    if(!kiteHint.empty()) {
-      // find fib entry by PIT entry
-      const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
-      const fib::NextHopList& nextHops = fibEntry.getNextHops();
-      const auto& mpName = fibEntry.getPrefix();
-      for(auto& nextHop : nextHops) {
-        if(!isNextHopEligible(inFace, interest, nextHop, pitEntry)) {
-          continue;
-        }
-        Face& outFace = nextHop.getFace();
-        if(!foundNextHops) {
-          foundNextHops = true;
-          auto inRecordInfo = pitEntry->getInRecord(inFace)->insertStrategyInfo<KiteInterestStatus>().first;
-          inRecordInfo->retrasmissionStage = InterestRetrasmissionStage::STRAIGHT_FORWARD;
-          inRecordInfo->rvName = kiteHint;
-        }
-        NFD_LOG_DEBUG("send Interest=" << interest << " from=" << inFace.getId() <<
-                  " to=" << outFace.getId());
-        auto outRecord = this->sendInterest(interest, outFace, pitEntry);
-        auto interestStatus = outRecord->insertStrategyInfo<KiteInterestStatus>().first;
-        interestStatus->retrasmissionStage = InterestRetrasmissionStage::STRAIGHT_FORWARD;
-        interestStatus->mpName = mpName;
+      Face& outFace = nextHop.getFace();
+      auto prevOutRecord = pitEntry->getOutRecord(outFace);
+      if (prevOutRecord != pitEntry->out_end() && prevOutRecord->getIncomingNack() != nullptr) {
+        // the producer has already been found unreachable by this route
+        continue;
       }
-      // If cannot found nexthop to transmit, use rv forwarding hint transmiting interest.
       if(!foundNextHops) {
-        // if cannot find fib entry, using rv name to find again.
-        const Name& rvName = kiteHint;
-        NFD_LOG_DEBUG("lookup nexthops by rv name: " << rvName.toUri());
-        const fib::Entry& rvEntry = this->lookupFib(rvName);
-        for(auto& nextHop : rvEntry.getNextHops()) {
-          if(!isNextHopEligible(inFace, interest, nextHop, pitEntry)) {
-            continue;
-          }
-          if(!foundNextHops) {
-            foundNextHops = true;
-          }
-          Face& outFace = nextHop.getFace();
-          NFD_LOG_DEBUG("send Interest=" << interest << " from=" << inFace.getId() <<
-                    " to=" << outFace.getId());
-          this->sendInterest(interest, outFace, pitEntry);
-        }
+        foundNextHops = true;
+        // back on the straight-forward path, every aggregated consumer follows
+        pitEntry->eraseStrategyInfo<KiteRvTimer>();
+        setInRecordStage(*pitEntry, InterestRetrasmissionStage::STRAIGHT_FORWARD);
       }
-      else {
-        const auto& entry = this->getMeasurements().get(mpName);
-        auto pki = entry->insertStrategyInfo<KiteMobileProducerInfo>().first;
-        pki->pitEntrys.insert(make_pair(interest.getName(), pitEntry));
+      NFD_LOG_DEBUG("send Interest=" << interest << " from=" << inFace.getId() <<
+                " to=" << outFace.getId());
+      auto outRecord = this->sendInterest(interest, outFace, pitEntry);
+      auto interestStatus = outRecord->insertStrategyInfo<KiteInterestStatus>().first;
+      interestStatus->retrasmissionStage = InterestRetrasmissionStage::STRAIGHT_FORWARD;
+      interestStatus->mpName = mpName;
+    }
+    // If cannot found nexthop to transmit, use rv forwarding hint transmiting interest.
+    if(!foundNextHops) {
+      inRecordInfo->retrasmissionStage = InterestRetrasmissionStage::RV;
+      auto rvStage = pitEntry->getStrategyInfo<KiteRvTimer>();
+      if (rvStage != nullptr && rvStage->timeoutEvent) {
+        // the transmission towards the current RV serves this consumer as well,
+        // once its timer has fired with no candidate left the retransmission starts over
+        NFD_LOG_DEBUG("aggregate Interest=" << interest << " from=" << inFace.getId() <<
+                      " rv=" << rvStage->rvName);
+        ++m_rvCounters.nRvRetxSaved;
+        foundNextHops = true;
       }
-      if (!foundNextHops)
-      {
-        // reject the interest
-        NFD_LOG_DEBUG("NACK Interest=" << interest << " from=" << ingress << " noNextHop");
-        lp::NackHeader nackHeader;
-        nackHeader.setReason(lp::NackReason::NO_ROUTE);
-        this->sendNack(nackHeader, ingress.face, pitEntry);
-        this->rejectPendingInterest(pitEntry);
+      else {
+        // every KITE delegation is an RV candidate, the best measured one is tried first
+        rvStage = pitEntry->insertStrategyInfo<KiteRvTimer>().first;
+        rvStage->rvNames = m_measurements.rankRvs(kiteHints, interest.getName());
+        rvStage->rvIndex = 0;
+        foundNextHops = this->forwardToRv(inFace, *rvStage, pitEntry, false);
       }
-      return;
     }
+    else {
+      const auto& entry = this->getMeasurements().get(mpName);
+      auto pki = &getOrCreateMpInfo(*entry, mpName);
+      pki->pendingInterests.insert(pitEntry);
+      // a producer that left without a Nack is detected by the lack of an answer
+      auto timer = pitEntry->insertStrategyInfo<KiteStraightTimer>().first;
+      timer->mpName = mpName;
+      timer->timeoutEvent = getScheduler().schedule(getStraightTimeout(*pki),
+        [this, weakPitEntry = weak_ptr<pit::Entry>(pitEntry)] { onStraightTimeout(weakPitEntry); });
+    }
+    if (!foundNextHops)
+    {
+      // reject the interest
+      NFD_LOG_DEBUG("NACK Interest=" << interest << " from=" << ingress << " noNextHop");
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(nackHeader, ingress.face, pitEntry);
+      this->rejectPendingInterest(pitEntry);
+    }
+    return;
   }
 
   const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
@@ -183,6 +268,20 @@ KiteStrategy::afterReceiveNack(const lp::Nack& nack, const FaceEndpoint& ingress
        const Name& name = interestStage->mpName;
        NFD_LOG_DEBUG("NACK received for KITE mp interest. remove route" << interestStage->mpName);
        this->removePrefix(name, ingress.face.getId());
+       // the producer has moved; RV Interests left from an earlier stage do not reach it
+       if (!dealNack(pitEntry)) {
+         NFD_LOG_DEBUG("cannot find eligible rv face to retransmit " << pitEntry->getInterest() << " send nack");
+         this->sendNacks(nack.getHeader(), pitEntry);
+         eraseMeasurement(*pitEntry);
+       }
+       return;
+      }
+      else {
+        NFD_LOG_DEBUG("NACK received from rv " << interestStage->rvName);
+        auto rvInfo = m_measurements.getOrCreateRvInfo(interestStage->rvName, pitEntry->getName());
+        if (rvInfo != nullptr) {
+          rvInfo->recordNack();
+        }
       }
     }
   }
@@ -194,47 +293,113 @@ KiteStrategy::beforeSatisfyInterest(const Data& data,
                   const FaceEndpoint& ingress, const shared_ptr<pit::Entry>& pitEntry)
 {
   if (data.getContentType() == tlv::ContentType_KiteAck){
-    ndn::kite::Ack ack(data);
-    this->registPrefix(pitEntry, ack);
+    optional<ndn::kite::AckView> ack;
+    try {
+      ack.emplace(data);
+    }
+    catch (const tlv::Error& e) {
+      NFD_LOG_DEBUG("malformed KITE Ack " << data.getName() << ": " << e.what());
+      return;
+    }
+    this->registPrefix(pitEntry, *ack);
   }
   else {
-    auto outRecord = pitEntry->getOutRecord(ingress.face);
-    if (outRecord != pitEntry->out_end()) {
-      eraseMeasurement(*outRecord, pitEntry->getName());
+    recordRtt(ingress, *pitEntry);
+    pitEntry->eraseStrategyInfo<KiteStraightTimer>();
+    pitEntry->eraseStrategyInfo<KiteRvTimer>();
+    eraseMeasurement(*pitEntry);
+  }
+}
+
+void
+KiteStrategy::recordRtt(const FaceEndpoint& ingress, pit::Entry& pitEntry)
+{
+  auto outRecord = pitEntry.getOutRecord(ingress.face);
+  if (outRecord == pitEntry.out_end()) {
+    return;
+  }
+  auto status = outRecord->getStrategyInfo<KiteInterestStatus>();
+  if (status == nullptr) {
+    return;
+  }
+  auto rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  if (status->retrasmissionStage == InterestRetrasmissionStage::STRAIGHT_FORWARD) {
+    auto mpInfo = findMpInfo(status->mpName);
+    if (mpInfo != nullptr) {
+      mpInfo->rttEstimator.addMeasurement(rtt);
     }
+    return;
+  }
+  auto rvInfo = m_measurements.getOrCreateRvInfo(status->rvName, pitEntry.getName());
+  if (rvInfo != nullptr) {
+    rvInfo->recordRtt(rtt);
   }
 }
 
+time::nanoseconds
+KiteStrategy::getStraightTimeout(const KiteMobileProducerInfo& mpInfo) const
+{
+  const auto& rtt = mpInfo.rttEstimator;
+  if (!rtt.hasSamples()) {
+    return rtt.getEstimatedRto();
+  }
+  auto timeout = time::duration_cast<time::nanoseconds>(rtt.getSmoothedRtt() * m_straightTimeoutMultiplier);
+  return std::max<time::nanoseconds>(timeout, m_minStraightTimeout);
+}
+
 void
-KiteStrategy::registPrefix(const shared_ptr<pit::Entry>& pitEntry, const ndn::kite::Ack& ack) {
-  NFD_LOG_DEBUG("ACK received for KITE trace interest. regist route" << ack.getPrefixAnnouncement()->getAnnouncedName().toUri());
+KiteStrategy::onStraightTimeout(const weak_ptr<pit::Entry>& weakPitEntry)
+{
+  auto pitEntry = weakPitEntry.lock();
+  if (pitEntry == nullptr || pitEntry->isSatisfied) {
+    return;
+  }
+  auto timer = pitEntry->getStrategyInfo<KiteStraightTimer>();
+  if (timer == nullptr) {
+    return;
+  }
+  NFD_LOG_DEBUG("mp " << timer->mpName << " timed out for " << pitEntry->getInterest() << ", fall back to rv");
+  auto mpInfo = findMpInfo(timer->mpName);
+  if (mpInfo != nullptr) {
+    mpInfo->rttEstimator.backoffRto();
+  }
+
+  dealNack(pitEntry, true);
+}
+
+void
+KiteStrategy::registPrefix(const shared_ptr<pit::Entry>& pitEntry, const ndn::kite::AckView& ack) {
+  // decoded once, the announcement itself is handed to the RIB as the wire of the Ack
+  const Name mpName = ack.getAnnouncedName();
+  NFD_LOG_DEBUG("ACK received for KITE trace interest. regist route" << mpName);
+  measurements::Entry* entry = nullptr;
   for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
     if (inRecord.getFace().getScope() != ndn::nfd::FACE_SCOPE_LOCAL && inRecord.getExpiry() > time::steady_clock::now()) {
-      auto& pa = *ack.getPrefixAnnouncement();
-      runOnRibIoService([pitEntryWeak = weak_ptr<pit::Entry>{pitEntry}, inFaceId = inRecord.getFace().getId(), pa] {
-        rib::Service::get().getRibManager().slAnnounce(pa, inFaceId, time::milliseconds(5_min),
-          [&] (RibManager::SlAnnounceResult res) {
-            NFD_LOG_DEBUG("Add kite-type route via PrefixAnnouncement with result=" << res);
-          });
-      });
-      // retransmit pending interest to new mp
-      const Name& mpName = pa.getAnnouncedName();
-      auto entry = this->getMeasurements().get(mpName);
-      if(entry == nullptr) {
-        return;
+      if (entry == nullptr) {
+        entry = this->getMeasurements().get(mpName);
+        if (entry == nullptr) {
+          // outside the strategy namespace, there is nothing to learn the lifetime from
+          m_ribUpdates.announce(mpName, ack.getPrefixAnnouncementData(), inRecord.getFace().getId(),
+                                m_routeLifetimeOptions.maxLifetime);
+          return;
+        }
+        this->getMeasurements().extendLifetime(*entry, time::duration_cast<time::nanoseconds>(ack.getExpiration()));
       }
-      this->getMeasurements().extendLifetime(*entry, time::duration_cast<time::nanoseconds>(pa.getExpiration()));
-      auto mpInfo = entry->getStrategyInfo<KiteMobileProducerInfo>();
+      auto mpInfo = &getOrCreateMpInfo(*entry, mpName);
       auto& mpFace = inRecord.getFace();
-      if(mpInfo != nullptr && mpInfo->faceIds.find(mpFace.getId()) == mpInfo->faceIds.end()) {
+      bool isHandoff = mpInfo->lastFaceId != face::INVALID_FACEID && mpInfo->lastFaceId != mpFace.getId();
+      if (isHandoff) {
+        ++mpInfo->nHandoffs;
+      }
+      mpInfo->lastFaceId = mpFace.getId();
+      mpInfo->routeLifetimeEstimator.addAck(isHandoff);
+      mpInfo->routeLifetime = mpInfo->routeLifetimeEstimator.computeLifetime(m_routeLifetimeOptions);
+      m_ribUpdates.announce(mpName, ack.getPrefixAnnouncementData(), mpFace.getId(), *mpInfo->routeLifetime);
+      // retransmit pending interest to new mp
+      if(mpInfo->faceIds.find(mpFace.getId()) == mpInfo->faceIds.end()) {
         mpInfo->faceIds.insert(mpFace.getId());
-        for(auto& item : mpInfo->pitEntrys) {
-          shared_ptr<pit::Entry> pitEntry = item.second.lock();
-          if (pitEntry)
-          {
-            this->sendInterest(pitEntry->getInterest(), mpFace, pitEntry);
-          }
-        }
+        // pending Interests are paced out to the new face rather than flooded in one turn
+        m_handoff.enqueue(mpFace.getId(), mpInfo->pendingInterests.getPitEntries());
       }
     }
   }
@@ -243,17 +408,13 @@ KiteStrategy::registPrefix(const shared_ptr<pit::Entry>& pitEntry, const ndn::ki
 void
 KiteStrategy::removePrefix(const Name& name, FaceId inFaceId)
 {
-  runOnRibIoService([name, inFaceId] {
-    rib::Service::get().getRibManager().slRenew(name, inFaceId, 0_ms,
-      [name] (RibManager::SlAnnounceResult res) {
-        NFD_LOG_DEBUG("Delete route " << name.toUri() << " with result=" << res);
-      });
-  });
-  auto entry = this->getMeasurements().get(name);
-  auto kiteMpInfo = entry->getStrategyInfo<KiteMobileProducerInfo>();
+  m_ribUpdates.withdraw(name, inFaceId);
+  auto kiteMpInfo = findMpInfo(name);
   if (kiteMpInfo != nullptr)
   {
     kiteMpInfo->faceIds.erase(inFaceId);
+    // Interests still queued for the face would only reach the producer's old location
+    m_handoff.cancel(inFaceId, kiteMpInfo->pendingInterests.getPitEntries());
   }
 }
 
@@ -263,13 +424,10 @@ KiteStrategy::sendNackForProcessNackTraits(const shared_ptr<pit::Entry>& pitEntr
 {
   // inFace and outFace are the same under this situiation
   auto inRecord = pitEntry->getInRecord(outFace);
-  if(!dealNack(*inRecord, pitEntry)) {
+  if(!dealNack(pitEntry)) {
     NFD_LOG_DEBUG("cannot find eligible rv face to retransmit " << pitEntry->getInterest() << " send nack");
     this->sendNack(header, inRecord->getFace(), pitEntry);
-    auto outRecord = pitEntry->getOutRecord(outFace);
-    if(outRecord != pitEntry->out_end()) {
-    eraseMeasurement(*outRecord, pitEntry->getName());
-    }
+    eraseMeasurement(*pitEntry);
   }
 }
 
@@ -277,76 +435,160 @@ void
 KiteStrategy::sendNacksForProcessNackTraits(const shared_ptr<pit::Entry>& pitEntry,
                               const lp::NackHeader& header)
 {
-  auto& inRecords = pitEntry->getInRecords();
-  const auto& inRecord = std::find_if(inRecords.begin(), inRecords.end(), [&](const pit::InRecord& inRecord) {
-    return dealNack(inRecord, pitEntry);
-  });
-  if(inRecord == inRecords.end()) {
+  if(!dealNack(pitEntry)) {
     NFD_LOG_DEBUG("cannot find eligible rv face to retransmit " << pitEntry->getInterest() << " send nack");
     this->sendNacks(header, pitEntry);
-    auto outRecord = pitEntry->out_begin();
-    if (outRecord != pitEntry->out_end()) {
-      eraseMeasurement(*outRecord, pitEntry->getName());
-    }
+    eraseMeasurement(*pitEntry);
   }
 }
 
+KiteStrategy::KiteMobileProducerInfo&
+KiteStrategy::getOrCreateMpInfo(measurements::Entry& entry, const Name& mpName)
+{
+  auto mpInfo = entry.insertStrategyInfo<KiteMobileProducerInfo>(m_producers).first;
+  mpInfo->mpName = mpName;
+  return *mpInfo;
+}
+
+KiteStrategy::KiteMobileProducerInfo*
+KiteStrategy::findMpInfo(const Name& mpName)
+{
+  auto entry = this->getMeasurements().findExactMatch(mpName);
+  return entry == nullptr ? nullptr : entry->getStrategyInfo<KiteMobileProducerInfo>();
+}
+
 void
-KiteStrategy::eraseMeasurement(const pit::OutRecord& inRecord, const Name& interestName)
+KiteStrategy::eraseMeasurement(pit::Entry& pitEntry)
 {
-  auto interestStage = inRecord.getStrategyInfo<KiteInterestStatus>();
-  if(interestStage != nullptr) {
-    const Name& mpName = interestStage->mpName;
-    auto entry = this->getMeasurements().get(mpName);
-    auto pki = entry->getStrategyInfo<KiteMobileProducerInfo>();
-    if(pki != nullptr) {
-      pki->pitEntrys.erase(interestName);
+  // the PIT entry knows the pending-Interest table it is indexed in, no Measurements lookup needed
+  auto record = pitEntry.getStrategyInfo<kite::PendingInterestRecord>();
+  if (record != nullptr && record->getTable() != nullptr) {
+    record->getTable()->erase(pitEntry);
+  }
+}
+
+bool
+KiteStrategy::dealNack(const shared_ptr<pit::Entry>& pitEntry, bool isTimeout)
+{
+  size_t nConsumers = 0;
+  const Face* inFace = nullptr;
+  std::tie(nConsumers, inFace) = setInRecordStage(*pitEntry, InterestRetrasmissionStage::RV);
+  if (nConsumers == 0) {
+    return false;
+  }
+
+  auto rvStage = pitEntry->getStrategyInfo<KiteRvTimer>();
+  KiteMobileProducerInfo* fallbackMpInfo = nullptr;
+  if (rvStage == nullptr) {
+    auto straightTimer = pitEntry->getStrategyInfo<KiteStraightTimer>();
+    if (straightTimer != nullptr) {
+      fallbackMpInfo = findMpInfo(straightTimer->mpName);
+      pitEntry->eraseStrategyInfo<KiteStraightTimer>();
     }
+    rvStage = pitEntry->insertStrategyInfo<KiteRvTimer>().first;
+    rvStage->rvNames = m_measurements.rankRvs(pitEntry->getInterest().getKiteHints(), pitEntry->getName());
+    rvStage->rvIndex = 0;
   }
+  else {
+    // the current RV has failed, fail over to the next candidate
+    rvStage->timeoutEvent.cancel();
+    ++rvStage->rvIndex;
+  }
+
+  if (!forwardToRv(*inFace, *rvStage, pitEntry, true)) {
+    return false;
+  }
+  if (fallbackMpInfo != nullptr) {
+    ++(isTimeout ? fallbackMpInfo->nTimeoutFallbacks : fallbackMpInfo->nNackFallbacks);
+    // the route led to a face the producer is no longer reachable on
+    fallbackMpInfo->routeLifetimeEstimator.addStaleRoute();
+  }
+  m_rvCounters.nRvRetxSaved += nConsumers - 1;
+  return true;
+}
+
+std::pair<size_t, const Face*>
+KiteStrategy::setInRecordStage(pit::Entry& pitEntry, InterestRetrasmissionStage stage)
+{
+  size_t nUpdated = 0;
+  const Face* face = nullptr;
+  auto now = time::steady_clock::now();
+  for (const pit::InRecord& inRecord : pitEntry.getInRecords()) {
+    auto status = inRecord.getStrategyInfo<KiteInterestStatus>();
+    if (status == nullptr || inRecord.getExpiry() <= now) {
+      continue;
+    }
+    status->retrasmissionStage = stage;
+    face = &inRecord.getFace();
+    ++nUpdated;
+  }
+  return {nUpdated, face};
 }
 
 bool
-KiteStrategy::dealNack(const pit::InRecord& inRecord, const shared_ptr<pit::Entry>& pitEntry)
+KiteStrategy::forwardToRv(const Face& inFace, KiteRvTimer& rvStage,
+                          const shared_ptr<pit::Entry>& pitEntry, bool skipUsedFaces)
 {
   auto& inRecords = pitEntry->getInRecords();
   auto& interest = pitEntry->getInterest();
-  auto interestStatus = inRecord.getStrategyInfo<KiteInterestStatus>();
-  if(interestStatus != nullptr) {
-    if (interestStatus->retrasmissionStage == InterestRetrasmissionStage::STRAIGHT_FORWARD) {
-      interestStatus->retrasmissionStage = InterestRetrasmissionStage::RV;
-      Name& name = interestStatus->rvName;
-      // retransmission
-      auto& fib = this->lookupFib(name);
-      auto nextHops = fib.getNextHops();
-      bool foundNextHops = false;
-      auto& outRecords = pitEntry->getOutRecords();
-      for(auto& nextHop : nextHops) {
-        auto& outFace = nextHop.getFace();
-        auto foundIn = std::find_if(inRecords.begin(), inRecords.end(), [&](const pit::InRecord& inRecord){
-            auto& inFace = inRecord.getFace();
-            return inFace.getId() == outFace.getId();
-        });
-        if(foundIn != inRecords.end()) {
-          continue;
-        }
-        auto foundOut = std::find_if(outRecords.begin(), outRecords.end(), [&](const pit::OutRecord& outRecord){
-          auto& lastOutFace = outRecord.getFace();
-          return lastOutFace.getId() == outFace.getId();
+  for (; rvStage.rvIndex < rvStage.rvNames.size(); ++rvStage.rvIndex) {
+    const Name& rvName = rvStage.rvNames[rvStage.rvIndex];
+    NFD_LOG_DEBUG("lookup nexthops by rv name: " << rvName.toUri());
+    bool foundNextHops = false;
+    for (auto& nextHop : this->lookupFib(rvName).getNextHops()) {
+      auto& outFace = nextHop.getFace();
+      if (skipUsedFaces) {
+        auto foundIn = std::find_if(inRecords.begin(), inRecords.end(), [&] (const pit::InRecord& inRecord) {
+          return inRecord.getFace().getId() == outFace.getId();
         });
-        if(foundOut != outRecords.end()) {
+        if (foundIn != inRecords.end() || pitEntry->getOutRecord(outFace) != pitEntry->out_end()) {
           continue;
         }
-        if(!foundNextHops) {
-          foundNextHops = true;
-        }
-        NFD_LOG_DEBUG("send Interest=" << interest << " from=" << inRecord.getFace().getId() <<
-                    " to=" << nextHop.getFace().getId());
-        this->sendInterest(interest, nextHop.getFace(), pitEntry);
       }
-      return foundNextHops;
+      if (!isNextHopEligible(inFace, interest, nextHop, pitEntry)) {
+        continue;
+      }
+      foundNextHops = true;
+      NFD_LOG_DEBUG("send Interest=" << interest << " from=" << inFace.getId() <<
+                    " to=" << outFace.getId() << " rv=" << rvName);
+      auto outRecord = this->sendInterest(interest, outFace, pitEntry);
+      ++m_rvCounters.nRvInterests;
+      if (outRecord != nullptr) {
+        auto outStatus = outRecord->insertStrategyInfo<KiteInterestStatus>().first;
+        outStatus->retrasmissionStage = InterestRetrasmissionStage::RV;
+        outStatus->rvName = rvName;
+      }
+    }
+    if (foundNextHops) {
+      // fail over to the next RV if this one neither answers nor Nacks within its RTO
+      rvStage.rvName = rvName;
+      rvStage.timeoutEvent = getScheduler().schedule(m_measurements.getRvTimeout(rvName, pitEntry->getName()),
+        [this, weakPitEntry = weak_ptr<pit::Entry>(pitEntry)] { onRvTimeout(weakPitEntry); });
+      return true;
     }
   }
   return false;
 }
+
+void
+KiteStrategy::onRvTimeout(const weak_ptr<pit::Entry>& weakPitEntry)
+{
+  auto pitEntry = weakPitEntry.lock();
+  if (pitEntry == nullptr || pitEntry->isSatisfied) {
+    return;
+  }
+  auto timer = pitEntry->getStrategyInfo<KiteRvTimer>();
+  if (timer == nullptr) {
+    return;
+  }
+  NFD_LOG_DEBUG("rv " << timer->rvName << " timed out for " << pitEntry->getInterest());
+  auto rvInfo = m_measurements.getOrCreateRvInfo(timer->rvName, pitEntry->getName());
+  if (rvInfo != nullptr) {
+    rvInfo->recordTimeout();
+  }
+
+  dealNack(pitEntry, true);
+}
+
 } // namespace fw
 } // namespace nfd
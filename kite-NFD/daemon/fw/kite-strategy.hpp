@@ -30,10 +30,15 @@
 #define NFD_DAEMON_FW_KITE_STRATEGY_HPP
 
 #include "fw/strategy.hpp"
+#include "kite-handoff.hpp"
+#include "kite-measurements.hpp"
+#include "kite-pending-interests.hpp"
+#include "kite-rib-updates.hpp"
+#include "kite-route-lifetime.hpp"
 #include "process-nack-traits.hpp"
 
 #include <ndn-cxx/lp/prefix-announcement-header.hpp>
-#include <ndn-cxx/kite/ack.hpp>
+#include <ndn-cxx/kite/ack-view.hpp>
 #include <ndn-cxx/kite/request.hpp>
 
 namespace nfd {
@@ -68,11 +73,75 @@ public:
     }
 
   public:
+    /// on an in-record: the stage the consumer's Interest is in, the same for every
+    /// unexpired in-record of a PIT entry;
+    /// on an out-record: the stage the Interest was sent in
     InterestRetrasmissionStage retrasmissionStage;
+    /// on an out-record in RV stage: the RV the Interest was sent towards
     Name rvName;
     Name mpName;
   };
 
+  /** \brief PIT entry state while an Interest is forwarded straight to the mobile producer
+   */
+  class KiteStraightTimer : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1138;
+    }
+
+  public:
+    Name mpName;
+    scheduler::ScopedEventId timeoutEvent;
+  };
+
+  /** \brief PIT entry state while an Interest is forwarded towards an RV
+   *
+   *  The RV stage belongs to the PIT entry rather than to its in-records: a single
+   *  retransmission towards the current RV serves every consumer aggregated in the entry.
+   */
+  class KiteRvTimer : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1137;
+    }
+
+  public:
+    /// RV candidates ranked by KiteMeasurements, tried in this order
+    std::vector<Name> rvNames;
+    /// index in rvNames of the RV currently being tried
+    size_t rvIndex = 0;
+    Name rvName;
+    scheduler::ScopedEventId timeoutEvent;
+  };
+
+  /** \brief counters of Interests forwarded towards RVs
+   */
+  struct RvCounters
+  {
+    /// number of Interests sent towards an RV
+    uint64_t nRvInterests = 0;
+    /// number of RV-stage transmissions avoided because consumers were aggregated in
+    /// a PIT entry that was already, or moved as a whole, in the RV stage
+    uint64_t nRvRetxSaved = 0;
+  };
+
+  class KiteMobileProducerInfo;
+
+  /** \brief the mobile producers known to a strategy instance
+   *
+   *  Each KiteMobileProducerInfo stays in the registry of the strategy that created it
+   *  until its Measurements entry goes away, so that the producers can be enumerated
+   *  without walking the Measurements table.
+   */
+  using ProducerRegistry = std::unordered_set<const KiteMobileProducerInfo*>;
+
   class KiteMobileProducerInfo: public StrategyInfo
   {
   public:
@@ -83,12 +152,75 @@ public:
       return 1134;
     }
 
+    KiteMobileProducerInfo() = default;
+
+    explicit
+    KiteMobileProducerInfo(const shared_ptr<ProducerRegistry>& registry);
+
+    ~KiteMobileProducerInfo() override;
+
   public:
     Name mpName;
-    std::unordered_map<Name, weak_ptr<pit::Entry>> pitEntrys;
+    kite::PendingInterestTable pendingInterests;
     std::unordered_set<face::FaceId> faceIds;
+    /// RTT of Interests answered over the straight-forward path
+    ndn::util::RttEstimator rttEstimator;
+
+    /// face on which the latest KITE Ack arrived
+    face::FaceId lastFaceId = face::INVALID_FACEID;
+    /// number of times a KITE Ack arrived on a face other than the previous one
+    uint64_t nHandoffs = 0;
+    /// number of Interests that fell back to an RV after a Nack from the producer
+    uint64_t nNackFallbacks = 0;
+    /// number of Interests that fell back to an RV after the straight-forward path timed out
+    uint64_t nTimeoutFallbacks = 0;
+    /// time from the latest KITE Ack until its route was installed in the FIB
+    optional<time::nanoseconds> routeInstallLatency;
+    /// learns how long routes towards the producer stay valid
+    kite::RouteLifetimeEstimator routeLifetimeEstimator;
+    /// lifetime of the latest route announced for the producer
+    optional<time::milliseconds> routeLifetime;
+
+  private:
+    weak_ptr<ProducerRegistry> m_registry;
   };
 
+  const kite::HandoffReforwarder::Counters&
+  getHandoffCounters() const
+  {
+    return m_handoff.getCounters();
+  }
+
+  const kite::RouteUpdateStats&
+  getRouteUpdateStats() const
+  {
+    return m_ribUpdates.getStats();
+  }
+
+  const RvCounters&
+  getRvCounters() const
+  {
+    return m_rvCounters;
+  }
+
+  const kite::RouteLifetimeEstimator::Options&
+  getRouteLifetimeOptions() const
+  {
+    return m_routeLifetimeOptions;
+  }
+
+  const kite::KiteMeasurements&
+  getKiteMeasurements() const
+  {
+    return m_measurements;
+  }
+
+  const ProducerRegistry&
+  getProducers() const
+  {
+    return *m_producers;
+  }
+
 public: // triggers
   void
   afterReceiveInterest(const Interest& interest, const FaceEndpoint& ingress,
@@ -104,7 +236,7 @@ public: // triggers
 
 private:
   void
-  registPrefix(const shared_ptr<pit::Entry>& pitEntry, const ndn::kite::Ack& ack);
+  registPrefix(const shared_ptr<pit::Entry>& pitEntry, const ndn::kite::AckView& ack);
   friend ProcessNackTraits<KiteStrategy>;
 
   void
@@ -117,11 +249,83 @@ private:
   sendNacksForProcessNackTraits(const shared_ptr<pit::Entry>& pitEntry,
                                 const lp::NackHeader& header) override;
 
+  /** \brief move all consumers of \p pitEntry to the RV stage, or to the next RV candidate
+   *         if they are in the RV stage already, with a single transmission
+   *  \param isTimeout whether the upstream stayed silent, rather than returned a Nack
+   *  \return whether the Interest has been sent
+   */
   bool
-  dealNack(const pit::InRecord& inRecord, const shared_ptr<pit::Entry>& pitEntry);
+  dealNack(const shared_ptr<pit::Entry>& pitEntry, bool isTimeout = false);
+
+  /** \brief set the stage of every unexpired in-record of \p pitEntry that carries a status
+   *  \return number of in-records updated, and the downstream face of one of them
+   */
+  std::pair<size_t, const Face*>
+  setInRecordStage(pit::Entry& pitEntry, InterestRetrasmissionStage stage);
+
+  /** \brief forward the Interest towards the current RV candidate of \p rvStage,
+   *         failing over to the next candidates until one has an eligible nexthop
+   *  \param skipUsedFaces whether upstreams that already have an out-record are skipped
+   *  \return whether the Interest has been sent
+   */
+  bool
+  forwardToRv(const Face& inFace, KiteRvTimer& rvStage,
+              const shared_ptr<pit::Entry>& pitEntry, bool skipUsedFaces);
+
+  void
+  onRvTimeout(const weak_ptr<pit::Entry>& weakPitEntry);
+
+  void
+  recordRtt(const FaceEndpoint& ingress, pit::Entry& pitEntry);
+
+  /** \return how long the straight-forward path may stay silent before falling back to RV,
+   *          a multiple of the producer's smoothed RTT or the initial RTO without samples
+   */
+  time::nanoseconds
+  getStraightTimeout(const KiteMobileProducerInfo& mpInfo) const;
+
+  void
+  onStraightTimeout(const weak_ptr<pit::Entry>& weakPitEntry);
+
+  KiteMobileProducerInfo*
+  findMpInfo(const Name& mpName);
+
+  void
+  eraseMeasurement(pit::Entry& pitEntry);
+
+  static kite::HandoffReforwarder::Options
+  makeHandoffOptions(const StrategyParameters& params);
+
+  static kite::RouteLifetimeEstimator::Options
+  makeRouteLifetimeOptions(const StrategyParameters& params);
+
+NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /** \brief get the producer record on \p entry, creating and registering it if necessary
+   */
+  KiteMobileProducerInfo&
+  getOrCreateMpInfo(measurements::Entry& entry, const Name& mpName);
 
-  inline void
-  eraseMeasurement(const pit::OutRecord& outRecord, const Name& interestName);
+  /** \brief replace how route updates reach the RIB
+   *
+   *  Tests and benchmarks that run forwarders without a RIB thread use this
+   *  to install KITE routes directly.
+   */
+  void
+  setRibDispatch(kite::RibUpdateCoalescer::Dispatch dispatch)
+  {
+    m_ribUpdates.setDispatch(std::move(dispatch));
+  }
+
+private:
+  kite::KiteMeasurements m_measurements;
+  kite::HandoffReforwarder m_handoff;
+  signal::ScopedConnection m_removeFaceConn;
+  kite::RibUpdateCoalescer m_ribUpdates;
+  shared_ptr<ProducerRegistry> m_producers = make_shared<ProducerRegistry>();
+  RvCounters m_rvCounters;
+  kite::RouteLifetimeEstimator::Options m_routeLifetimeOptions;
+  double m_straightTimeoutMultiplier = 3.0;
+  time::milliseconds m_minStraightTimeout = 20_ms;
 };
 } // namespace fw
 } // namespace nfd
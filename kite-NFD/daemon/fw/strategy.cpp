@@ -318,9 +318,17 @@ Strategy::lookupFib(const pit::Entry& pitEntry) const
   // Forwarding hint should have been stripped by incoming Interest pipeline when reaching producer region
   BOOST_ASSERT(!m_forwarder.getNetworkRegionTable().isInProducerRegion(fh));
 
+  // the KITE delegations were classified when the Interest was decoded
+  size_t nKiteDelegations = interest.getNKiteDelegations();
+  if (nKiteDelegations == fh.size()) {
+    // only KITE delegations, which are not routable by themselves: use the Interest name
+    return fib.findLongestPrefixMatch(pitEntry);
+  }
+
   const fib::Entry* fibEntry = nullptr;
   for (const auto& delegation : fh) {
-    if(!delegation.empty() && (*delegation.begin()) == ndn::kite::KITE_KEYWORD) {
+    // every KITE delegation is skipped, including a lone keyword that yields no KITE hint
+    if (nKiteDelegations > 0 && !delegation.empty() && delegation[0] == ndn::kite::KITE_KEYWORD) {
       continue;
     }
     fibEntry = &fib.findLongestPrefixMatch(delegation);
@@ -337,9 +345,6 @@ Strategy::lookupFib(const pit::Entry& pitEntry) const
     }
     BOOST_ASSERT(fibEntry->getPrefix().empty()); // only ndn:/ FIB entry can have zero nexthop
   }
-  if (fibEntry == nullptr) {
-    fibEntry = &fib.findLongestPrefixMatch(pitEntry);
-  }
   BOOST_ASSERT(fibEntry != nullptr && fibEntry->getPrefix().empty());
   return *fibEntry; // only occurs if no delegation finds a FIB nexthop
 }
@@ -24,7 +24,8 @@
  */
 
 #include "cs-manager.hpp"
-#include "fw/forwarder-counters.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/forwarder-shards.hpp"
 #include "table/cs.hpp"
 
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
@@ -47,29 +48,74 @@ CsManager::CsManager(Cs& cs, const ForwarderCounters& fwCounters,
   registerStatusDatasetHandler("info", std::bind(&CsManager::serveInfo, this, _1, _2, _3));
 }
 
-void
-CsManager::changeConfig(const ControlParameters& parameters,
-                        const ndn::mgmt::CommandContinuation& done)
+static void
+applyConfig(Cs& cs, const ControlParameters& parameters)
 {
   using ndn::nfd::CsFlagBit;
 
   if (parameters.hasCapacity()) {
-    m_cs.setLimit(parameters.getCapacity());
+    cs.setLimit(parameters.getCapacity());
   }
 
   if (parameters.hasFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT)) {
-    m_cs.enableAdmit(parameters.getFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT));
+    cs.enableAdmit(parameters.getFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT));
   }
 
   if (parameters.hasFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE)) {
-    m_cs.enableServe(parameters.getFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE));
+    cs.enableServe(parameters.getFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE));
   }
+}
+
+/** \brief erase up to \p limit entries under \p prefix from \p cs
+ *  \param cb receives the number of erased entries, and whether entries under \p prefix remain
+ *            although \p count allowed erasing them
+ */
+static void
+eraseFromCs(Cs& cs, const Name& prefix, size_t count, size_t limit,
+            const std::function<void(size_t, bool)>& cb)
+{
+  cs.erase(prefix, limit, [&cs, prefix, count, limit, cb] (size_t nErased) {
+    if (nErased == limit && count > limit) {
+      cs.find(Interest(prefix).setCanBePrefix(true),
+              [=] (const Interest&, const Data&) { cb(nErased, true); },
+              [=] (const Interest&) { cb(nErased, false); });
+    }
+    else {
+      cb(nErased, false);
+    }
+  });
+}
+
+struct CsManager::ShardErase
+{
+  Name prefix;
+  size_t count = 0;
+  size_t limit = 0;
+  size_t nErased = 0;
+  bool hasMore = false;
+  std::function<void(size_t, bool)> respond;
+};
+
+void
+CsManager::changeConfig(const ControlParameters& parameters,
+                        const ndn::mgmt::CommandContinuation& done)
+{
+  using ndn::nfd::CsFlagBit;
+
+  applyConfig(m_cs, parameters);
 
   ControlParameters body;
   body.setCapacity(m_cs.getLimit());
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT, m_cs.shouldAdmit(), false);
   body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE, m_cs.shouldServe(), false);
-  done(ControlResponse(200, "OK").setBody(body.wireEncode()));
+  ControlResponse response(200, "OK");
+  response.setBody(body.wireEncode());
+
+  if (m_shards == nullptr) {
+    return done(response);
+  }
+  m_shards->forEachShard([parameters] (Forwarder& forwarder) { applyConfig(forwarder.getCs(), parameters); },
+                         [done, response] { done(response); });
 }
 
 void
@@ -79,25 +125,50 @@ CsManager::erase(const ControlParameters& parameters,
   size_t count = parameters.hasCount() ?
                  parameters.getCount() :
                  std::numeric_limits<size_t>::max();
-  m_cs.erase(parameters.getName(), std::min(count, ERASE_LIMIT),
-    [=] (size_t nErased) {
-      ControlParameters body;
-      body.setName(parameters.getName());
-      body.setCount(nErased);
-      if (nErased == ERASE_LIMIT && count > ERASE_LIMIT) {
-        m_cs.find(Interest(parameters.getName()).setCanBePrefix(true),
-          [=] (const Interest&, const Data&) mutable {
-            body.setCapacity(ERASE_LIMIT);
-            done(ControlResponse(200, "OK").setBody(body.wireEncode()));
-          },
-          [=] (const Interest&) {
-            done(ControlResponse(200, "OK").setBody(body.wireEncode()));
-          });
-      }
-      else {
-        done(ControlResponse(200, "OK").setBody(body.wireEncode()));
-      }
-    });
+  size_t limit = std::min(count, ERASE_LIMIT);
+  Name prefix = parameters.getName();
+
+  auto respond = [done, prefix] (size_t nErased, bool hasMore) {
+    ControlParameters body;
+    body.setName(prefix);
+    body.setCount(nErased);
+    if (hasMore) {
+      body.setCapacity(ERASE_LIMIT);
+    }
+    done(ControlResponse(200, "OK").setBody(body.wireEncode()));
+  };
+
+  if (m_shards == nullptr) {
+    return eraseFromCs(m_cs, prefix, count, limit, respond);
+  }
+
+  // the forwarding threads are visited one after another, so that the limit covers all of them
+  auto op = make_shared<ShardErase>();
+  op->prefix = prefix;
+  op->count = count;
+  op->limit = limit;
+  op->respond = respond;
+  eraseFromShards(op, 0);
+}
+
+void
+CsManager::eraseFromShards(const shared_ptr<ShardErase>& op, size_t index)
+{
+  if (index == m_shards->size() || op->hasMore || op->nErased == op->count) {
+    return op->respond(op->nErased, op->hasMore);
+  }
+
+  // once the limit is reached, the remaining threads are only checked for more entries
+  m_shards->runOnShard(index,
+    [op] (Forwarder& forwarder) {
+      // Cs invokes the callbacks before returning
+      eraseFromCs(forwarder.getCs(), op->prefix, op->count - op->nErased, op->limit - op->nErased,
+                  [op] (size_t nErased, bool hasMore) {
+                    op->nErased += nErased;
+                    op->hasMore = hasMore;
+                  });
+    },
+    [this, op, index] { eraseFromShards(op, index + 1); });
 }
 
 void
@@ -108,9 +179,17 @@ CsManager::serveInfo(const Name& topPrefix, const Interest& interest,
   info.setCapacity(m_cs.getLimit());
   info.setEnableAdmit(m_cs.shouldAdmit());
   info.setEnableServe(m_cs.shouldServe());
-  info.setNEntries(m_cs.size());
-  info.setNHits(m_fwCounters.nCsHits);
-  info.setNMisses(m_fwCounters.nCsMisses);
+  if (m_shards != nullptr) {
+    const auto& shardStatus = m_shards->getStatus();
+    info.setNEntries(shardStatus.nCsEntries);
+    info.setNHits(shardStatus.nCsHits);
+    info.setNMisses(shardStatus.nCsMisses);
+  }
+  else {
+    info.setNEntries(m_cs.size());
+    info.setNHits(m_fwCounters.nCsHits);
+    info.setNMisses(m_fwCounters.nCsMisses);
+  }
 
   context.append(info.wireEncode());
   context.end();
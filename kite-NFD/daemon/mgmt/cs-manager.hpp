@@ -34,6 +34,10 @@ namespace cs {
 class Cs;
 } // namespace cs
 
+namespace fw {
+class ForwarderShards;
+} // namespace fw
+
 class ForwarderCounters;
 
 /**
@@ -46,6 +50,15 @@ public:
   CsManager(cs::Cs& cs, const ForwarderCounters& fwCounters,
             Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /** \brief apply commands to the CS of every forwarding thread of \p shards as well,
+   *         and report their entries and counters instead of those of \p cs
+   */
+  void
+  setForwarderShards(fw::ForwarderShards* shards)
+  {
+    m_shards = shards;
+  }
+
 private:
   /** \brief Process cs/config command.
    */
@@ -59,6 +72,13 @@ private:
   erase(const ControlParameters& parameters,
         const ndn::mgmt::CommandContinuation& done);
 
+  struct ShardErase;
+
+  /** \brief continue a cs/erase command on forwarding thread \p index and the following ones
+   */
+  void
+  eraseFromShards(const shared_ptr<ShardErase>& op, size_t index);
+
   /** \brief Serve CS information dataset.
    */
   void
@@ -71,6 +91,7 @@ public:
 private:
   cs::Cs& m_cs;
   const ForwarderCounters& m_fwCounters;
+  fw::ForwarderShards* m_shards = nullptr;
 };
 
 } // namespace nfd
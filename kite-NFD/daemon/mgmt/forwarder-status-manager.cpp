@@ -25,6 +25,7 @@
 
 #include "forwarder-status-manager.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/forwarder-shards.hpp"
 #include "core/version.hpp"
 
 namespace nfd {
@@ -47,8 +48,27 @@ ForwarderStatusManager::collectGeneralStatus()
   status.setStartTimestamp(m_startTimestamp);
   status.setCurrentTimestamp(time::system_clock::now());
 
-  status.setNNameTreeEntries(m_forwarder.getNameTree().size());
   status.setNFibEntries(m_forwarder.getFib().size());
+
+  if (m_shards != nullptr) {
+    const auto& shardStatus = m_shards->getStatus();
+    status.setNNameTreeEntries(shardStatus.nNameTreeEntries)
+          .setNPitEntries(shardStatus.nPitEntries)
+          .setNMeasurementsEntries(shardStatus.nMeasurementsEntries)
+          .setNCsEntries(shardStatus.nCsEntries)
+          .setNInInterests(shardStatus.nInInterests)
+          .setNOutInterests(shardStatus.nOutInterests)
+          .setNInData(shardStatus.nInData)
+          .setNOutData(shardStatus.nOutData)
+          .setNInNacks(shardStatus.nInNacks)
+          .setNOutNacks(shardStatus.nOutNacks)
+          .setNSatisfiedInterests(shardStatus.nSatisfiedInterests)
+          .setNUnsatisfiedInterests(shardStatus.nUnsatisfiedInterests)
+          .setNameTreeResizePauses(shardStatus.nameTreeResizePauses);
+    return status;
+  }
+
+  status.setNNameTreeEntries(m_forwarder.getNameTree().size());
   status.setNPitEntries(m_forwarder.getPit().size());
   status.setNMeasurementsEntries(m_forwarder.getMeasurements().size());
   status.setNCsEntries(m_forwarder.getCs().size());
@@ -63,6 +83,9 @@ ForwarderStatusManager::collectGeneralStatus()
         .setNSatisfiedInterests(counters.nSatisfiedInterests)
         .setNUnsatisfiedInterests(counters.nUnsatisfiedInterests);
 
+  const auto& pauses = m_forwarder.getNameTree().getResizePauses().getBins();
+  status.setNameTreeResizePauses({pauses.begin(), pauses.end()});
+
   return status;
 }
 
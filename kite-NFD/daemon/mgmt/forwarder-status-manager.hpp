@@ -34,6 +34,10 @@ namespace nfd {
 
 class Forwarder;
 
+namespace fw {
+class ForwarderShards;
+} // namespace fw
+
 /**
  * @brief Implements the Forwarder Status of NFD Management Protocol.
  * @sa https://redmine.named-data.net/projects/nfd/wiki/ForwarderStatus
@@ -43,6 +47,14 @@ class ForwarderStatusManager : noncopyable
 public:
   ForwarderStatusManager(Forwarder& forwarder, Dispatcher& dispatcher);
 
+  /** \brief report the tables and counters of forwarding threads instead of those of \p forwarder
+   */
+  void
+  setForwarderShards(const fw::ForwarderShards* shards)
+  {
+    m_shards = shards;
+  }
+
 private:
   ndn::nfd::ForwarderStatus
   collectGeneralStatus();
@@ -56,6 +68,7 @@ private:
 private:
   Forwarder& m_forwarder;
   Dispatcher& m_dispatcher;
+  const fw::ForwarderShards* m_shards = nullptr;
   time::system_clock::TimePoint m_startTimestamp;
 };
 
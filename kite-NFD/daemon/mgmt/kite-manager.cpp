@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-manager.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/kite-strategy.hpp"
+
+#include <ndn-cxx/mgmt/nfd/kite-producer-status.hpp>
+
+namespace nfd {
+
+constexpr time::milliseconds KiteManager::SNAPSHOT_LIFETIME;
+
+KiteManager::KiteManager(Forwarder& forwarder, Dispatcher& dispatcher)
+  : m_forwarder(forwarder)
+  , m_dispatcher(dispatcher)
+{
+  m_dispatcher.addStatusDataset("kite/list", ndn::mgmt::makeAcceptAllAuthorization(),
+                                std::bind(&KiteManager::listProducers, this, _1, _2, _3));
+}
+
+void
+KiteManager::takeSnapshot()
+{
+  std::vector<ndn::nfd::KiteProducerStatus> producers;
+  for (const auto& choice : m_forwarder.getStrategyChoice()) {
+    auto strategy = dynamic_cast<const fw::KiteStrategy*>(&choice.getStrategy());
+    if (strategy == nullptr) {
+      continue;
+    }
+    for (const auto* mpInfo : strategy->getProducers()) {
+      producers.emplace_back();
+      producers.back().setPrefix(mpInfo->mpName)
+                      .setNPendingInterests(mpInfo->pendingInterests.size())
+                      .setNHandoffs(mpInfo->nHandoffs)
+                      .setNNackFallbacks(mpInfo->nNackFallbacks)
+                      .setNTimeoutFallbacks(mpInfo->nTimeoutFallbacks);
+      if (mpInfo->routeInstallLatency) {
+        producers.back().setRouteInstallLatency(*mpInfo->routeInstallLatency);
+      }
+      if (mpInfo->routeLifetime) {
+        producers.back().setRouteLifetime(*mpInfo->routeLifetime);
+      }
+    }
+  }
+  std::sort(producers.begin(), producers.end(), [] (const auto& a, const auto& b) {
+    return a.getPrefix() < b.getPrefix();
+  });
+
+  m_snapshot.clear();
+  m_snapshot.reserve(producers.size());
+  for (const auto& status : producers) {
+    m_snapshot.push_back(status.wireEncode());
+  }
+  m_snapshotExpiry = time::steady_clock::now() + SNAPSHOT_LIFETIME;
+}
+
+void
+KiteManager::listProducers(const Name&, const Interest&,
+                           ndn::mgmt::StatusDatasetContext& context)
+{
+  if (!m_snapshotExpiry || *m_snapshotExpiry <= time::steady_clock::now()) {
+    this->takeSnapshot();
+  }
+  for (const auto& item : m_snapshot) {
+    context.append(item);
+  }
+  context.end();
+}
+
+} // namespace nfd
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_MGMT_KITE_MANAGER_HPP
+#define NFD_DAEMON_MGMT_KITE_MANAGER_HPP
+
+#include "manager-base.hpp"
+
+namespace nfd {
+
+class Forwarder;
+
+/**
+ * @brief Serves the KITE mobile producer dataset (kite/list).
+ *
+ * The dataset lists every mobile producer known to a KiteStrategy instance. It is served from
+ * a snapshot that is rebuilt at most once per SNAPSHOT_LIFETIME, so that frequent polling does
+ * not cost the forwarding thread more than one pass over the producers per period.
+ */
+class KiteManager : noncopyable
+{
+public:
+  KiteManager(Forwarder& forwarder, Dispatcher& dispatcher);
+
+  static constexpr time::milliseconds SNAPSHOT_LIFETIME = 1_s;
+
+private:
+  void
+  listProducers(const Name& topPrefix, const Interest& interest,
+                ndn::mgmt::StatusDatasetContext& context);
+
+  void
+  takeSnapshot();
+
+private:
+  Forwarder& m_forwarder;
+  Dispatcher& m_dispatcher;
+  std::vector<Block> m_snapshot;
+  optional<time::steady_clock::TimePoint> m_snapshotExpiry;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_MGMT_KITE_MANAGER_HPP
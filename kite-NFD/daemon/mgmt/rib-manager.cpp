@@ -27,6 +27,7 @@
 
 #include "common/global.hpp"
 #include "common/logger.hpp"
+#include "rib/pa-validator-pool.hpp"
 #include "rib/rib.hpp"
 #include "table/fib.hpp"
 
@@ -69,6 +70,8 @@ RibManager::RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
   registerStatusDatasetHandler("list", std::bind(&RibManager::listEntries, this, _1, _2, _3));
 }
 
+RibManager::~RibManager() = default;
+
 void
 RibManager::applyLocalhostConfig(const ConfigSection& section, const std::string& filename)
 {
@@ -92,6 +95,57 @@ void
 RibManager::applyPaConfig(const ConfigSection& section, const std::string& filename)
 {
   m_paValidator.load(section, filename);
+  m_paConfig.emplace(section, filename);
+  // the trust schema may have changed, so earlier validation results are no longer meaningful
+  m_paCache.clear();
+  resetPaValidatorPool();
+}
+
+RibManager::PaProcessingOptions
+RibManager::parsePaProcessingConfig(const ConfigSection& section, const std::string& sectionName)
+{
+  PaProcessingOptions options;
+  for (const auto& item : section) {
+    const std::string& key = item.first;
+    if (key == "cache_lifetime") {
+      options.cache.lifetime = time::seconds(ConfigFile::parseNumber<uint32_t>(item, sectionName));
+    }
+    else if (key == "cache_capacity") {
+      options.cache.capacity = ConfigFile::parseNumber<size_t>(item, sectionName);
+    }
+    else if (key == "validation_threads") {
+      options.nValidationThreads = ConfigFile::parseNumber<size_t>(item, sectionName);
+      ConfigFile::checkRange(options.nValidationThreads, size_t(0), size_t(64), key, sectionName);
+    }
+    else if (key == "optimistic_install") {
+      options.wantOptimisticInstall = ConfigFile::parseYesNo(item, sectionName);
+    }
+    else {
+      NDN_THROW(ConfigFile::Error("Unrecognized option " + sectionName + "." + key));
+    }
+  }
+  return options;
+}
+
+void
+RibManager::applyPaProcessingConfig(const PaProcessingOptions& options)
+{
+  bool needPoolReset = options.nValidationThreads != m_paOptions.nValidationThreads;
+  m_paOptions = options;
+  m_paCache.setOptions(options.cache);
+  if (needPoolReset) {
+    resetPaValidatorPool();
+  }
+}
+
+void
+RibManager::resetPaValidatorPool()
+{
+  m_paValidatorPool.reset();
+  if (m_paOptions.nValidationThreads > 0 && m_paConfig) {
+    m_paValidatorPool = make_unique<rib::PaValidatorPool>(m_paOptions.nValidationThreads,
+                                                          m_paConfig->first, m_paConfig->second);
+  }
 }
 
 void
@@ -359,23 +413,117 @@ RibManager::slAnnounce(const ndn::PrefixAnnouncement& pa, uint64_t faceId,
 {
   BOOST_ASSERT(pa.getData());
 
-  m_paValidator.validate(*pa.getData(),
-    [=] (const Data&) {
-      Route route(pa, faceId);
-      route.expires = std::min(route.annExpires, time::steady_clock::now() + maxLifetime);
-      beginAddRoute(pa.getAnnouncedName(), route, nullopt,
-        [=] (RibUpdateResult ribRes) {
-          auto res = getSlAnnounceResultFromRibUpdateResult(ribRes);
-          NFD_LOG_INFO("slAnnounce " << pa.getAnnouncedName() << " " << faceId << ": " << res);
-          cb(res);
-        });
-    },
-    [=] (const Data&, ndn::security::ValidationError err) {
-      NFD_LOG_INFO("slAnnounce " << pa.getAnnouncedName() << " " << faceId <<
-                   " validation error: " << err);
-      cb(SlAnnounceResult::VALIDATION_FAILURE);
+  if (m_paCache.find(pa)) {
+    NFD_LOG_DEBUG("slAnnounce " << pa.getAnnouncedName() << " " << faceId << ": validated earlier");
+    return slInstall(pa, faceId, maxLifetime, cb);
+  }
+
+  auto onFailure = [=] (const ndn::security::ValidationError& err) {
+    NFD_LOG_INFO("slAnnounce " << pa.getAnnouncedName() << " " << faceId <<
+                 " validation error: " << err);
+  };
+
+  if (!m_paOptions.wantOptimisticInstall) {
+    return validatePa(pa,
+      [=] { slInstall(pa, faceId, maxLifetime, cb); },
+      [=] (const ndn::security::ValidationError& err) {
+        onFailure(err);
+        cb(SlAnnounceResult::VALIDATION_FAILURE);
+      });
+  }
+
+  struct OptimisticState
+  {
+    bool isInstalled = false;
+    bool isRejected = false;
+  };
+  auto state = make_shared<OptimisticState>();
+
+  slInstall(pa, faceId, maxLifetime, [=] (SlAnnounceResult res) {
+    if (res != SlAnnounceResult::OK) {
+      return cb(res);
     }
-  );
+    state->isInstalled = true;
+    if (state->isRejected) {
+      slRollback(pa, faceId);
+      return cb(SlAnnounceResult::VALIDATION_FAILURE);
+    }
+    cb(res);
+  });
+
+  validatePa(pa, [] {},
+    [=] (const ndn::security::ValidationError& err) {
+      onFailure(err);
+      state->isRejected = true;
+      if (state->isInstalled) {
+        slRollback(pa, faceId);
+      }
+    });
+}
+
+void
+RibManager::validatePa(const ndn::PrefixAnnouncement& pa, const std::function<void()>& onSuccess,
+                       const std::function<void(const ndn::security::ValidationError&)>& onFailure)
+{
+  auto validateHere = [=] {
+    m_paValidator.validate(*pa.getData(),
+      [=] (const Data&) {
+        m_paCache.insert(pa);
+        onSuccess();
+      },
+      [=] (const Data&, const ndn::security::ValidationError& err) { onFailure(err); });
+  };
+
+  if (m_paValidatorPool == nullptr) {
+    return validateHere();
+  }
+
+  m_paValidatorPool->validate(*pa.getData(),
+    [=] {
+      m_paCache.insert(pa);
+      onSuccess();
+    },
+    [=] (const ndn::security::ValidationError& err) {
+      if (err.getCode() != ndn::security::ValidationError::CANNOT_RETRIEVE_CERT) {
+        return onFailure(err);
+      }
+      // workers cannot fetch certificates, but the validator on this thread can
+      NFD_LOG_DEBUG("slAnnounce " << pa.getAnnouncedName() << ": retrying with certificate fetching");
+      validateHere();
+    });
+}
+
+void
+RibManager::slInstall(const ndn::PrefixAnnouncement& pa, uint64_t faceId,
+                      time::milliseconds maxLifetime, const SlAnnounceCallback& cb)
+{
+  Route route(pa, faceId);
+  route.expires = std::min(route.annExpires, time::steady_clock::now() + maxLifetime);
+  beginAddRoute(pa.getAnnouncedName(), route, nullopt,
+    [=] (RibUpdateResult ribRes) {
+      auto res = getSlAnnounceResultFromRibUpdateResult(ribRes);
+      NFD_LOG_INFO("slAnnounce " << pa.getAnnouncedName() << " " << faceId << ": " << res);
+      cb(res);
+    });
+}
+
+void
+RibManager::slRollback(const ndn::PrefixAnnouncement& pa, uint64_t faceId)
+{
+  Route routeQuery;
+  routeQuery.faceId = faceId;
+  routeQuery.origin = ndn::nfd::ROUTE_ORIGIN_PREFIXANN;
+  Route* route = m_rib.find(pa.getAnnouncedName(), routeQuery);
+  if (route == nullptr || !route->announcement || route->announcement->getData() != pa.getData()) {
+    NFD_LOG_DEBUG("slRollback " << pa.getAnnouncedName() << " " << faceId << ": not found");
+    return;
+  }
+
+  beginRemoveRoute(pa.getAnnouncedName(), *route,
+    [=] (RibUpdateResult ribRes) {
+      NFD_LOG_INFO("slRollback " << pa.getAnnouncedName() << " " << faceId << ": " <<
+                   getSlAnnounceResultFromRibUpdateResult(ribRes));
+    });
 }
 
 void
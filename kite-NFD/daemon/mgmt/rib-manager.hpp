@@ -27,6 +27,7 @@
 #define NFD_DAEMON_MGMT_RIB_MANAGER_HPP
 
 #include "manager-base.hpp"
+#include "rib/pa-validation-cache.hpp"
 #include "rib/route.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
@@ -38,6 +39,7 @@
 namespace nfd {
 
 namespace rib {
+class PaValidatorPool;
 class Rib;
 class RibUpdate;
 } // namespace rib
@@ -52,6 +54,8 @@ public:
   RibManager(rib::Rib& rib, ndn::Face& face, ndn::KeyChain& keyChain,
              ndn::nfd::Controller& nfdController, Dispatcher& dispatcher);
 
+  ~RibManager() final;
+
   /**
    * @brief Apply localhost_security configuration.
    */
@@ -77,6 +81,49 @@ public:
   void
   applyPaConfig(const ConfigSection& section, const std::string& filename);
 
+  /** \brief Options of prefix announcement processing in slAnnounce.
+   */
+  struct PaProcessingOptions
+  {
+    PaProcessingOptions() noexcept
+    {
+    }
+
+    /** \brief Reuse of successful validation results.
+     */
+    rib::PaValidationCache::Options cache;
+
+    /** \brief Number of worker threads that validate prefix announcements.
+     *
+     *  If zero, prefix announcements are validated on the RIB thread.
+     */
+    size_t nValidationThreads = 0;
+
+    /** \brief Whether to install the route before validation completes.
+     *
+     *  If true, the route is installed immediately and removed again if the prefix announcement
+     *  turns out to be invalid.
+     */
+    bool wantOptimisticInstall = false;
+  };
+
+  /** \brief Parse prefix_announcement_processing configuration.
+   *  \throw ConfigFile::Error the configuration is invalid
+   */
+  static PaProcessingOptions
+  parsePaProcessingConfig(const ConfigSection& section, const std::string& sectionName);
+
+  /** \brief Apply prefix_announcement_processing configuration.
+   */
+  void
+  applyPaProcessingConfig(const PaProcessingOptions& options);
+
+  const rib::PaValidationCache&
+  getPaValidationCache() const
+  {
+    return m_paCache;
+  }
+
   /**
    * @brief Start accepting commands and dataset requests.
    */
@@ -115,6 +162,12 @@ public: // self-learning support
    *  or the relevant config has not been loaded via \c enableLocalHop, invokes \p cb with
    *  SlAnnounceResult::VALIDATION_FAILURE.
    *
+   *  A prefix announcement whose Data has passed validation recently is not validated again.
+   *  If PaProcessingOptions::wantOptimisticInstall is set, the route is inserted while validation
+   *  is in progress, and is removed if validation fails; \p cb is invoked with
+   *  SlAnnounceResult::VALIDATION_FAILURE if the failure is known by the time the route is
+   *  inserted, otherwise with the result of inserting the route.
+   *
    *  Self-learning strategy invokes this method after receiving a Data carrying a prefix
    *  announcement.
    */
@@ -158,6 +211,29 @@ public: // self-learning support
   void
   slFindAnn(const Name& name, const SlFindAnnCallback& cb) const;
 
+private: // self-learning support
+  /** \brief Validate the Data of \p pa, using the cache and the worker pool when available.
+   */
+  void
+  validatePa(const ndn::PrefixAnnouncement& pa, const std::function<void()>& onSuccess,
+             const std::function<void(const ndn::security::ValidationError&)>& onFailure);
+
+  /** \brief Insert a route for a prefix announcement that is (assumed to be) valid.
+   */
+  void
+  slInstall(const ndn::PrefixAnnouncement& pa, uint64_t faceId, time::milliseconds maxLifetime,
+            const SlAnnounceCallback& cb);
+
+  /** \brief Remove a route inserted by an optimistic slAnnounce whose validation failed.
+   *
+   *  Nothing is removed if the route has since been replaced by another prefix announcement.
+   */
+  void
+  slRollback(const ndn::PrefixAnnouncement& pa, uint64_t faceId);
+
+  void
+  resetPaValidatorPool();
+
 private: // RIB and FibUpdater actions
   enum class RibUpdateResult
   {
@@ -254,6 +330,11 @@ private:
   ndn::ValidatorConfig m_paValidator;
   bool m_isLocalhopEnabled;
 
+  optional<std::pair<ConfigSection, std::string>> m_paConfig;
+  PaProcessingOptions m_paOptions;
+  rib::PaValidationCache m_paCache;
+  unique_ptr<rib::PaValidatorPool> m_paValidatorPool;
+
   scheduler::ScopedEventId m_activeFaceFetchEvent;
 };
 
@@ -26,6 +26,7 @@
 #include "strategy-choice-manager.hpp"
 
 #include "common/logger.hpp"
+#include "fw/forwarder-shards.hpp"
 #include "table/strategy-choice.hpp"
 
 #include <ndn-cxx/mgmt/nfd/strategy-choice.hpp>
@@ -56,6 +57,11 @@ StrategyChoiceManager::setStrategy(ControlParameters parameters,
   const Name& prefix = parameters.getName();
   const Name& strategy = parameters.getStrategy();
 
+  if (m_shards != nullptr && !fw::ForwarderShards::canRunStrategy(strategy)) {
+    NFD_LOG_DEBUG("strategy-choice/set(" << prefix << "," << strategy << "): not on forwarding threads");
+    return done(ControlResponse(409, "Strategy cannot run on forwarding threads"));
+  }
+
   StrategyChoice::InsertResult res = m_table.insert(prefix, strategy);
   if (!res) {
     NFD_LOG_DEBUG("strategy-choice/set(" << prefix << "," << strategy << "): cannot-create " << res);
@@ -30,6 +30,10 @@
 
 namespace nfd {
 
+namespace fw {
+class ForwarderShards;
+} // namespace fw
+
 namespace strategy_choice {
 class StrategyChoice;
 } // namespace strategy_choice
@@ -44,6 +48,14 @@ public:
   StrategyChoiceManager(strategy_choice::StrategyChoice& table,
                         Dispatcher& dispatcher, CommandAuthenticator& authenticator);
 
+  /** \brief refuse strategies that cannot run on the forwarding threads of \p shards
+   */
+  void
+  setForwarderShards(const fw::ForwarderShards* shards)
+  {
+    m_shards = shards;
+  }
+
 private:
   void
   setStrategy(ControlParameters parameters,
@@ -58,6 +70,7 @@ private:
 
 private:
   strategy_choice::StrategyChoice& m_table;
+  const fw::ForwarderShards* m_shards = nullptr;
 };
 
 } // namespace nfd
@@ -90,6 +90,18 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
     unsolicitedDataPolicy = make_unique<fw::DefaultUnsolicitedDataPolicy>();
   }
 
+  auto nameTreeLayout = name_tree::HashtableLayout::CHAINED;
+  OptionalConfigSection nameTreeLayoutNode = section.get_child_optional("name_tree_hashtable");
+  if (nameTreeLayoutNode) {
+    std::string layoutName = nameTreeLayoutNode->get_value<std::string>();
+    if (layoutName == "open-addressing") {
+      nameTreeLayout = name_tree::HashtableLayout::OPEN_ADDRESSING;
+    }
+    else if (layoutName != "chained") {
+      NDN_THROW(ConfigFile::Error("Unknown name_tree_hashtable '" + layoutName + "' in section 'tables'"));
+    }
+  }
+
   OptionalConfigSection strategyChoiceSection = section.get_child_optional("strategy_choice");
   if (strategyChoiceSection) {
     processStrategyChoiceSection(*strategyChoiceSection, isDryRun);
@@ -112,6 +124,8 @@ TablesConfigSection::processConfig(const ConfigSection& section, bool isDryRun,
 
   m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+  m_forwarder.getNameTree().setHashtableLayout(nameTreeLayout);
+
   m_isConfigured = true;
 }
 
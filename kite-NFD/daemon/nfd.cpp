@@ -32,11 +32,13 @@
 #include "face/null-face.hpp"
 #include "fw/face-table.hpp"
 #include "fw/forwarder.hpp"
+#include "fw/forwarder-shards.hpp"
 #include "mgmt/cs-manager.hpp"
 #include "mgmt/face-manager.hpp"
 #include "mgmt/fib-manager.hpp"
 #include "mgmt/forwarder-status-manager.hpp"
 #include "mgmt/general-config-section.hpp"
+#include "mgmt/kite-manager.hpp"
 #include "mgmt/log-config-section.hpp"
 #include "mgmt/strategy-choice-manager.hpp"
 #include "mgmt/tables-config-section.hpp"
@@ -82,10 +84,33 @@ Nfd::initialize()
   m_faceTable->addReserved(face::makeNullFace(FaceUri("contentstore://")), face::FACEID_CONTENT_STORE);
 
   m_faceSystem = make_unique<face::FaceSystem>(*m_faceTable, m_netmon);
-  m_forwarder = make_unique<Forwarder>(*m_faceTable);
+
+  // the number of forwarding threads is needed before anything is attached to the forwarder
+  ConfigSection forwarderSection;
+  ConfigSection tablesSection;
+  readForwardingSections(forwarderSection, tablesSection);
+  auto shardsOptions = fw::ForwarderShards::parseConfig(forwarderSection, tablesSection);
+
+  if (shardsOptions.nShards > 0) {
+    // management and the RIB update this forwarder, whose FIB and StrategyChoice are
+    // replicated to the forwarders on the forwarding threads
+    m_controlFaceTable = make_unique<FaceTable>();
+    m_forwarder = make_unique<Forwarder>(*m_controlFaceTable);
+  }
+  else {
+    m_forwarder = make_unique<Forwarder>(*m_faceTable);
+  }
 
   initializeManagement();
 
+  if (shardsOptions.nShards > 0) {
+    m_shards = make_unique<fw::ForwarderShards>(*m_forwarder, *m_faceTable, shardsOptions,
+                                                [this] (Forwarder& fw) { configureForwarderShard(fw); });
+    m_forwarderStatusManager->setForwarderShards(m_shards.get());
+    m_csManager->setForwarderShards(m_shards.get());
+    m_strategyChoiceManager->setForwarderShards(m_shards.get());
+  }
+
   PrivilegeHelper::drop();
 
   m_netmon->onNetworkStateChanged.connect([this] {
@@ -146,6 +171,7 @@ Nfd::initializeManagement()
                                        *m_dispatcher, *m_authenticator);
   m_strategyChoiceManager = make_unique<StrategyChoiceManager>(m_forwarder->getStrategyChoice(),
                                                                *m_dispatcher, *m_authenticator);
+  m_kiteManager = make_unique<KiteManager>(*m_forwarder, *m_dispatcher);
 
   ConfigFile config(&ignoreRibAndLogSections);
   general::setConfigFile(config);
@@ -182,6 +208,14 @@ Nfd::reloadConfigFile()
 {
   configureLogging();
 
+  if (m_shards != nullptr) {
+    // reject strategies that cannot run on the forwarding threads before anything is applied
+    ConfigSection forwarderSection;
+    ConfigSection tablesSection;
+    readForwardingSections(forwarderSection, tablesSection);
+    fw::ForwarderShards::checkStrategyChoices(tablesSection);
+  }
+
   ConfigFile config(&ignoreRibAndLogSections);
   general::setConfigFile(config);
 
@@ -199,6 +233,10 @@ Nfd::reloadConfigFile()
   else {
     config.parse(m_configSection, false, INTERNAL_CONFIG);
   }
+
+  if (m_shards != nullptr) {
+    m_shards->reconfigure();
+  }
 }
 
 void
@@ -216,4 +254,44 @@ Nfd::reloadConfigFileFaceSection()
   }
 }
 
+void
+Nfd::readForwardingSections(ConfigSection& forwarderSection, ConfigSection& tablesSection) const
+{
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  config.addSectionHandler("forwarder", [&forwarderSection] (const ConfigSection& section, bool,
+                                                             const std::string&) {
+    forwarderSection = section;
+  });
+  config.addSectionHandler("tables", [&tablesSection] (const ConfigSection& section, bool,
+                                                       const std::string&) {
+    tablesSection = section;
+  });
+  if (!m_configFile.empty()) {
+    config.parse(m_configFile, true);
+  }
+  else {
+    config.parse(m_configSection, true, INTERNAL_CONFIG);
+  }
+}
+
+void
+Nfd::configureForwarderShard(Forwarder& forwarder)
+{
+  // invoked on a forwarding thread; the configuration has already been validated on the main thread
+  ConfigFile config(&ConfigFile::ignoreUnknownSection);
+  forwarder.setConfigFile(config);
+
+  TablesConfigSection tablesConfig(forwarder);
+  tablesConfig.setConfigFile(config);
+
+  if (!m_configFile.empty()) {
+    config.parse(m_configFile, false);
+  }
+  else {
+    config.parse(m_configSection, false, INTERNAL_CONFIG);
+  }
+
+  tablesConfig.ensureConfigured();
+}
+
 } // namespace nfd
@@ -44,12 +44,17 @@ class FaceManager;
 class FibManager;
 class CsManager;
 class StrategyChoiceManager;
+class KiteManager;
 
 namespace face {
 class Face;
 class FaceSystem;
 } // namespace face
 
+namespace fw {
+class ForwarderShards;
+} // namespace fw
+
 /**
  * \brief Class representing the NFD instance.
  *
@@ -106,12 +111,24 @@ private:
   void
   reloadConfigFileFaceSection();
 
+  /** \brief read the forwarder and tables sections of the configuration, without applying them
+   */
+  void
+  readForwardingSections(ConfigSection& forwarderSection, ConfigSection& tablesSection) const;
+
+  /** \brief apply the forwarder and tables sections to the Forwarder of a forwarding thread
+   */
+  void
+  configureForwarderShard(Forwarder& forwarder);
+
 private:
   std::string m_configFile;
   ConfigSection m_configSection;
 
   unique_ptr<FaceTable> m_faceTable;
   unique_ptr<face::FaceSystem> m_faceSystem;
+  /// faces of m_forwarder when forwarding is done by m_shards, always empty
+  unique_ptr<FaceTable> m_controlFaceTable;
   unique_ptr<Forwarder> m_forwarder;
 
   ndn::KeyChain& m_keyChain;
@@ -124,9 +141,13 @@ private:
   unique_ptr<FibManager> m_fibManager;
   unique_ptr<CsManager> m_csManager;
   unique_ptr<StrategyChoiceManager> m_strategyChoiceManager;
+  unique_ptr<KiteManager> m_kiteManager;
 
   shared_ptr<ndn::net::NetworkMonitor> m_netmon;
   scheduler::ScopedEventId m_reloadConfigEvent;
+
+  // declared last, so that the forwarding threads stop before the rest is destroyed
+  unique_ptr<fw::ForwarderShards> m_shards;
 };
 
 } // namespace nfd
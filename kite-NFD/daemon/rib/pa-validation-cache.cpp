@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pa-validation-cache.hpp"
+
+namespace nfd {
+namespace rib {
+
+PaValidationCache::PaValidationCache(const Options& options)
+  : m_options(options)
+{
+}
+
+void
+PaValidationCache::setOptions(const Options& options)
+{
+  m_options = options;
+  clear();
+}
+
+optional<PaValidationCache::Key>
+PaValidationCache::makeKey(const Data& paData)
+{
+  auto kl = paData.getKeyLocator();
+  if (!kl || kl->getType() != tlv::Name) {
+    return nullopt;
+  }
+  return Key(paData.getFullName().get(-1), kl->getName());
+}
+
+bool
+PaValidationCache::find(const ndn::PrefixAnnouncement& pa)
+{
+  BOOST_ASSERT(pa.getData());
+
+  auto key = makeKey(*pa.getData());
+  auto it = key ? m_entries.find(*key) : m_entries.end();
+  if (it == m_entries.end()) {
+    ++m_nMisses;
+    return false;
+  }
+
+  if (it->second.expiry <= time::steady_clock::now()) {
+    erase(it);
+    ++m_nMisses;
+    return false;
+  }
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+  ++m_nHits;
+  return true;
+}
+
+void
+PaValidationCache::insert(const ndn::PrefixAnnouncement& pa)
+{
+  BOOST_ASSERT(pa.getData());
+
+  if (m_options.lifetime <= 0_ns || m_options.capacity == 0) {
+    return;
+  }
+
+  auto key = makeKey(*pa.getData());
+  if (!key) {
+    return;
+  }
+
+  auto lifetime = m_options.lifetime;
+  if (pa.getValidityPeriod()) {
+    lifetime = std::min(lifetime, time::nanoseconds(pa.getValidityPeriod()->getPeriod().second -
+                                                    time::system_clock::now()));
+  }
+  if (lifetime <= 0_ns) {
+    return;
+  }
+
+  auto it = m_entries.find(*key);
+  if (it != m_entries.end()) {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+  }
+  else {
+    while (m_entries.size() >= m_options.capacity) {
+      erase(m_entries.find(m_lru.back()));
+    }
+    m_lru.push_front(*key);
+    it = m_entries.emplace(*key, Entry{{}, m_lru.begin()}).first;
+  }
+  it->second.expiry = time::steady_clock::now() + lifetime;
+}
+
+void
+PaValidationCache::erase(Table::iterator it)
+{
+  m_lru.erase(it->second.lruPos);
+  m_entries.erase(it);
+}
+
+void
+PaValidationCache::clear()
+{
+  m_entries.clear();
+  m_lru.clear();
+}
+
+} // namespace rib
+} // namespace nfd
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_RIB_PA_VALIDATION_CACHE_HPP
+#define NFD_DAEMON_RIB_PA_VALIDATION_CACHE_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/prefix-announcement.hpp>
+
+#include <list>
+#include <map>
+
+namespace nfd {
+namespace rib {
+
+/** \brief Remembers prefix announcements that have passed validation.
+ *
+ *  An entry is keyed by the implicit digest of the prefix announcement Data and the KeyLocator
+ *  name of its signer, so that a refresh or a re-announcement carrying the very same Data is
+ *  accepted without evaluating the trust schema and verifying the signature again.
+ *  Only successful validations are cached. An entry is usable until the earlier of the
+ *  configured lifetime and the end of the announcement's ValidityPeriod, and the least recently
+ *  used entry is evicted when the cache is full.
+ */
+class PaValidationCache : noncopyable
+{
+public:
+  struct Options
+  {
+    Options() noexcept
+    {
+    }
+
+    /** \brief Maximum time a validation result is reused; zero disables the cache.
+     */
+    time::nanoseconds lifetime = 60_s;
+
+    /** \brief Maximum number of entries.
+     */
+    size_t capacity = 4096;
+  };
+
+  explicit
+  PaValidationCache(const Options& options = {});
+
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  /** \brief Change the options; existing entries are erased.
+   */
+  void
+  setOptions(const Options& options);
+
+  /** \brief Determine whether the Data of \p pa has passed validation recently.
+   *  \pre pa.getData() is not nullopt
+   */
+  bool
+  find(const ndn::PrefixAnnouncement& pa);
+
+  /** \brief Record that the Data of \p pa has passed validation.
+   *  \pre pa.getData() is not nullopt
+   */
+  void
+  insert(const ndn::PrefixAnnouncement& pa);
+
+  /** \brief Erase all entries, e.g., after the trust schema is changed.
+   */
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+private:
+  using Key = std::pair<name::Component, Name>;
+
+  struct Entry
+  {
+    time::steady_clock::time_point expiry;
+    std::list<Key>::iterator lruPos;
+  };
+
+  using Table = std::map<Key, Entry>;
+
+  static optional<Key>
+  makeKey(const Data& paData);
+
+  void
+  erase(Table::iterator it);
+
+private:
+  Options m_options;
+  Table m_entries;
+  std::list<Key> m_lru; ///< most recently used at front
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+};
+
+} // namespace rib
+} // namespace nfd
+
+#endif // NFD_DAEMON_RIB_PA_VALIDATION_CACHE_HPP
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pa-validator-pool.hpp"
+#include "common/global.hpp"
+#include "common/logger.hpp"
+
+#include <ndn-cxx/security/certificate-fetcher-offline.hpp>
+#include <ndn-cxx/security/validator-config.hpp>
+
+namespace nfd {
+namespace rib {
+
+NFD_LOG_INIT(PaValidatorPool);
+
+class PaValidatorPool::Worker : noncopyable
+{
+public:
+  Worker(const ConfigSection& section, const std::string& filename)
+    : m_work(make_unique<boost::asio::io_service::work>(m_io))
+    , m_validator(make_unique<ndn::security::CertificateFetcherOffline>())
+  {
+    m_validator.load(section, filename);
+    m_thread = std::thread([this] { m_io.run(); });
+  }
+
+  ~Worker()
+  {
+    // let queued validations finish so that every request gets its callback
+    m_work.reset();
+    m_thread.join();
+  }
+
+  void
+  validate(const Block& wire, boost::asio::io_service& resultIo,
+           const SuccessCallback& onSuccess, const FailureCallback& onFailure)
+  {
+    m_io.post([=, &resultIo] {
+      // decode a private copy, so that no lazily computed field is shared across threads
+      Data data(wire);
+      m_validator.validate(data,
+        [=, &resultIo] (const Data&) {
+          resultIo.post(onSuccess);
+        },
+        [=, &resultIo] (const Data&, const ndn::security::ValidationError& err) {
+          resultIo.post([=] { onFailure(err); });
+        });
+    });
+  }
+
+private:
+  boost::asio::io_service m_io;
+  unique_ptr<boost::asio::io_service::work> m_work;
+  ndn::ValidatorConfig m_validator;
+  std::thread m_thread;
+};
+
+PaValidatorPool::PaValidatorPool(size_t nThreads, const ConfigSection& section,
+                                 const std::string& filename)
+  : m_resultIo(getGlobalIoService())
+{
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_workers.push_back(make_unique<Worker>(section, filename));
+  }
+  NFD_LOG_DEBUG("Started " << nThreads << " prefix announcement validation threads");
+}
+
+PaValidatorPool::~PaValidatorPool() = default;
+
+void
+PaValidatorPool::validate(const Data& paData, const SuccessCallback& onSuccess,
+                          const FailureCallback& onFailure)
+{
+  BOOST_ASSERT(!m_workers.empty());
+  weak_ptr<int> alive = m_alive;
+  m_workers[m_next]->validate(paData.wireEncode(), m_resultIo,
+    [=] {
+      if (!alive.expired()) {
+        onSuccess();
+      }
+    },
+    [=] (const ndn::security::ValidationError& err) {
+      if (!alive.expired()) {
+        onFailure(err);
+      }
+    });
+  m_next = (m_next + 1) % m_workers.size();
+}
+
+} // namespace rib
+} // namespace nfd
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_RIB_PA_VALIDATOR_POOL_HPP
+#define NFD_DAEMON_RIB_PA_VALIDATOR_POOL_HPP
+
+#include "core/common.hpp"
+#include "common/config-file.hpp"
+
+#include <ndn-cxx/security/validation-error.hpp>
+
+#include <boost/asio/io_service.hpp>
+
+#include <thread>
+
+namespace nfd {
+namespace rib {
+
+/** \brief Validates prefix announcements on worker threads.
+ *
+ *  Each worker owns a ValidatorConfig loaded from the same prefix_announcement_validation
+ *  section as the RIB thread's validator, but with an offline certificate fetcher: it can
+ *  verify announcements whose signing chain ends at a configured trust anchor, and fails with
+ *  ValidationError::CANNOT_RETRIEVE_CERT when a certificate would have to be retrieved from the
+ *  network. The caller is expected to fall back to its own validator in that case.
+ *
+ *  Completion callbacks are posted to the io_service of the thread that constructed the pool.
+ *  They are not invoked if the pool has been destroyed in the meantime.
+ */
+class PaValidatorPool : noncopyable
+{
+public:
+  using SuccessCallback = std::function<void()>;
+  using FailureCallback = std::function<void(const ndn::security::ValidationError&)>;
+
+  /** \brief Start \p nThreads workers.
+   *  \throw ndn::security::validator_config::Error \p section is not a valid validator configuration
+   */
+  PaValidatorPool(size_t nThreads, const ConfigSection& section, const std::string& filename);
+
+  ~PaValidatorPool();
+
+  size_t
+  size() const
+  {
+    return m_workers.size();
+  }
+
+  /** \brief Validate \p paData on one of the workers.
+   */
+  void
+  validate(const Data& paData, const SuccessCallback& onSuccess, const FailureCallback& onFailure);
+
+private:
+  class Worker;
+
+  boost::asio::io_service& m_resultIo;
+  shared_ptr<int> m_alive = make_shared<int>();
+  std::vector<unique_ptr<Worker>> m_workers;
+  size_t m_next = 0;
+};
+
+} // namespace rib
+} // namespace nfd
+
+#endif // NFD_DAEMON_RIB_PA_VALIDATOR_POOL_HPP
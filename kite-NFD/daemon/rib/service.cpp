@@ -49,6 +49,7 @@ const std::string CFG_RIB = "rib";
 const std::string CFG_LOCALHOST_SECURITY = "localhost_security";
 const std::string CFG_LOCALHOP_SECURITY = "localhop_security";
 const std::string CFG_PA_VALIDATION = "prefix_announcement_validation";
+const std::string CFG_PA_PROCESSING = "prefix_announcement_processing";
 const std::string CFG_PREFIX_PROPAGATE = "auto_prefix_propagate";
 const std::string CFG_READVERTISE_NLSR = "readvertise_nlsr";
 const Name READVERTISE_NLSR_PREFIX = "/localhost/nlsr";
@@ -129,8 +130,15 @@ Service::Service(ndn::KeyChain& keyChain, shared_ptr<ndn::Transport> localNfdTra
   config.addSectionHandler(CFG_RIB, [this] (auto&&... args) {
     processConfig(std::forward<decltype(args)>(args)...);
   });
-  configParse(config, true);
-  configParse(config, false);
+  try {
+    configParse(config, true);
+    configParse(config, false);
+  }
+  catch (...) {
+    // the destructor does not run when the constructor throws
+    s_instance = nullptr;
+    throw;
+  }
 
   m_ribManager.registerWithNfd();
   m_ribManager.enableLocalFields();
@@ -182,6 +190,9 @@ Service::checkConfig(const ConfigSection& section, const std::string& filename)
       ndn::ValidatorConfig testValidator(m_face);
       testValidator.load(value, filename);
     }
+    else if (key == CFG_PA_PROCESSING) {
+      RibManager::parsePaProcessingConfig(value, CFG_RIB + "." + CFG_PA_PROCESSING);
+    }
     else if (key == CFG_PREFIX_PROPAGATE) {
       hasPropagate = true;
       // AutoPrefixPropagator does not support config dry-run
@@ -205,6 +216,7 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
 {
   bool wantPrefixPropagate = false;
   bool wantReadvertiseNlsr = false;
+  RibManager::PaProcessingOptions paOptions;
 
   for (const auto& item : section) {
     const std::string& key = item.first;
@@ -218,6 +230,9 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     else if (key == CFG_PA_VALIDATION) {
       m_ribManager.applyPaConfig(value, filename);
     }
+    else if (key == CFG_PA_PROCESSING) {
+      paOptions = RibManager::parsePaProcessingConfig(value, CFG_RIB + "." + CFG_PA_PROCESSING);
+    }
     else if (key == CFG_PREFIX_PROPAGATE) {
       wantPrefixPropagate = true;
 
@@ -248,6 +263,8 @@ Service::applyConfig(const ConfigSection& section, const std::string& filename)
     }
   }
 
+  m_ribManager.applyPaProcessingConfig(paOptions);
+
   if (!wantPrefixPropagate && m_readvertisePropagation != nullptr) {
     NFD_LOG_DEBUG("Disabling automatic prefix propagation");
     m_readvertisePropagation.reset();
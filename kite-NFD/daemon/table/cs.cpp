@@ -80,6 +80,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    m_nameIndex.emplace(name_tree::computeHash(data.getName()), it);
     m_policy->afterInsert(it);
   }
 }
@@ -104,7 +105,7 @@ Cs::eraseImpl(const Name& prefix, size_t limit)
   size_t nErased = 0;
   while (i != last && nErased < limit) {
     m_policy->beforeErase(i);
-    i = m_table.erase(i);
+    i = eraseEntry(i);
     ++nErased;
   }
   return nErased;
@@ -118,11 +119,20 @@ Cs::findImpl(const Interest& interest) const
   }
 
   const Name& prefix = interest.getName();
-  auto range = findPrefixRange(prefix);
-  auto match = std::find_if(range.first, range.second,
-                            [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+  const_iterator match = m_table.end();
+  if (interest.getCanBePrefix()) {
+    auto range = findPrefixRange(prefix);
+    match = std::find_if(range.first, range.second,
+                         [&interest] (const auto& entry) { return entry.canSatisfy(interest); });
+    if (match == range.second) {
+      match = m_table.end();
+    }
+  }
+  else {
+    match = findExactMatch(interest);
+  }
 
-  if (match == range.second) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("find " << prefix << " no-match");
     return m_table.end();
   }
@@ -131,6 +141,39 @@ Cs::findImpl(const Interest& interest) const
   return match;
 }
 
+Cs::const_iterator
+Cs::findExactMatch(const Interest& interest) const
+{
+  // Interest name equals either the Data name, or the full name if it ends with a digest
+  const Name& name = interest.getName();
+  const_iterator best = m_table.end();
+  auto findIn = [&] (size_t prefixLen) {
+    auto range = m_nameIndex.equal_range(name_tree::computeHash(name, prefixLen));
+    for (auto i = range.first; i != range.second; ++i) {
+      if (i->second->canSatisfy(interest) && (best == m_table.end() || i->second < best)) {
+        best = i->second;
+      }
+    }
+  };
+
+  findIn(name.size());
+  if (!name.empty() && name[-1].isImplicitSha256Digest()) {
+    findIn(name.size() - 1);
+  }
+  return best;
+}
+
+Cs::const_iterator
+Cs::eraseEntry(const_iterator it)
+{
+  auto range = m_nameIndex.equal_range(name_tree::computeHash(it->getName()));
+  auto indexed = std::find_if(range.first, range.second,
+                              [it] (const auto& indexEntry) { return indexEntry.second == it; });
+  BOOST_ASSERT(indexed != range.second);
+  m_nameIndex.erase(indexed);
+  return m_table.erase(it);
+}
+
 void
 Cs::dump()
 {
@@ -155,7 +198,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
 {
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { m_table.erase(it); });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (auto it) { eraseEntry(it); });
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
@@ -27,6 +27,9 @@
 #define NFD_DAEMON_TABLE_CS_HPP
 
 #include "cs-policy.hpp"
+#include "name-tree-hashtable.hpp"
+
+#include <unordered_map>
 
 namespace nfd {
 namespace cs {
@@ -38,6 +41,8 @@ namespace cs {
  *  The Table is a container ( \c std::set ) sorted by full Names of stored Data packets.
  *  Data packets are wrapped in Entry objects. Each Entry contains the Data packet itself,
  *  and a few additional attributes such as when the Data becomes non-fresh.
+ *  Interests with CanBePrefix=false are looked up in a hash index of the Data names instead;
+ *  the Table is searched only for prefix matches and erasures.
  *
  *  The replacement policy is implemented in a subclass of \c Policy.
  */
@@ -182,6 +187,17 @@ private:
   const_iterator
   findImpl(const Interest& interest) const;
 
+  /** \brief finds the best matching Data for an Interest with CanBePrefix=false
+   *  \return the first matching entry in Table order, or end() if none
+   */
+  const_iterator
+  findExactMatch(const Interest& interest) const;
+
+  /** \brief erases an entry from the Table and the name index
+   */
+  const_iterator
+  eraseEntry(const_iterator it);
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
@@ -191,6 +207,8 @@ NFD_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   Table m_table;
+  /// every entry in m_table, keyed by the hash of its Data name (without implicit digest)
+  std::unordered_multimap<name_tree::HashValue, const_iterator> m_nameIndex;
   unique_ptr<Policy> m_policy;
   signal::ScopedConnection m_beforeEvictConnection;
 
@@ -118,6 +118,7 @@ Fib::erase(const Name& prefix)
   name_tree::Entry* nte = m_nameTree.findExactMatch(prefix);
   if (nte != nullptr) {
     this->erase(nte);
+    this->afterEntryChange(prefix);
   }
 }
 
@@ -129,7 +130,9 @@ Fib::erase(const Entry& entry)
     BOOST_ASSERT(&entry == s_emptyEntry.get());
     return;
   }
+  Name prefix = entry.getPrefix();
   this->erase(nte);
+  this->afterEntryChange(prefix);
 }
 
 void
@@ -141,6 +144,7 @@ Fib::addOrUpdateNextHop(Entry& entry, Face& face, uint64_t cost)
 
   if (isNew)
     this->afterNewNextHop(entry.getPrefix(), *it);
+  this->afterEntryChange(entry.getPrefix());
 }
 
 Fib::RemoveNextHopResult
@@ -152,11 +156,14 @@ Fib::removeNextHop(Entry& entry, const Face& face)
     return RemoveNextHopResult::NO_SUCH_NEXTHOP;
   }
   else if (!entry.hasNextHops()) {
+    Name prefix = entry.getPrefix();
     name_tree::Entry* nte = m_nameTree.getEntry(entry);
     this->erase(nte, false);
+    this->afterEntryChange(prefix);
     return RemoveNextHopResult::FIB_ENTRY_REMOVED;
   }
   else {
+    this->afterEntryChange(entry.getPrefix());
     return RemoveNextHopResult::NEXTHOP_REMOVED;
   }
 }
@@ -150,6 +150,10 @@ public: // signal
    */
   signal::Signal<Fib, Name, NextHop> afterNewNextHop;
 
+  /** \brief signals on any change to the nexthops of a Fib entry, including its removal
+   */
+  signal::Signal<Fib, Name> afterEntryChange;
+
 private:
   /** \tparam K a parameter acceptable to NameTree::findLongestPrefixMatch
    */
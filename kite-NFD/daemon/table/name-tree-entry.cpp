@@ -37,6 +37,12 @@ Entry::Entry(const Name& name, Node* node)
   BOOST_ASSERT(name.size() <= NameTree::getMaxDepth());
 }
 
+size_t
+Entry::getHash() const
+{
+  return m_node->hash;
+}
+
 void
 Entry::setParent(Entry& entry)
 {
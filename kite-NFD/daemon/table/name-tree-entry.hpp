@@ -49,6 +49,11 @@ public:
     return m_name;
   }
 
+  /** \return hash value of getName(), as computed when the entry was inserted into the hashtable
+   */
+  size_t
+  getHash() const;
+
   /** \return entry of getName().getPrefix(-1)
    *  \retval nullptr this entry is the root entry, i.e. getName() == Name()
    */
@@ -24,7 +24,7 @@
  */
 
 #include "name-tree-hashtable.hpp"
-#include "common/city-hash.hpp"
+#include "common/crc32c.hpp"
 #include "common/logger.hpp"
 
 namespace nfd {
@@ -32,48 +32,61 @@ namespace name_tree {
 
 NFD_LOG_INIT(NameTreeHashtable);
 
-class Hash32
+/** \brief computes the hash value of one name component
+ *  \param wire TLV encoding of the component
+ *
+ *  CRC-32C is computed with a CPU instruction where available, and its bits are spread
+ *  over a 64-bit value with the MurmurHash3 finalizer, so that the high-order bits used by
+ *  open addressing and the low-order bits used for bucket selection are both well mixed.
+ */
+static HashValue
+hashComponent(const uint8_t* wire, size_t length)
 {
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash32(reinterpret_cast<const char*>(buffer), length));
-  }
-};
+  uint64_t h = crc32c(wire, length) ^ (static_cast<uint64_t>(length) << 32);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<HashValue>(h);
+}
 
-class Hash64
+/** \brief invokes f(componentHash) for each of the first \p last components of \p name
+ *
+ *  Components are located by walking the TLV-VALUE of the Name element in a single pass,
+ *  without going through the parsed component list.
+ */
+template<typename F>
+static void
+foreachComponentHash(const Name& name, size_t last, const F& f)
 {
-public:
-  static HashValue
-  compute(const void* buffer, size_t length)
-  {
-    return static_cast<HashValue>(CityHash64(reinterpret_cast<const char*>(buffer), length));
-  }
-};
+  const Block& wire = name.wireEncode(); // ensure wire buffer exists
+  const uint8_t* pos = wire.value();
+  const uint8_t* end = pos + wire.value_size();
 
-/** \brief a type with compute static method to compute hash value from a raw buffer
- */
-using HashFunc = std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type;
+  for (size_t i = 0; i < last; ++i) {
+    const uint8_t* begin = pos;
+    tlv::readType(pos, end);
+    uint64_t length = tlv::readVarNumber(pos, end);
+    BOOST_ASSERT(length <= static_cast<uint64_t>(end - pos));
+    pos += length;
+    f(hashComponent(begin, static_cast<size_t>(pos - begin)));
+  }
+}
 
 HashValue
 computeHash(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
-
   HashValue h = 0;
-  for (size_t i = 0, last = std::min(prefixLen, name.size()); i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
-  }
+  foreachComponentHash(name, std::min(prefixLen, name.size()), [&h] (HashValue ch) {
+    h ^= ch;
+  });
   return h;
 }
 
 HashSequence
 computeHashes(const Name& name, size_t prefixLen)
 {
-  name.wireEncode(); // ensure wire buffer exists
-
   size_t last = std::min(prefixLen, name.size());
   HashSequence seq;
   seq.reserve(last + 1);
@@ -81,11 +94,10 @@ computeHashes(const Name& name, size_t prefixLen)
   HashValue h = 0;
   seq.push_back(h);
 
-  for (size_t i = 0; i < last; ++i) {
-    const name::Component& comp = name[i];
-    h ^= HashFunc::compute(comp.data(), comp.size());
+  foreachComponentHash(name, last, [&] (HashValue ch) {
+    h ^= ch;
     seq.push_back(h);
-  }
+  });
   return seq;
 }
 
@@ -109,14 +121,93 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout)
+{
+  switch (layout) {
+    case HashtableLayout::CHAINED:
+      return os << "chained";
+    case HashtableLayout::OPEN_ADDRESSING:
+      return os << "open-addressing";
+  }
+  return os << static_cast<int>(layout);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
 {
 }
 
+void
+PauseHistogram::add(time::nanoseconds duration)
+{
+  size_t bin = 0;
+  for (auto limit = 1_us; bin < N_BINS - 1 && duration >= limit; limit *= 10) {
+    ++bin;
+  }
+  ++m_bins[bin];
+}
+
+// In OPEN_ADDRESSING layout, byte i of Group::tags describes slot i. Byte 7 is unused.
+// A used slot has a tag with the most significant bit set, followed by the seven most
+// significant bits of the node's hash value.
+const uint8_t EMPTY_TAG = 0x00;
+const uint8_t DELETED_TAG = 0x01;
+const uint64_t TAG_LSB = 0x0001010101010101;
+const uint64_t TAG_MSB = 0x0080808080808080;
+const uint64_t TAG_LOW7 = 0x7F7F7F7F7F7F7F7F;
+
+static uint8_t
+computeTag(HashValue h)
+{
+  return 0x80 | static_cast<uint8_t>(h >> (std::numeric_limits<HashValue>::digits - 7));
+}
+
+static uint8_t
+getTag(uint64_t tags, size_t slot)
+{
+  return static_cast<uint8_t>(tags >> (slot * 8));
+}
+
+static void
+setTag(uint64_t& tags, size_t slot, uint8_t tag)
+{
+  tags = (tags & ~(uint64_t(0xFF) << (slot * 8))) | (uint64_t(tag) << (slot * 8));
+}
+
+/** \return a word that has the most significant bit set in byte i if slot i has tag \p tag
+ */
+static uint64_t
+matchTag(uint64_t tags, uint8_t tag)
+{
+  uint64_t x = tags ^ (TAG_LSB * tag);
+  // the MSB of each byte is set if the byte is non-zero; carries cannot cross byte boundaries
+  uint64_t nonZero = ((x & TAG_LOW7) + TAG_LOW7) | x;
+  return ~nonZero & TAG_MSB;
+}
+
+/** \return index of the slot indicated by the lowest set bit in a word returned by matchTag
+ */
+static size_t
+lowestSlot(uint64_t match)
+{
+  BOOST_ASSERT(match != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<size_t>(__builtin_ctzll(match)) / 8;
+#else
+  size_t slot = 0;
+  while ((match & 0x80) == 0) {
+    match >>= 8;
+    ++slot;
+  }
+  return slot;
+#endif
+}
+
 Hashtable::Hashtable(const Options& options)
-  : m_options(options)
+  : m_migrateIndex(0)
+  , m_options(options)
   , m_size(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
@@ -128,45 +219,68 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkLoadFactor < 1.0);
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
+  BOOST_ASSERT(m_options.migrationStep > 0);
 
-  m_buckets.resize(options.initialSize);
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    m_buckets.resize(options.initialSize);
+  }
+  else {
+    m_groups = allocateGroups(options.initialSize);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
-  for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
-      node->prev = node->next = nullptr;
-      delete node;
-    });
+  // collect the nodes first, because enumeration may look at neighbors of the current node
+  std::vector<Node*> nodes;
+  nodes.reserve(m_size);
+  for (const Node* node = this->getFirstNode(); node != nullptr; node = this->getNextNode(node)) {
+    nodes.push_back(const_cast<Node*>(node));
+  }
+
+  for (Node* node : nodes) {
+    node->prev = node->next = nullptr;
+    m_pool.destroy(node);
+  }
+}
+
+Node*
+Hashtable::findInChain(const std::vector<Node*>& buckets, const Name& name, size_t prefixLen,
+                       HashValue h)
+{
+  for (Node* node = buckets[h % buckets.size()]; node != nullptr; node = node->next) {
+    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+      return node;
+    }
   }
+  return nullptr;
 }
 
 void
-Hashtable::attach(size_t bucket, Node* node)
+Hashtable::attach(std::vector<Node*>& buckets, size_t bucket, Node* node)
 {
   node->prev = nullptr;
-  node->next = m_buckets[bucket];
+  node->next = buckets[bucket];
 
   if (node->next != nullptr) {
     BOOST_ASSERT(node->next->prev == nullptr);
     node->next->prev = node;
   }
 
-  m_buckets[bucket] = node;
+  buckets[bucket] = node;
 }
 
 void
-Hashtable::detach(size_t bucket, Node* node)
+Hashtable::detach(std::vector<Node*>& buckets, size_t bucket, Node* node)
 {
   if (node->prev != nullptr) {
     BOOST_ASSERT(node->prev->next == node);
     node->prev->next = node->next;
   }
   else {
-    BOOST_ASSERT(m_buckets[bucket] == node);
-    m_buckets[bucket] = node->next;
+    BOOST_ASSERT(buckets[bucket] == node);
+    buckets[bucket] = node->next;
   }
 
   if (node->next != nullptr) {
@@ -177,31 +291,271 @@ Hashtable::detach(size_t bucket, Node* node)
   node->prev = node->next = nullptr;
 }
 
+const Node*
+Hashtable::scanBuckets(const std::vector<Node*>& buckets, size_t bucket)
+{
+  for (; bucket < buckets.size(); ++bucket) {
+    if (buckets[bucket] != nullptr) {
+      return buckets[bucket];
+    }
+  }
+  return nullptr;
+}
+
+Hashtable::GroupArray
+Hashtable::allocateGroups(size_t nGroups)
+{
+  // allocate one more group so that the array can be aligned to a cache line
+  static_assert(sizeof(void*) != 8 || sizeof(Group) == 64, "Group should occupy one cache line");
+  GroupArray ga;
+  ga.storage = make_unique<uint8_t[]>((nGroups + 1) * sizeof(Group));
+  auto addr = reinterpret_cast<uintptr_t>(ga.storage.get());
+  addr = (addr + sizeof(Group) - 1) / sizeof(Group) * sizeof(Group);
+  ga.groups = reinterpret_cast<Group*>(addr);
+  ga.size = nGroups;
+  for (size_t i = 0; i < ga.size; ++i) {
+    new (&ga.groups[i]) Group{};
+  }
+  return ga;
+}
+
+std::tuple<Node*, size_t, size_t>
+Hashtable::findSlot(const GroupArray& ga, const Name& name, size_t prefixLen, HashValue h)
+{
+  uint8_t tag = computeTag(h);
+  size_t freeGroup = ga.size;
+  size_t freeSlot = 0;
+
+  for (size_t i = 0, group = h % ga.size; i < ga.size;
+       ++i, group = group + 1 == ga.size ? 0 : group + 1) {
+    const Group& g = ga.groups[group];
+
+    for (uint64_t match = matchTag(g.tags, tag); match != 0; match &= match - 1) {
+      size_t slot = lowestSlot(match);
+      Node* node = g.nodes[slot];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        return std::make_tuple(node, group, slot);
+      }
+    }
+
+    if (freeGroup == ga.size) {
+      uint64_t reusable = matchTag(g.tags, EMPTY_TAG) | matchTag(g.tags, DELETED_TAG);
+      if (reusable != 0) {
+        freeGroup = group;
+        freeSlot = lowestSlot(reusable);
+      }
+    }
+
+    // a probe sequence ends at a group that has never been full
+    if (matchTag(g.tags, EMPTY_TAG) != 0) {
+      break;
+    }
+  }
+
+  return std::make_tuple(nullptr, freeGroup, freeSlot);
+}
+
+void
+Hashtable::fillSlot(GroupArray& ga, size_t group, size_t slot, Node* node)
+{
+  Group& g = ga.groups[group];
+  BOOST_ASSERT((getTag(g.tags, slot) & 0x80) == 0);
+  if (getTag(g.tags, slot) == DELETED_TAG) {
+    --ga.nDeleted;
+  }
+  setTag(g.tags, slot, computeTag(node->hash));
+  g.nodes[slot] = node;
+}
+
+bool
+Hashtable::place(GroupArray& ga, Node* node)
+{
+  for (size_t i = 0, group = node->hash % ga.size; i < ga.size;
+       ++i, group = group + 1 == ga.size ? 0 : group + 1) {
+    uint64_t tags = ga.groups[group].tags;
+    uint64_t reusable = matchTag(tags, EMPTY_TAG) | matchTag(tags, DELETED_TAG);
+    if (reusable != 0) {
+      fillSlot(ga, group, lowestSlot(reusable), node);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::pair<size_t, size_t>
+Hashtable::locate(const GroupArray& ga, const Node* node)
+{
+  uint8_t tag = computeTag(node->hash);
+  for (size_t i = 0, group = node->hash % std::max<size_t>(ga.size, 1); i < ga.size;
+       ++i, group = group + 1 == ga.size ? 0 : group + 1) {
+    const Group& g = ga.groups[group];
+    for (uint64_t match = matchTag(g.tags, tag); match != 0; match &= match - 1) {
+      size_t slot = lowestSlot(match);
+      if (g.nodes[slot] == node) {
+        return {group, slot};
+      }
+    }
+    if (matchTag(g.tags, EMPTY_TAG) != 0) {
+      break;
+    }
+  }
+  return {ga.size, 0};
+}
+
+void
+Hashtable::clearSlot(GroupArray& ga, size_t group, size_t slot, bool canEmpty)
+{
+  Group& g = ga.groups[group];
+  // a slot in a group that has never been full can become empty again,
+  // because no probe sequence passes through such a group
+  if (canEmpty && matchTag(g.tags, EMPTY_TAG) != 0) {
+    setTag(g.tags, slot, EMPTY_TAG);
+  }
+  else {
+    setTag(g.tags, slot, DELETED_TAG);
+    ++ga.nDeleted;
+  }
+  g.nodes[slot] = nullptr;
+}
+
+const Node*
+Hashtable::scanGroups(const GroupArray& ga, size_t group, size_t slot)
+{
+  for (; group < ga.size; ++group, slot = 0) {
+    uint64_t tags = ga.groups[group].tags;
+    uint64_t used = ~(matchTag(tags, EMPTY_TAG) | matchTag(tags, DELETED_TAG)) & TAG_MSB;
+    // drop slots before the starting slot
+    used &= ~uint64_t(0) << (slot * 8);
+    if (used != 0) {
+      return ga.groups[group].nodes[lowestSlot(used)];
+    }
+  }
+  return nullptr;
+}
+
+const Node*
+Hashtable::getFirstNode() const
+{
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    const Node* node = scanBuckets(m_buckets, 0);
+    return node != nullptr ? node : scanBuckets(m_oldBuckets, m_migrateIndex);
+  }
+
+  const Node* node = scanGroups(m_groups, 0, 0);
+  return node != nullptr ? node : scanGroups(m_oldGroups, m_migrateIndex, 0);
+}
+
+const Node*
+Hashtable::getNextNode(const Node* node) const
+{
+  BOOST_ASSERT(node != nullptr);
+
+  // nodes in the current bucket array are enumerated before nodes in the old bucket array
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    if (node->next != nullptr) {
+      return node->next;
+    }
+
+    size_t bucket = node->hash % m_buckets.size();
+    if (this->isResizing()) {
+      const Node* head = node;
+      while (head->prev != nullptr) {
+        head = head->prev;
+      }
+      if (m_buckets[bucket] != head) {
+        return scanBuckets(m_oldBuckets, node->hash % m_oldBuckets.size() + 1);
+      }
+    }
+
+    const Node* next = scanBuckets(m_buckets, bucket + 1);
+    return next != nullptr ? next : scanBuckets(m_oldBuckets, m_migrateIndex);
+  }
+
+  size_t group = 0, slot = 0;
+  std::tie(group, slot) = locate(m_groups, node);
+  if (group < m_groups.size) {
+    const Node* next = scanGroups(m_groups, group, slot + 1);
+    return next != nullptr ? next : scanGroups(m_oldGroups, m_migrateIndex, 0);
+  }
+
+  std::tie(group, slot) = locate(m_oldGroups, node);
+  BOOST_ASSERT_MSG(group < m_oldGroups.size, "node does not exist in hashtable");
+  return scanGroups(m_oldGroups, group, slot + 1);
+}
+
+void
+Hashtable::prefetchNode(HashValue h) const
+{
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    prefetch(m_buckets[this->computeBucketIndex(h)]);
+    return;
+  }
+
+  const Group& g = m_groups.groups[this->computeBucketIndex(h)];
+  uint64_t match = matchTag(g.tags, computeTag(h));
+  if (match != 0) {
+    prefetch(g.nodes[lowestSlot(match)]);
+  }
+}
+
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
-  size_t bucket = this->computeBucketIndex(h);
-
-  for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
-    if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
-      NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
-      return {node, false};
+  Node* node = nullptr;
+  size_t bucket = 0;
+  size_t slot = 0;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    bucket = this->computeBucketIndex(h);
+    node = findInChain(m_buckets, name, prefixLen, h);
+    if (node == nullptr && !m_oldBuckets.empty() && h % m_oldBuckets.size() >= m_migrateIndex) {
+      node = findInChain(m_oldBuckets, name, prefixLen, h);
     }
   }
+  else {
+    std::tie(node, bucket, slot) = findSlot(m_groups, name, prefixLen, h);
+    if (node == nullptr && m_oldGroups.size > 0) {
+      node = std::get<0>(findSlot(m_oldGroups, name, prefixLen, h));
+    }
+  }
+
+  if (node != nullptr) {
+    NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
+    return {node, false};
+  }
 
   if (!allowInsert) {
     NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h << " bucket=" << bucket);
     return {nullptr, false};
   }
 
-  Node* node = new Node(h, name.getPrefix(prefixLen));
-  this->attach(bucket, node);
+  // new nodes always go into the current bucket array
+  node = m_pool.create(h, name.getPrefix(prefixLen));
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    attach(m_buckets, bucket, node);
+  }
+  else if (bucket == m_groups.size) {
+    // every slot is used, which is possible only if expandLoadFactor is 1.0
+    this->rehash(static_cast<size_t>(m_options.expandFactor * m_groups.size));
+    bool ok = place(m_groups, node);
+    BOOST_ASSERT_MSG(ok, "no free slot");
+    static_cast<void>(ok);
+  }
+  else {
+    fillSlot(m_groups, bucket, slot, node);
+  }
   NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
   ++m_size;
 
+  this->continueResize();
+
   if (m_size > m_expandThreshold) {
     this->resize(static_cast<size_t>(m_options.expandFactor * this->getNBuckets()));
   }
+  else if (m_size + m_groups.nDeleted > m_expandThreshold) {
+    // too many deleted slots lengthen the probe sequences; clear them without resizing
+    this->rehash(this->getNBuckets());
+  }
 
   return {node, true};
 }
@@ -233,13 +587,40 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
+  size_t bucket = 0;
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    bucket = this->computeBucketIndex(node->hash);
+    const Node* head = node;
+    while (head->prev != nullptr) {
+      head = head->prev;
+    }
+    if (m_buckets[bucket] == head) {
+      detach(m_buckets, bucket, node);
+    }
+    else {
+      BOOST_ASSERT(!m_oldBuckets.empty());
+      detach(m_oldBuckets, node->hash % m_oldBuckets.size(), node);
+    }
+  }
+  else {
+    size_t slot = 0;
+    std::tie(bucket, slot) = locate(m_groups, node);
+    if (bucket < m_groups.size) {
+      clearSlot(m_groups, bucket, slot, true);
+    }
+    else {
+      std::tie(bucket, slot) = locate(m_oldGroups, node);
+      BOOST_ASSERT_MSG(bucket < m_oldGroups.size, "node does not exist in hashtable");
+      clearSlot(m_oldGroups, bucket, slot, true);
+    }
+  }
   NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+  m_pool.destroy(node);
   --m_size;
 
+  this->continueResize();
+
   if (m_size < m_shrinkThreshold) {
     size_t newNBuckets = std::max(m_options.minSize,
       static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
@@ -247,11 +628,65 @@ Hashtable::erase(Node* node)
   }
 }
 
+void
+Hashtable::setLayout(HashtableLayout layout)
+{
+  if (m_options.layout == layout) {
+    return;
+  }
+  NFD_LOG_DEBUG("layout from=" << m_options.layout << " to=" << layout);
+
+  std::vector<Node*> nodes;
+  nodes.reserve(m_size);
+  for (const Node* node = this->getFirstNode(); node != nullptr; node = this->getNextNode(node)) {
+    nodes.push_back(const_cast<Node*>(node));
+  }
+
+  // keep the same number of slots, within the bounds of the new layout
+  size_t nSlots = this->computeCapacity(this->getNBuckets());
+  m_options.layout = layout;
+  size_t nBuckets = std::max(m_options.minSize, nSlots / this->computeCapacity(1));
+  while (m_options.expandLoadFactor * this->computeCapacity(nBuckets) < m_size) {
+    nBuckets = static_cast<size_t>(m_options.expandFactor * nBuckets);
+  }
+
+  std::vector<Node*>().swap(m_buckets);
+  std::vector<Node*>().swap(m_oldBuckets);
+  m_groups = GroupArray{};
+  m_oldGroups = GroupArray{};
+  m_migrateIndex = 0;
+
+  if (layout == HashtableLayout::CHAINED) {
+    m_buckets.resize(nBuckets);
+    for (Node* node : nodes) {
+      attach(m_buckets, this->computeBucketIndex(node->hash), node);
+    }
+  }
+  else {
+    m_groups = allocateGroups(nBuckets);
+    for (Node* node : nodes) {
+      node->prev = node->next = nullptr;
+      bool ok = place(m_groups, node);
+      BOOST_ASSERT_MSG(ok, "no free slot");
+      static_cast<void>(ok);
+    }
+  }
+
+  this->computeThresholds();
+}
+
+size_t
+Hashtable::computeCapacity(size_t nBuckets) const
+{
+  return m_options.layout == HashtableLayout::CHAINED ? nBuckets : nBuckets * Group::N_SLOTS;
+}
+
 void
 Hashtable::computeThresholds()
 {
-  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
-  m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
+  size_t capacity = this->computeCapacity(this->getNBuckets());
+  m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * capacity);
+  m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * capacity);
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
 
@@ -263,18 +698,92 @@ Hashtable::resize(size_t newNBuckets)
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
 
-  std::vector<Node*> oldBuckets;
-  oldBuckets.swap(m_buckets);
-  m_buckets.resize(newNBuckets);
+  this->rehash(newNBuckets);
+}
+
+void
+Hashtable::rehash(size_t newNBuckets)
+{
+  auto startTime = time::steady_clock::now();
 
-  for (Node* head : oldBuckets) {
-    foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
-    });
+  if (this->isResizing()) {
+    this->migrate(std::numeric_limits<size_t>::max());
   }
+  BOOST_ASSERT(!this->isResizing());
 
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    m_oldBuckets.swap(m_buckets);
+    m_buckets.assign(newNBuckets, nullptr);
+  }
+  else {
+    m_oldGroups = std::move(m_groups);
+    m_groups = allocateGroups(newNBuckets);
+  }
+  m_migrateIndex = 0;
   this->computeThresholds();
+
+  m_resizePauses.add(time::steady_clock::now() - startTime);
+}
+
+void
+Hashtable::migrate(size_t nNodes)
+{
+  size_t nMoved = 0;
+  // bound the number of empty buckets visited in a sparse bucket array
+  size_t maxVisits = nNodes > std::numeric_limits<size_t>::max() / 10 ?
+                     std::numeric_limits<size_t>::max() : nNodes * 10;
+
+  if (m_options.layout == HashtableLayout::CHAINED) {
+    for (size_t nVisits = 0; m_migrateIndex < m_oldBuckets.size() && nMoved < nNodes &&
+                             nVisits < maxVisits; ++m_migrateIndex, ++nVisits) {
+      Node* head = m_oldBuckets[m_migrateIndex];
+      m_oldBuckets[m_migrateIndex] = nullptr;
+      foreachNode(head, [this, &nMoved] (Node* node) {
+        attach(m_buckets, this->computeBucketIndex(node->hash), node);
+        ++nMoved;
+      });
+    }
+
+    if (m_migrateIndex == m_oldBuckets.size()) {
+      NFD_LOG_TRACE("migration complete nBuckets=" << m_buckets.size());
+      std::vector<Node*>().swap(m_oldBuckets);
+      m_migrateIndex = 0;
+    }
+    return;
+  }
+
+  for (size_t nVisits = 0; m_migrateIndex < m_oldGroups.size && nMoved < nNodes &&
+                           nVisits < maxVisits; ++m_migrateIndex, ++nVisits) {
+    for (size_t slot = 0; slot < Group::N_SLOTS; ++slot) {
+      if ((getTag(m_oldGroups.groups[m_migrateIndex].tags, slot) & 0x80) == 0) {
+        continue;
+      }
+      bool ok = place(m_groups, m_oldGroups.groups[m_migrateIndex].nodes[slot]);
+      BOOST_ASSERT_MSG(ok, "no free slot");
+      static_cast<void>(ok);
+      // nodes not yet migrated may be on a probe sequence that passes through this slot
+      clearSlot(m_oldGroups, m_migrateIndex, slot, false);
+      ++nMoved;
+    }
+  }
+
+  if (m_migrateIndex == m_oldGroups.size) {
+    NFD_LOG_TRACE("migration complete nBuckets=" << m_groups.size);
+    m_oldGroups = GroupArray{};
+    m_migrateIndex = 0;
+  }
+}
+
+void
+Hashtable::continueResize()
+{
+  if (!this->isResizing()) {
+    return;
+  }
+
+  auto startTime = time::steady_clock::now();
+  this->migrate(m_options.migrationStep);
+  m_resizePauses.add(time::steady_clock::now() - startTime);
 }
 
 } // namespace name_tree
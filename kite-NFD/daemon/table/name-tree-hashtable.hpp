@@ -27,6 +27,9 @@
 #define NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
 
 #include "name-tree-entry.hpp"
+#include "common/slab-pool.hpp"
+
+#include <array>
 
 namespace nfd {
 namespace name_tree {
@@ -53,6 +56,17 @@ computeHash(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::ma
 HashSequence
 computeHashes(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max());
 
+/** \brief hints the CPU to load the cache line containing \p addr
+ *  \note \p addr may be nullptr or otherwise invalid; this never faults.
+ */
+inline void
+prefetch(const void* addr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#endif
+}
+
 /** \brief a hashtable node
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
@@ -101,6 +115,23 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief how a Hashtable organizes its nodes
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of nodes
+   */
+  CHAINED,
+  /** \brief open addressing over cache-line-sized buckets
+   *
+   *  Each bucket holds up to seven (fingerprint, node pointer) slots in 64 octets, so that
+   *  a lookup usually touches one cache line before reaching the node it is looking for.
+   */
+  OPEN_ADDRESSING,
+};
+
+std::ostream&
+operator<<(std::ostream& os, HashtableLayout layout);
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -137,14 +168,60 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief organization of buckets
+   *
+   *  The load factors apply to slots: a bucket has one slot in CHAINED layout,
+   *  and seven slots in OPEN_ADDRESSING layout.
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
+
+  /** \brief while resizing, number of nodes migrated by each insertion or deletion
+   *
+   *  A migration step visits at most ten times as many buckets, so that it stays short
+   *  even when the old bucket array is sparse.
+   */
+  size_t migrationStep = 4;
+};
+
+/** \brief counts hashtable resize pauses by duration
+ *
+ *  Bin 0 counts pauses shorter than 1 microsecond. Bin i, 0 < i < N_BINS - 1, counts pauses
+ *  of at least 10^(i-1) and less than 10^i microseconds. The last bin counts longer pauses.
+ */
+class PauseHistogram
+{
+public:
+  static constexpr size_t N_BINS = 8;
+  using Bins = std::array<uint64_t, N_BINS>;
+
+  void
+  add(time::nanoseconds duration);
+
+  const Bins&
+  getBins() const
+  {
+    return m_bins;
+  }
+
+private:
+  Bins m_bins{};
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  In CHAINED layout, hash collision is resolved through a doubly linked list in each bucket.
+ *  In OPEN_ADDRESSING layout, a bucket has a fixed number of slots, and a node whose bucket is
+ *  full is placed in the next bucket that has a free slot.
+ *  Nodes are allocated from a slab pool, and are not moved when the hashtable is resized.
+ *
  *  The number of buckets is adjusted according to how many nodes are stored.
+ *  Resizing is incremental: a new bucket array is allocated, and each subsequent insertion
+ *  or deletion migrates a few nodes from the old array, so that no single operation pays
+ *  for rehashing the whole table. Until migration completes, both arrays are searched.
+ *  Lookups never move nodes.
  */
 class Hashtable
 {
@@ -167,13 +244,45 @@ public:
   }
 
   /** \return number of buckets
+   *  \note During a resize, this is the size of the new bucket array.
    */
   size_t
   getNBuckets() const
   {
-    return m_buckets.size();
+    return m_options.layout == HashtableLayout::CHAINED ? m_buckets.size() : m_groups.size;
+  }
+
+  /** \return whether nodes are being migrated from an old bucket array
+   */
+  bool
+  isResizing() const
+  {
+    return !m_oldBuckets.empty() || m_oldGroups.size > 0;
+  }
+
+  /** \return durations of the pauses caused by resizing
+   */
+  const PauseHistogram&
+  getResizePauses() const
+  {
+    return m_resizePauses;
+  }
+
+  /** \return bucket layout
+   */
+  HashtableLayout
+  getLayout() const
+  {
+    return m_options.layout;
   }
 
+  /** \brief change bucket layout
+   *
+   *  Every node is moved into the new buckets. Pointers to nodes and entries remain valid.
+   */
+  void
+  setLayout(HashtableLayout layout);
+
   /** \return bucket index for hash value h
    */
   size_t
@@ -184,14 +293,50 @@ public:
 
   /** \return i-th bucket
    *  \pre bucket < getNBuckets()
+   *  \pre getLayout() == HashtableLayout::CHAINED
+   *  \note During a resize, nodes that have not been migrated are not in any bucket.
    */
   const Node*
   getBucket(size_t bucket) const
   {
+    BOOST_ASSERT(m_options.layout == HashtableLayout::CHAINED);
     BOOST_ASSERT(bucket < this->getNBuckets());
     return m_buckets[bucket]; // don't use m_bucket.at() for better performance
   }
 
+  /** \return first node in enumeration order, or nullptr if the hashtable is empty
+   */
+  const Node*
+  getFirstNode() const;
+
+  /** \return node after \p node in enumeration order, or nullptr if \p node is the last
+   *  \pre node exists in this hashtable
+   */
+  const Node*
+  getNextNode(const Node* node) const;
+
+  /** \brief hints the CPU to load the bucket for hash value h
+   *  \note This does not affect the content of the hashtable.
+   */
+  void
+  prefetchBucket(HashValue h) const
+  {
+    if (m_options.layout == HashtableLayout::CHAINED) {
+      prefetch(&m_buckets[this->computeBucketIndex(h)]);
+    }
+    else {
+      prefetch(&m_groups.groups[this->computeBucketIndex(h)]);
+    }
+  }
+
+  /** \brief hints the CPU to load the first node in the bucket for hash value h
+   *
+   *  This reads the bucket, so it should be preceded by prefetchBucket(h) early enough
+   *  for the bucket to be in cache.
+   */
+  void
+  prefetchNode(HashValue h) const;
+
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
    */
@@ -218,32 +363,137 @@ public:
   void
   erase(Node* node);
 
-private:
+private: // CHAINED layout
+  static Node*
+  findInChain(const std::vector<Node*>& buckets, const Name& name, size_t prefixLen, HashValue h);
+
   /** \brief attach node to bucket
    */
-  void
-  attach(size_t bucket, Node* node);
+  static void
+  attach(std::vector<Node*>& buckets, size_t bucket, Node* node);
 
   /** \brief detach node from bucket
    */
-  void
-  detach(size_t bucket, Node* node);
+  static void
+  detach(std::vector<Node*>& buckets, size_t bucket, Node* node);
+
+  /** \return first node in bucket \p bucket or a later bucket of \p buckets
+   */
+  static const Node*
+  scanBuckets(const std::vector<Node*>& buckets, size_t bucket);
+
+private: // OPEN_ADDRESSING layout
+  /** \brief a bucket in OPEN_ADDRESSING layout, occupying one cache line
+   *
+   *  Slot i is described by byte i of \c tags: EMPTY_TAG, DELETED_TAG, or the fingerprint
+   *  of the node in \c nodes[i]. Packing the tags in one word allows all slots to be
+   *  compared against a fingerprint with a few word-wide operations.
+   */
+  struct Group
+  {
+    static constexpr size_t N_SLOTS = 7;
+
+    uint64_t tags;
+    Node* nodes[N_SLOTS];
+  };
+
+  /** \brief an array of groups aligned to a cache line
+   */
+  struct GroupArray
+  {
+    unique_ptr<uint8_t[]> storage;
+    Group* groups = nullptr;
+    size_t size = 0;
+    size_t nDeleted = 0;
+  };
+
+  static GroupArray
+  allocateGroups(size_t nGroups);
+
+  /** \brief find a node in OPEN_ADDRESSING layout
+   *  \return the node with its group and slot index, or nullptr with the first reusable slot
+   *           on the probe sequence; the group index equals \p ga.size if there is none
+   */
+  static std::tuple<Node*, size_t, size_t>
+  findSlot(const GroupArray& ga, const Name& name, size_t prefixLen, HashValue h);
 
+  /** \brief store node in a slot
+   */
+  static void
+  fillSlot(GroupArray& ga, size_t group, size_t slot, Node* node);
+
+  /** \brief store node in the first reusable slot of its probe sequence
+   *  \return whether a reusable slot was found
+   */
+  static bool
+  place(GroupArray& ga, Node* node);
+
+  /** \return group and slot index of a node, or (ga.size, 0) if the node is not in \p ga
+   */
+  static std::pair<size_t, size_t>
+  locate(const GroupArray& ga, const Node* node);
+
+  /** \brief free the slot of a node
+   *  \param canEmpty whether the slot may be marked empty when no probe sequence passes it
+   */
+  static void
+  clearSlot(GroupArray& ga, size_t group, size_t slot, bool canEmpty);
+
+  /** \return first node at or after slot \p slot in group \p group
+   */
+  static const Node*
+  scanGroups(const GroupArray& ga, size_t group, size_t slot);
+
+private:
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  /** \return number of slots in \p nBuckets buckets of the current layout
+   */
+  size_t
+  computeCapacity(size_t nBuckets) const;
+
   void
   computeThresholds();
 
   void
   resize(size_t newNBuckets);
 
+  /** \brief start moving every node into \p newNBuckets buckets of the current layout
+   *
+   *  A resize that is still in progress is completed first.
+   */
+  void
+  rehash(size_t newNBuckets);
+
+  /** \brief migrate up to \p nNodes nodes from the old bucket array
+   *
+   *  When every node has been migrated, the old bucket array is released.
+   */
+  void
+  migrate(size_t nNodes);
+
+  /** \brief perform one migration step, if a resize is in progress
+   */
+  void
+  continueResize();
+
 private:
+  // CHAINED layout
   std::vector<Node*> m_buckets;
+  std::vector<Node*> m_oldBuckets;
+  // OPEN_ADDRESSING layout
+  GroupArray m_groups;
+  GroupArray m_oldGroups;
+  /// next bucket of the old array to migrate
+  size_t m_migrateIndex;
+
+  SlabPool<Node> m_pool;
   Options m_options;
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+  PauseHistogram m_resizePauses;
 };
 
 } // namespace name_tree
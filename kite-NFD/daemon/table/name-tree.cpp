@@ -42,12 +42,18 @@ NameTree::NameTree(size_t nBuckets)
 
 Entry&
 NameTree::lookup(const Name& name, size_t prefixLen)
+{
+  return this->lookup(name, prefixLen, computeHashes(name, prefixLen));
+}
+
+Entry&
+NameTree::lookup(const Name& name, size_t prefixLen, const HashSequence& hashes)
 {
   NFD_LOG_TRACE("lookup(" << name << ", " << prefixLen << ')');
   BOOST_ASSERT(prefixLen <= name.size());
   BOOST_ASSERT(prefixLen <= getMaxDepth());
+  BOOST_ASSERT(prefixLen < hashes.size());
 
-  HashSequence hashes = computeHashes(name, prefixLen);
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -146,6 +152,22 @@ NameTree::eraseIfEmpty(Entry* entry, bool canEraseAncestors)
   return nErased;
 }
 
+void
+NameTree::prefetchBuckets(const HashSequence& hashes) const
+{
+  for (HashValue h : hashes) {
+    m_ht.prefetchBucket(h);
+  }
+}
+
+void
+NameTree::prefetchNodes(const HashSequence& hashes) const
+{
+  for (HashValue h : hashes) {
+    m_ht.prefetchNode(h);
+  }
+}
+
 Entry*
 NameTree::findExactMatch(const Name& name, size_t prefixLen) const
 {
@@ -158,11 +180,32 @@ NameTree::findExactMatch(const Name& name, size_t prefixLen) const
   return node == nullptr ? nullptr : &node->entry;
 }
 
+Entry*
+NameTree::findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const
+{
+  prefixLen = std::min(name.size(), prefixLen);
+  if (prefixLen > getMaxDepth()) {
+    return nullptr;
+  }
+
+  BOOST_ASSERT(prefixLen < hashes.size());
+  const Node* node = m_ht.find(name, prefixLen, hashes);
+  return node == nullptr ? nullptr : &node->entry;
+}
+
 Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
   size_t depth = std::min(name.size(), getMaxDepth());
-  HashSequence hashes = computeHashes(name, depth);
+  return this->findLongestPrefixMatch(name, computeHashes(name, depth), entrySelector);
+}
+
+Entry*
+NameTree::findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                                 const EntrySelector& entrySelector) const
+{
+  size_t depth = std::min(name.size(), getMaxDepth());
+  BOOST_ASSERT(depth < hashes.size());
 
   for (ssize_t i = depth; i >= 0; --i) {
     const Node* node = m_ht.find(name, i, hashes);
@@ -222,6 +265,14 @@ NameTree::findAllMatches(const Name& name, const EntrySelector& entrySelector) c
   return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
 }
 
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector) const
+{
+  Entry* entry = this->findLongestPrefixMatch(name, hashes, entrySelector);
+  return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
+}
+
 boost::iterator_range<NameTree::const_iterator>
 NameTree::fullEnumerate(const EntrySelector& entrySelector) const
 {
@@ -69,6 +69,32 @@ public: // information
     return m_ht.getNBuckets();
   }
 
+  /** \return layout of hashtable buckets
+   */
+  HashtableLayout
+  getHashtableLayout() const
+  {
+    return m_ht.getLayout();
+  }
+
+  /** \brief change layout of hashtable buckets
+   *
+   *  Existing entries are moved into the new buckets; references to them remain valid.
+   */
+  void
+  setHashtableLayout(HashtableLayout layout)
+  {
+    m_ht.setLayout(layout);
+  }
+
+  /** \return durations of the pauses caused by resizing the hashtable
+   */
+  const PauseHistogram&
+  getResizePauses() const
+  {
+    return m_ht.getResizePauses();
+  }
+
   /** \return name tree entry on which a table entry is attached,
    *          or nullptr if the table entry is detached
    */
@@ -92,6 +118,12 @@ public: // mutation
   Entry&
   lookup(const Name& name, size_t prefixLen);
 
+  /** \brief Equivalent to `lookup(name, prefixLen)`, with the hashes computed beforehand
+   *  \pre hashes == computeHashes(name, n) for some n >= prefixLen
+   */
+  Entry&
+  lookup(const Name& name, size_t prefixLen, const HashSequence& hashes);
+
   /** \brief Equivalent to `lookup(name, name.size())`
    */
   Entry&
@@ -141,6 +173,22 @@ public: // mutation
   size_t
   eraseIfEmpty(Entry* entry, bool canEraseAncestors = true);
 
+public: // prefetching
+  /** \brief Hints the CPU to load the hashtable buckets of every prefix in \p hashes
+   *  \param hashes hash values of the prefixes, as returned by computeHashes
+   *
+   *  Used by burst processing: prefetching the buckets for a group of names before looking
+   *  them up lets the cache misses of those lookups overlap. The name tree is not modified.
+   */
+  void
+  prefetchBuckets(const HashSequence& hashes) const;
+
+  /** \brief Hints the CPU to load the first node in the bucket of every prefix in \p hashes
+   *  \pre prefetchBuckets(hashes) has been called earlier
+   */
+  void
+  prefetchNodes(const HashSequence& hashes) const;
+
 public: // matching
   /** \brief Exact match lookup
    *  \return entry with \c name.getPrefix(prefixLen), or nullptr if it does not exist
@@ -148,6 +196,12 @@ public: // matching
   Entry*
   findExactMatch(const Name& name, size_t prefixLen = std::numeric_limits<size_t>::max()) const;
 
+  /** \brief Equivalent to `findExactMatch(name, prefixLen)`, with the hashes computed beforehand
+   *  \pre hashes == computeHashes(name, n) for some n >= min(prefixLen, getMaxDepth())
+   */
+  Entry*
+  findExactMatch(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
+
   /** \brief Longest prefix matching
    *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
    *          where no other entry with a longer name satisfies those requirements;
@@ -157,6 +211,14 @@ public: // matching
   findLongestPrefixMatch(const Name& name,
                          const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findLongestPrefixMatch(name, entrySelector)`, with the hashes
+   *         computed beforehand
+   *  \pre hashes == computeHashes(name, std::min(name.size(), getMaxDepth()))
+   */
+  Entry*
+  findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                         const EntrySelector& entrySelector = AnyEntry()) const;
+
   /** \brief Equivalent to `findLongestPrefixMatch(entry.getName(), entrySelector)`
    *  \note This overload is more efficient than
    *        `findLongestPrefixMatch(const Name&, const EntrySelector&)` in common cases.
@@ -213,6 +275,13 @@ public: // matching
   findAllMatches(const Name& name,
                  const EntrySelector& entrySelector = AnyEntry()) const;
 
+  /** \brief Equivalent to `findAllMatches(name, entrySelector)`, with the hashes computed beforehand
+   *  \pre hashes == computeHashes(name, std::min(name.size(), getMaxDepth()))
+   */
+  Range
+  findAllMatches(const Name& name, const HashSequence& hashes,
+                 const EntrySelector& entrySelector = AnyEntry()) const;
+
 public: // enumeration
   using const_iterator = Iterator;
 
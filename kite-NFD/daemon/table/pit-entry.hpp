@@ -28,6 +28,8 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "common/pool-allocator.hpp"
+#include "common/timer-wheel.hpp"
 
 #include <list>
 
@@ -40,12 +42,16 @@ class Entry;
 namespace pit {
 
 /** \brief An unordered collection of in-records
+ *
+ *  List nodes come from per-thread pools, so that adding and removing records does not
+ *  reach the global heap.
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef std::list<InRecord, PoolAllocator<InRecord>> InRecordCollection;
 
 /** \brief An unordered collection of out-records
+ *  \sa InRecordCollection
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef std::list<OutRecord, PoolAllocator<OutRecord>> OutRecordCollection;
 
 /** \brief An Interest table entry
  *
@@ -55,7 +61,7 @@ typedef std::list<OutRecord> OutRecordCollection;
  *  In addition, the entry, in-records, and out-records are subclasses of StrategyInfoHost,
  *  which allows forwarding strategy to store arbitrary information on them.
  */
-class Entry : public StrategyInfoHost, noncopyable
+class Entry : public StrategyInfoHost, public std::enable_shared_from_this<Entry>, noncopyable
 {
 public:
   explicit
@@ -218,9 +224,10 @@ public: // out-record
 public:
   /** \brief Expiry timer
    *
-   *  This timer is used in forwarding pipelines to delete the entry
+   *  This timer is used in forwarding pipelines to delete the entry.
+   *  It is scheduled on the forwarder's PIT timer wheel, and cancelled when the entry is destructed.
    */
-  scheduler::EventId expiryTimer;
+  TimerWheel::Timer expiryTimer;
 
   /** \brief Indicates whether this PIT entry is satisfied
    */
@@ -40,7 +40,7 @@ Pit::Pit(NameTree& nameTree)
 }
 
 std::pair<shared_ptr<Entry>, bool>
-Pit::findOrInsert(const Interest& interest, bool allowInsert)
+Pit::findOrInsert(const Interest& interest, bool allowInsert, const name_tree::HashSequence* hashes)
 {
   // determine which NameTree entry should the PIT entry be attached onto
   const Name& name = interest.getName();
@@ -51,10 +51,12 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
   // ensure NameTree entry exists
   name_tree::Entry* nte = nullptr;
   if (allowInsert) {
-    nte = &m_nameTree.lookup(name, nteDepth);
+    nte = hashes == nullptr ? &m_nameTree.lookup(name, nteDepth) :
+                              &m_nameTree.lookup(name, nteDepth, *hashes);
   }
   else {
-    nte = m_nameTree.findExactMatch(name, nteDepth);
+    nte = hashes == nullptr ? m_nameTree.findExactMatch(name, nteDepth) :
+                              m_nameTree.findExactMatch(name, nteDepth, *hashes);
     if (nte == nullptr) {
       return {nullptr, true};
     }
@@ -76,7 +78,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  // the entry and its reference counts share one block from a per-thread pool
+  auto entry = std::allocate_shared<Entry>(PoolAllocator<Entry>(), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
@@ -85,8 +88,18 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
 DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+  return collectDataMatches(data, m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries));
+}
 
+DataMatchResult
+Pit::findAllDataMatches(const Data& data, const name_tree::HashSequence& hashes) const
+{
+  return collectDataMatches(data, m_nameTree.findAllMatches(data.getName(), hashes, &nteHasPitEntries));
+}
+
+DataMatchResult
+Pit::collectDataMatches(const Data& data, const name_tree::Range& ntMatches) const
+{
   DataMatchResult matches;
   for (const auto& nte : ntMatches) {
     for (const auto& pitEntry : nte.getPitEntries()) {
@@ -68,6 +68,16 @@ public:
     return const_cast<Pit*>(this)->findOrInsert(interest, false).first;
   }
 
+  /** \brief Equivalent to `find(interest)`, with the name hashes computed beforehand
+   *  \param hashes `name_tree::computeHashes(name, std::min(name.size(), NameTree::getMaxDepth()))`
+   *                of the Interest name
+   */
+  shared_ptr<Entry>
+  find(const Interest& interest, const name_tree::HashSequence& hashes) const
+  {
+    return const_cast<Pit*>(this)->findOrInsert(interest, false, &hashes).first;
+  }
+
   /** \brief Inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared
    *  \return a new or existing entry with same Name and Selectors,
@@ -79,12 +89,29 @@ public:
     return this->findOrInsert(interest, true);
   }
 
+  /** \brief Equivalent to `insert(interest)`, with the name hashes computed beforehand
+   *  \param hashes `name_tree::computeHashes(name, std::min(name.size(), NameTree::getMaxDepth()))`
+   *                of the Interest name
+   */
+  std::pair<shared_ptr<Entry>, bool>
+  insert(const Interest& interest, const name_tree::HashSequence& hashes)
+  {
+    return this->findOrInsert(interest, true, &hashes);
+  }
+
   /** \brief Performs a Data match
    *  \return an iterable of all PIT entries matching \p data
    */
   DataMatchResult
   findAllDataMatches(const Data& data) const;
 
+  /** \brief Equivalent to `findAllDataMatches(data)`, with the name hashes computed beforehand
+   *  \param hashes `name_tree::computeHashes(name, std::min(name.size(), NameTree::getMaxDepth()))`
+   *                of the Data name
+   */
+  DataMatchResult
+  findAllDataMatches(const Data& data, const name_tree::HashSequence& hashes) const;
+
   /** \brief Deletes an entry
    */
   void
@@ -125,13 +152,18 @@ private:
   /** \brief Finds or inserts a PIT entry for \p interest
    *  \param interest the Interest; must be created with make_shared if allowInsert
    *  \param allowInsert whether inserting a new entry is allowed
+   *  \param hashes name hashes of the Interest computed beforehand, or nullptr
    *  \return if allowInsert, a new or existing entry with same Name+Selectors,
    *          and true for new entry, false for existing entry;
    *          if not allowInsert, an existing entry with same Name+Selectors and false,
    *          or `{nullptr, true}` if there's no existing entry
    */
   std::pair<shared_ptr<Entry>, bool>
-  findOrInsert(const Interest& interest, bool allowInsert);
+  findOrInsert(const Interest& interest, bool allowInsert,
+               const name_tree::HashSequence* hashes = nullptr);
+
+  DataMatchResult
+  collectDataMatches(const Data& data, const name_tree::Range& ntMatches) const;
 
 private:
   NameTree& m_nameTree;
@@ -175,6 +175,12 @@ public: // enumeration
     return this->getRange().end();
   }
 
+public: // signal
+  /** \brief signals on a change of the strategy chosen at a prefix, including the removal
+   *         of the choice
+   */
+  signal::Signal<StrategyChoice, Name> afterChange;
+
 private:
   void
   changeStrategy(Entry& entry,
@@ -28,6 +28,8 @@
 
 #include "fw/strategy-info.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 
 /** \brief Base class for an entity onto which StrategyInfo items may be placed
@@ -46,7 +48,7 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto it = m_items.find(T::getTypeId());
+    auto it = this->find(T::getTypeId());
     if (it == m_items.end()) {
       return nullptr;
     }
@@ -65,12 +67,15 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto& item = m_items[T::getTypeId()];
-    bool isNew = item == nullptr;
-    if (isNew) {
-      item = make_unique<T>(std::forward<A>(args)...);
+    auto it = this->find(T::getTypeId());
+    if (it != m_items.end()) {
+      return {static_cast<T*>(it->second.get()), false};
     }
-    return {static_cast<T*>(item.get()), isNew};
+
+    auto item = make_unique<T>(std::forward<A>(args)...);
+    T* ptr = item.get();
+    m_items.emplace_back(T::getTypeId(), std::move(item));
+    return {ptr, true};
   }
 
   /** \brief Erase a StrategyInfo item
@@ -84,7 +89,12 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    return m_items.erase(T::getTypeId());
+    auto it = this->find(T::getTypeId());
+    if (it == m_items.end()) {
+      return 0;
+    }
+    m_items.erase(it);
+    return 1;
   }
 
   /** \brief Clear all StrategyInfo items
@@ -96,7 +106,22 @@ public:
   }
 
 private:
-  std::unordered_map<int, unique_ptr<fw::StrategyInfo>> m_items;
+  using Items = std::vector<std::pair<int, unique_ptr<fw::StrategyInfo>>>;
+
+  Items::const_iterator
+  find(int typeId) const
+  {
+    return std::find_if(m_items.begin(), m_items.end(),
+                        [typeId] (const auto& item) { return item.first == typeId; });
+  }
+
+private:
+  /** \brief StrategyInfo items, keyed by type ID
+   *
+   *  A host rarely carries more than a few items, so a linear search is faster than a hash
+   *  table, and an empty host does not allocate.
+   */
+  Items m_items;
 };
 
 } // namespace nfd
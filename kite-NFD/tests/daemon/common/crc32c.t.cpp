@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/crc32c.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCrc32c)
+
+BOOST_AUTO_TEST_CASE(KnownValues)
+{
+  // test vectors from RFC 3720 appendix B.4 and the CRC catalogue
+  const std::string digits = "123456789";
+  const std::vector<uint8_t> zeros(32, 0x00);
+  const std::vector<uint8_t> ones(32, 0xFF);
+
+  for (auto f : {&crc32c, &crc32cPortable}) {
+    BOOST_CHECK_EQUAL(f(reinterpret_cast<const uint8_t*>(digits.data()), digits.size(), 0), 0xE3069283);
+    BOOST_CHECK_EQUAL(f(zeros.data(), zeros.size(), 0), 0x8A9136AA);
+    BOOST_CHECK_EQUAL(f(ones.data(), ones.size(), 0), 0x62A8AB43);
+    BOOST_CHECK_EQUAL(f(nullptr, 0, 0), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Incremental)
+{
+  std::vector<uint8_t> buf(100);
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+
+  uint32_t whole = crc32c(buf.data(), buf.size());
+  for (size_t split : {0, 1, 7, 8, 9, 50, 100}) {
+    uint32_t crc = crc32c(buf.data(), split);
+    BOOST_CHECK_EQUAL(crc32c(buf.data() + split, buf.size() - split, crc), whole);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sse42)
+{
+  if (!hasCrc32cInstruction()) {
+    BOOST_WARN_MESSAGE(false, "skipping assertions that require the SSE4.2 CRC32 instruction");
+    return;
+  }
+
+  std::vector<uint8_t> buf(67);
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<uint8_t>(i * 31 + 11);
+  }
+
+  // cover every combination of 8-octet words, a 4-octet word, and single octets
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; offset + length <= buf.size(); ++length) {
+      BOOST_CHECK_EQUAL(crc32cSse42(buf.data() + offset, length, 0x1234),
+                        crc32cPortable(buf.data() + offset, length, 0x1234));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCrc32c
+
+} // namespace tests
+} // namespace nfd
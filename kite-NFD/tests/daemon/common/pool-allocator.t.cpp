@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/pool-allocator.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <list>
+#include <thread>
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestPoolAllocator)
+
+struct Item
+{
+  explicit
+  Item(int v)
+    : value(v)
+  {
+  }
+
+  int value;
+  std::string padding = "padding";
+};
+
+BOOST_AUTO_TEST_CASE(ReuseBlock)
+{
+  PoolAllocator<Item> alloc;
+  Item* p1 = alloc.allocate(1);
+  Item* p2 = alloc.allocate(1);
+  BOOST_CHECK_NE(p1, p2);
+  BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(p1) % alignof(Item), 0);
+
+  alloc.deallocate(p1, 1);
+  Item* p3 = alloc.allocate(1);
+  BOOST_CHECK_EQUAL(p3, p1); // most recently freed block is reused first
+
+  alloc.deallocate(p2, 1);
+  alloc.deallocate(p3, 1);
+
+  // arrays are served by the heap
+  Item* arr = alloc.allocate(3);
+  BOOST_CHECK(arr != nullptr);
+  alloc.deallocate(arr, 3);
+}
+
+BOOST_AUTO_TEST_CASE(Containers)
+{
+  std::list<Item, PoolAllocator<Item>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.emplace_back(i);
+  }
+  BOOST_CHECK_EQUAL(items.size(), 1000);
+  BOOST_CHECK_EQUAL(items.back().value, 999);
+  items.clear();
+
+  auto sp = std::allocate_shared<Item>(PoolAllocator<Item>(), 42);
+  weak_ptr<Item> wp = sp;
+  BOOST_CHECK_EQUAL(sp->value, 42);
+  sp.reset();
+  BOOST_CHECK(wp.expired());
+}
+
+BOOST_AUTO_TEST_CASE(CrossThread)
+{
+  // a block allocated by an exited thread can be freed and reused by another thread
+  std::vector<Item*> blocks;
+  std::thread t([&blocks] {
+    PoolAllocator<Item> alloc;
+    for (int i = 0; i < 10; ++i) {
+      blocks.push_back(new (alloc.allocate(1)) Item(i));
+    }
+  });
+  t.join();
+
+  PoolAllocator<Item> alloc;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    BOOST_CHECK_EQUAL(blocks[i]->value, i);
+    blocks[i]->~Item();
+    alloc.deallocate(blocks[i], 1);
+  }
+  Item* reused = alloc.allocate(1);
+  BOOST_CHECK_EQUAL(reused, blocks.back());
+  alloc.deallocate(reused, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SpillFreeBlocks)
+{
+  const size_t nPerSlab = PoolAllocator<Item>::N_PER_SLAB;
+  const size_t maxFree = PoolAllocator<Item>::MAX_FREE_BLOCKS;
+
+  // blocks allocated by one thread and freed by another do not pile up in the freeing thread
+  PoolAllocator<Item> alloc;
+  std::vector<Item*> blocks;
+  for (size_t i = 0; i < maxFree + nPerSlab; ++i) {
+    blocks.push_back(alloc.allocate(1));
+  }
+  std::thread consumer([&blocks] {
+    PoolAllocator<Item> alloc;
+    for (auto block : blocks) {
+      alloc.deallocate(block, 1);
+    }
+  });
+  consumer.join();
+
+  // the surplus is reused by the next thread that runs out of blocks
+  std::set<Item*> freed(blocks.begin(), blocks.end());
+  size_t nReused = 0;
+  std::thread other([&] {
+    PoolAllocator<Item> alloc;
+    for (size_t i = 0; i < nPerSlab; ++i) {
+      nReused += freed.count(alloc.allocate(1));
+    }
+  });
+  other.join();
+  BOOST_CHECK_EQUAL(nReused, nPerSlab);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPoolAllocator
+
+} // namespace tests
+} // namespace nfd
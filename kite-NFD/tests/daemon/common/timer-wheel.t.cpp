@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common/timer-wheel.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, GlobalIoTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Fire)
+{
+  TimerWheel wheel;
+  TimerWheel::Timer timer;
+  int nFired = 0;
+  wheel.schedule(timer, 10_ms, [&] { ++nFired; });
+  BOOST_CHECK(timer.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  this->advanceClocks(1_ms, 9);
+  BOOST_CHECK_EQUAL(nFired, 0);
+  this->advanceClocks(1_ms, 2);
+  BOOST_CHECK_EQUAL(nFired, 1);
+  BOOST_CHECK(!timer.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+  this->advanceClocks(1_ms, 100);
+  BOOST_CHECK_EQUAL(nFired, 1);
+}
+
+BOOST_AUTO_TEST_CASE(NeverEarly)
+{
+  TimerWheel wheel(5_ms);
+  TimerWheel::Timer timer;
+  auto expiry = time::steady_clock::now() + 7_ms;
+  time::steady_clock::TimePoint firedAt;
+  wheel.schedule(timer, 7_ms, [&] { firedAt = time::steady_clock::now(); });
+
+  this->advanceClocks(500_us, 40);
+  BOOST_CHECK(firedAt >= expiry);
+  BOOST_CHECK(firedAt <= expiry + 5_ms);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroDelay)
+{
+  TimerWheel wheel(100_ms);
+  TimerWheel::Timer timer;
+  int nFired = 0;
+  wheel.schedule(timer, 0_ms, [&] { ++nFired; });
+  BOOST_CHECK_EQUAL(nFired, 0);
+  this->advanceClocks(1_ns);
+  BOOST_CHECK_EQUAL(nFired, 1);
+
+  wheel.schedule(timer, -5_ms, [&] { ++nFired; });
+  this->advanceClocks(1_ns);
+  BOOST_CHECK_EQUAL(nFired, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  TimerWheel wheel;
+  TimerWheel::Timer timer;
+  int nFired = 0;
+  wheel.schedule(timer, 10_ms, [&] { ++nFired; });
+  timer.cancel();
+  BOOST_CHECK(!timer.isPending());
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  timer.cancel(); // no effect
+
+  this->advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(nFired, 0);
+
+  {
+    TimerWheel::Timer scoped;
+    wheel.schedule(scoped, 5_ms, [&] { ++nFired; });
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  this->advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(nFired, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Reschedule)
+{
+  TimerWheel wheel;
+  TimerWheel::Timer timer;
+  int nFiredA = 0;
+  int nFiredB = 0;
+  wheel.schedule(timer, 10_ms, [&] { ++nFiredA; });
+  this->advanceClocks(1_ms, 5);
+  wheel.schedule(timer, 10_ms, [&] { ++nFiredB; });
+  BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+  this->advanceClocks(1_ms, 9);
+  BOOST_CHECK_EQUAL(nFiredA, 0);
+  BOOST_CHECK_EQUAL(nFiredB, 0);
+  this->advanceClocks(1_ms, 2);
+  BOOST_CHECK_EQUAL(nFiredA, 0);
+  BOOST_CHECK_EQUAL(nFiredB, 1);
+
+  // reschedule from the callback
+  int nFired = 0;
+  std::function<void()> again = [&] {
+    if (++nFired < 3) {
+      wheel.schedule(timer, 4_ms, again);
+    }
+  };
+  wheel.schedule(timer, 4_ms, again);
+  this->advanceClocks(1_ms, 20);
+  BOOST_CHECK_EQUAL(nFired, 3);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  TimerWheel wheel(10_ms);
+  std::vector<TimerWheel::Timer> timers(100);
+  std::vector<int> order;
+  for (size_t i = 0; i < timers.size(); ++i) {
+    // all delays round up to the same tick
+    wheel.schedule(timers[i], 11_ms + time::microseconds(i), [&order, i] { order.push_back(i); });
+  }
+  BOOST_CHECK_EQUAL(wheel.size(), 100);
+
+  this->advanceClocks(1_ms, 19);
+  BOOST_CHECK(order.empty());
+  this->advanceClocks(1_ms, 1);
+  BOOST_REQUIRE_EQUAL(order.size(), 100);
+  for (size_t i = 0; i < order.size(); ++i) {
+    BOOST_CHECK_EQUAL(order[i], i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LongDelays)
+{
+  TimerWheel wheel;
+  std::vector<time::milliseconds> delays{1_ms, 63_ms, 64_ms, 65_ms, 4095_ms, 4096_ms, 4097_ms,
+                                         300_s, 5_h};
+  std::vector<TimerWheel::Timer> timers(delays.size());
+  std::vector<time::nanoseconds> lateness(delays.size(), time::nanoseconds::max());
+  auto start = time::steady_clock::now();
+  for (size_t i = 0; i < delays.size(); ++i) {
+    wheel.schedule(timers[i], delays[i], [&, i] {
+      lateness[i] = time::steady_clock::now() - start - delays[i];
+    });
+  }
+
+  this->advanceClocks(1_ms, 5000);
+  this->advanceClocks(100_ms, 3000);
+  this->advanceClocks(1_s, 5 * 3600);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+  for (size_t i = 0; i < delays.size(); ++i) {
+    BOOST_TEST_CONTEXT("delay " << delays[i]) {
+      BOOST_CHECK(lateness[i] >= 0_ns);
+      // bounded by the step of advanceClocks
+      BOOST_CHECK(lateness[i] < (delays[i] < 5_s ? 1_ms : delays[i] < 300_s ? 100_ms : 1_s));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ChangeTick)
+{
+  TimerWheel wheel(1_ms);
+  TimerWheel::Timer timerA;
+  TimerWheel::Timer timerB;
+  int nFiredA = 0;
+  int nFiredB = 0;
+  wheel.schedule(timerA, 30_ms, [&] { ++nFiredA; });
+  wheel.schedule(timerB, 500_ms, [&] { ++nFiredB; });
+  this->advanceClocks(1_ms, 10);
+
+  wheel.setTickDuration(50_ms);
+  BOOST_CHECK_EQUAL(wheel.getTickDuration(), 50_ms);
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  this->advanceClocks(1_ms, 19);
+  BOOST_CHECK_EQUAL(nFiredA, 0);
+  this->advanceClocks(1_ms, 51);
+  BOOST_CHECK_EQUAL(nFiredA, 1);
+  BOOST_CHECK_EQUAL(nFiredB, 0);
+
+  this->advanceClocks(1_ms, 419);
+  BOOST_CHECK_EQUAL(nFiredB, 0);
+  this->advanceClocks(1_ms, 51);
+  BOOST_CHECK_EQUAL(nFiredB, 1);
+}
+
+BOOST_AUTO_TEST_CASE(DestructWheel)
+{
+  TimerWheel::Timer timer;
+  {
+    TimerWheel wheel;
+    wheel.schedule(timer, 10_ms, [] { BOOST_ERROR("timer should not fire"); });
+  }
+  BOOST_CHECK(!timer.isPending());
+  this->advanceClocks(1_ms, 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTimerWheel
+
+} // namespace tests
+} // namespace nfd
@@ -61,6 +61,8 @@ public:
 
   using NullTransport::setMtu;
   using NullTransport::setState;
+  using NullTransport::beginReceiveBurst;
+  using NullTransport::endReceiveBurst;
 
   ssize_t
   getSendQueueLength() override
@@ -137,6 +137,36 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveMultipleBlocks, T, StreamTransportFixtur
   BOOST_CHECK_EQUAL(this->transport->getState(), TransportState::UP);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveBurst, T, StreamTransportFixtures, T)
+{
+  TRANSPORT_TEST_INIT();
+
+  std::vector<size_t> burstEnds;
+  this->transport->afterReceiveBurst.connect([&] {
+    BOOST_CHECK(!this->transport->isReceivingBurst());
+    burstEnds.push_back(this->receivedPackets->size());
+  });
+
+  const size_t nPackets = MAX_RECEIVE_BURST + 8;
+  ndn::Buffer buf;
+  for (size_t i = 0; i < nPackets; ++i) {
+    auto pkt = ndn::encoding::makeStringBlock(300, "hello");
+    buf.insert(buf.end(), pkt.begin(), pkt.end());
+  }
+
+  this->remoteWrite(buf);
+
+  BOOST_CHECK_EQUAL(this->transport->getCounters().nInPackets, nPackets);
+  BOOST_CHECK_EQUAL(this->receivedPackets->size(), nPackets);
+  BOOST_REQUIRE_GE(burstEnds.size(), 2);
+  BOOST_CHECK_EQUAL(burstEnds.back(), nPackets);
+  size_t prev = 0;
+  for (size_t end : burstEnds) {
+    BOOST_CHECK_LE(end - prev, MAX_RECEIVE_BURST);
+    prev = end;
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(ReceiveTooLarge, T, StreamTransportFixtures, T)
 {
   TRANSPORT_TEST_INIT();
@@ -0,0 +1,298 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/forwarder-shards.hpp"
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/kite-strategy.hpp"
+#include "fw/multicast-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace nfd {
+namespace tests {
+
+using fw::ForwarderShards;
+
+class ForwarderShardsFixture : public GlobalIoFixture
+{
+protected:
+  ForwarderShardsFixture()
+  {
+    faceTable.add(face1);
+    faceTable.add(face2);
+
+    ForwarderShards::Options options;
+    options.nShards = 3;
+    shards = make_unique<ForwarderShards>(master, faceTable, options);
+  }
+
+  /** \brief poll the global io_service until \p pred returns true, or give up after about 5 seconds
+   */
+  bool
+  pollUntil(const std::function<bool()>& pred)
+  {
+    for (int i = 0; i < 5000; ++i) {
+      pollIo();
+      if (pred()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  /** \brief count the shards whose Forwarder satisfies \p pred
+   *
+   *  Since a shard processes what is posted to it in order, every change posted before
+   *  this call is visible to \p pred.
+   */
+  size_t
+  countShards(const std::function<bool(Forwarder&)>& pred)
+  {
+    auto n = make_shared<std::atomic<size_t>>(0);
+    bool isDone = false;
+    shards->forEachShard([n, pred] (Forwarder& fw) {
+                           if (pred(fw)) {
+                             ++*n;
+                           }
+                         },
+                         [&] { isDone = true; });
+    BOOST_REQUIRE(pollUntil([&] { return isDone; }));
+    return *n;
+  }
+
+  /** \brief find a Data name under \p prefix that is dispatched to a shard other than \p prefix
+   */
+  Name
+  makeNameOnOtherShard(const Name& prefix)
+  {
+    for (int i = 0; ; ++i) {
+      Name name = Name(prefix).append(to_string(i)).append("data");
+      if (shards->getShardIndex(name) != shards->getShardIndex(prefix)) {
+        return name;
+      }
+    }
+  }
+
+protected:
+  FaceTable faceTable;
+  FaceTable controlFaceTable;
+  Forwarder master{controlFaceTable};
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  unique_ptr<ForwarderShards> shards;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestForwarderShards, ForwarderShardsFixture)
+
+BOOST_AUTO_TEST_CASE(ParseConfig)
+{
+  ConfigSection section;
+  auto options = ForwarderShards::parseConfig(section);
+  BOOST_CHECK_EQUAL(options.nShards, 0);
+  BOOST_CHECK_EQUAL(options.dispatchPrefixLength, 2);
+
+  section.put("default_hop_limit", 10);
+  section.put("threads", 4);
+  section.put("dispatch_prefix_length", 3);
+  options = ForwarderShards::parseConfig(section);
+  BOOST_CHECK_EQUAL(options.nShards, 4);
+  BOOST_CHECK_EQUAL(options.dispatchPrefixLength, 3);
+
+  section.put("dispatch_prefix_length", 0);
+  BOOST_CHECK_THROW(ForwarderShards::parseConfig(section), ConfigFile::Error);
+  section.put("dispatch_prefix_length", "x");
+  BOOST_CHECK_THROW(ForwarderShards::parseConfig(section), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ParseConfigKiteStrategy)
+{
+  BOOST_CHECK_EQUAL(ForwarderShards::canRunStrategy("/localhost/nfd/strategy/best-route"), true);
+  BOOST_CHECK_EQUAL(ForwarderShards::canRunStrategy("/localhost/nfd/strategy/kite"), false);
+  BOOST_CHECK_EQUAL(ForwarderShards::canRunStrategy(fw::KiteStrategy::getStrategyName()), false);
+
+  ConfigSection section;
+  section.put("threads", 2);
+  ConfigSection tablesSection;
+  tablesSection.put("strategy_choice./", "/localhost/nfd/strategy/best-route");
+  BOOST_CHECK_NO_THROW(ForwarderShards::parseConfig(section, tablesSection));
+
+  // KITE strategies are rejected only together with forwarding threads
+  tablesSection.put("strategy_choice./mp", "/localhost/nfd/strategy/kite");
+  BOOST_CHECK_THROW(ForwarderShards::parseConfig(section, tablesSection), ConfigFile::Error);
+  BOOST_CHECK_THROW(ForwarderShards::checkStrategyChoices(tablesSection), ConfigFile::Error);
+  section.put("threads", 0);
+  BOOST_CHECK_NO_THROW(ForwarderShards::parseConfig(section, tablesSection));
+}
+
+BOOST_AUTO_TEST_CASE(ShardIndex)
+{
+  BOOST_CHECK_EQUAL(shards->size(), 3);
+
+  size_t index = shards->getShardIndex("/A/B");
+  BOOST_CHECK_LT(index, shards->size());
+  BOOST_CHECK_EQUAL(shards->getShardIndex("/A/B/C"), index);
+  BOOST_CHECK_EQUAL(shards->getShardIndex("/A/B/C/D"), index);
+
+  // the implicit digest is not part of the dispatch prefix
+  auto data = makeData("/A");
+  Name fullName = data->getFullName();
+  BOOST_CHECK_EQUAL(shards->getShardIndex(fullName), shards->getShardIndex("/A"));
+}
+
+BOOST_AUTO_TEST_CASE(InterestData)
+{
+  fib::Entry* entry = master.getFib().insert("/A").first;
+  master.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) {
+    auto e = fw.getFib().findExactMatch("/A");
+    return e != nullptr && e->getNextHops().size() == 1 &&
+           e->getNextHops().front().getCost() == 10;
+  }), 3);
+
+  face1->receiveInterest(*makeInterest("/A/B/C"), 0);
+  BOOST_REQUIRE(pollUntil([&] { return face2->sentInterests.size() == 1; }));
+  BOOST_CHECK_EQUAL(face2->sentInterests.back().getName(), "/A/B/C");
+
+  face2->receiveData(*makeData("/A/B/C"), 0);
+  BOOST_REQUIRE(pollUntil([&] { return face1->sentData.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentData.back().getName(), "/A/B/C");
+}
+
+BOOST_AUTO_TEST_CASE(ShortNameInterest)
+{
+  fib::Entry* entry = master.getFib().insert("/A").first;
+  master.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) { return fw.getFib().findExactMatch("/A") != nullptr; }), 3);
+
+  // Interest /A is dispatched by a shorter prefix than the Data that satisfies it
+  Name dataName = makeNameOnOtherShard("/A");
+  face1->receiveInterest(*makeInterest("/A", true), 0);
+  BOOST_REQUIRE(pollUntil([&] { return face2->sentInterests.size() == 1; }));
+
+  face2->receiveData(*makeData(dataName), 0);
+  BOOST_REQUIRE(pollUntil([&] { return face1->sentData.size() == 1; }));
+  BOOST_CHECK_EQUAL(face1->sentData.back().getName(), dataName);
+
+  // only the shard holding the PIT entry accepts the copy of the Data
+  BOOST_CHECK_EQUAL(countShards([&] (Forwarder& fw) { return fw.getCounters().nInData > 0; }), 2);
+}
+
+BOOST_AUTO_TEST_CASE(FaceRemoval)
+{
+  auto face3 = make_shared<DummyFace>();
+  faceTable.add(face3);
+
+  fib::Entry* entry = master.getFib().insert("/A").first;
+  master.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  master.getFib().addOrUpdateNextHop(*entry, *face3, 20);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) {
+    auto e = fw.getFib().findExactMatch("/A");
+    return e != nullptr && e->getNextHops().size() == 2;
+  }), 3);
+
+  face3->setState(face::FaceState::DOWN);
+  face2->close();
+  BOOST_CHECK(master.getFib().findExactMatch("/A")->getNextHops().size() == 1);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) {
+    auto e = fw.getFib().findExactMatch("/A");
+    return e != nullptr && e->getNextHops().size() == 1 &&
+           e->getNextHops().front().getFace().getState() == face::FaceState::DOWN;
+  }), 3);
+
+  face3->close();
+  BOOST_CHECK(master.getFib().findExactMatch("/A") == nullptr);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) { return fw.getFib().findExactMatch("/A") == nullptr; }), 3);
+
+  // packets received from a closed face are not dispatched
+  face3->receiveInterest(*makeInterest("/A/B"), 0);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) { return fw.getCounters().nInInterests > 0; }), 0);
+}
+
+BOOST_AUTO_TEST_CASE(StrategyChoiceReplication)
+{
+  const Name& strategyName = fw::MulticastStrategy::getStrategyName();
+  BOOST_REQUIRE(master.getStrategyChoice().insert("/S", strategyName));
+  BOOST_CHECK_EQUAL(countShards([&] (Forwarder& fw) {
+    auto res = fw.getStrategyChoice().get("/S");
+    return res.first && res.second == strategyName;
+  }), 3);
+
+  master.getStrategyChoice().erase("/S");
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) { return !fw.getStrategyChoice().get("/S").first; }), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Status)
+{
+  fib::Entry* entry = master.getFib().insert("/").first;
+  master.getFib().addOrUpdateNextHop(*entry, *face2, 10);
+  BOOST_CHECK_EQUAL(countShards([] (Forwarder& fw) { return fw.getFib().findExactMatch("/") != nullptr; }), 3);
+
+  for (int i = 0; i < 10; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/P").appendNumber(i)), 0);
+  }
+  BOOST_REQUIRE(pollUntil([&] { return face2->sentInterests.size() == 10; }));
+
+  bool isDone = false;
+  shards->refreshStatus([&] { isDone = true; });
+  BOOST_REQUIRE(pollUntil([&] { return isDone; }));
+
+  const auto& status = shards->getStatus();
+  BOOST_CHECK_EQUAL(status.nInInterests, 10);
+  BOOST_CHECK_EQUAL(status.nOutInterests, 10);
+  BOOST_CHECK_EQUAL(status.nPitEntries, 10);
+  BOOST_CHECK_EQUAL(status.nQueueDrops, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ShardFailure)
+{
+  // an exception on a shard thread ends the thread and stops the main io_service
+  shards->runOnShard(0, [] (Forwarder&) { NDN_THROW(std::runtime_error("shard failure")); });
+  bool isStopped = false;
+  for (int i = 0; i < 5000 && !isStopped; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    isStopped = g_io.stopped();
+  }
+  BOOST_REQUIRE(isStopped);
+
+  // the io_service of the shard outlives its thread
+  bool isRun = false;
+  shards->runOnShard(0, [&isRun] (Forwarder&) { isRun = true; });
+  BOOST_CHECK_NO_THROW(shards.reset());
+  BOOST_CHECK(!isRun);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestForwarderShards
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace nfd
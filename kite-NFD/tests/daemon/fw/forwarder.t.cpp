@@ -29,6 +29,7 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
+#include "tests/daemon/face/dummy-transport.hpp"
 #include "choose-strategy.hpp"
 #include "dummy-strategy.hpp"
 
@@ -98,6 +99,56 @@ BOOST_AUTO_TEST_CASE(SimpleExchange)
   BOOST_CHECK_EQUAL(forwarder.getCounters().nUnsolicitedData, 0);
 }
 
+BOOST_AUTO_TEST_CASE(ReceiveBurst)
+{
+  auto face1 = addFace();
+  auto face2 = addFace();
+  auto transport1 = static_cast<face::tests::DummyTransport*>(face1->getTransport());
+  auto transport2 = static_cast<face::tests::DummyTransport*>(face2->getTransport());
+
+  Fib& fib = forwarder.getFib();
+  fib::Entry* entry = fib.insert("/A").first;
+  fib.addOrUpdateNextHop(*entry, *face2, 0);
+
+  // packets received in a burst are held until the burst ends
+  transport1->beginReceiveBurst();
+  face1->receiveInterest(*makeInterest("/A/1"), 0);
+  face1->receiveInterest(*makeInterest("/A/2"), 0);
+  face1->receiveInterest(*makeInterest("/B/3"), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 0);
+  BOOST_CHECK_EQUAL(face2->sentInterests.size(), 0);
+  transport1->endReceiveBurst();
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3);
+  BOOST_REQUIRE_EQUAL(face2->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face2->sentInterests[0].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(face2->sentInterests[1].getName(), "/A/2");
+  BOOST_CHECK_EQUAL(face1->sentNacks.size(), 1);
+
+  // Data and Nacks in the same burst are processed in arrival order
+  transport2->beginReceiveBurst();
+  face2->receiveData(*makeData("/A/2"), 0);
+  face2->receiveNack(makeNack(face2->sentInterests[0], lp::NackReason::CONGESTION), 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 0);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInNacks, 0);
+  transport2->endReceiveBurst();
+
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInData, 1);
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInNacks, 1);
+  BOOST_REQUIRE_EQUAL(face1->sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face1->sentData[0].getName(), "/A/2");
+  BOOST_CHECK_EQUAL(face1->sentNacks.size(), 2);
+
+  // a burst larger than MAX_RECEIVE_BURST is processed in several parts
+  transport1->beginReceiveBurst();
+  for (size_t i = 0; i < face::MAX_RECEIVE_BURST + 1; ++i) {
+    face1->receiveInterest(*makeInterest(Name("/A/burst").appendNumber(i)), 0);
+  }
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3 + face::MAX_RECEIVE_BURST);
+  transport1->endReceiveBurst();
+  BOOST_CHECK_EQUAL(forwarder.getCounters().nInInterests, 3 + face::MAX_RECEIVE_BURST + 1);
+}
+
 BOOST_AUTO_TEST_CASE(CsMatched)
 {
   auto face1 = addFace();
@@ -876,6 +927,57 @@ BOOST_AUTO_TEST_CASE(BadDefaultHopLimit)
   BOOST_CHECK_THROW(cf.parse(config, false, "dummy-config"), ConfigFile::Error);
 }
 
+BOOST_AUTO_TEST_CASE(PitTimerTick)
+{
+  ConfigFile cf;
+  forwarder.setConfigFile(cf);
+
+  std::string config = R"CONFIG(
+    forwarder
+    {
+      pit_timer_tick 20
+    }
+  )CONFIG";
+
+  // The default value is 1ms
+  BOOST_TEST(forwarder.m_config.pitTimerTick == 1_ms);
+  BOOST_TEST(forwarder.m_pitExpiry.getTickDuration() == 1_ms);
+
+  cf.parse(config, true, "dummy-config");
+  BOOST_TEST(forwarder.m_pitExpiry.getTickDuration() == 1_ms);
+
+  cf.parse(config, false, "dummy-config");
+  BOOST_TEST(forwarder.m_config.pitTimerTick == 20_ms);
+  BOOST_TEST(forwarder.m_pitExpiry.getTickDuration() == 20_ms);
+
+  // PIT entries are expired on the coarser ticks
+  auto face1 = addFace();
+  auto face2 = addFace();
+  fib::Entry* entry = forwarder.getFib().insert("/A").first;
+  forwarder.getFib().addOrUpdateNextHop(*entry, *face2, 0);
+  face1->receiveInterest(*makeInterest("/A", false, 50_ms), 0);
+  this->advanceClocks(1_ms, 50);
+  BOOST_TEST(forwarder.getPit().size() == 1);
+  this->advanceClocks(1_ms, 20);
+  BOOST_TEST(forwarder.getPit().size() == 0);
+
+  config = R"CONFIG(
+    forwarder
+    {
+      pit_timer_tick 0
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+
+  config = R"CONFIG(
+    forwarder
+    {
+      pit_timer_tick 1001
+    }
+  )CONFIG";
+  BOOST_CHECK_THROW(cf.parse(config, true, "dummy-config"), ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // ProcessConfig
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarder
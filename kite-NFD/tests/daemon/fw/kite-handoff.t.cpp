@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-handoff.hpp"
+#include "table/pit.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+namespace tests {
+
+using namespace nfd::tests;
+
+class HandoffFixture : public GlobalIoTimeFixture
+{
+protected:
+  HandoffFixture()
+    : pit(nameTree)
+  {
+    options.batchSize = 2;
+    options.batchInterval = 10_ms;
+    options.rate = 100;
+    options.burst = 2;
+  }
+
+  shared_ptr<pit::Entry>
+  insertPending(const Name& name, time::milliseconds lifetime)
+  {
+    auto interest = makeInterest(name, false, lifetime);
+    auto entry = pit.insert(*interest).first;
+    entry->insertOrUpdateInRecord(downstream, *interest);
+    return entry;
+  }
+
+  HandoffReforwarder::SendInterest
+  makeSend()
+  {
+    return [this] (const shared_ptr<pit::Entry>& pitEntry, FaceId faceId) {
+      if (faceId != 1) {
+        return false;
+      }
+      sent.push_back(pitEntry->getName());
+      return true;
+    };
+  }
+
+protected:
+  NameTree nameTree;
+  Pit pit;
+  DummyFace downstream;
+  HandoffReforwarder::Options options;
+  std::vector<Name> sent;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestKiteHandoff, HandoffFixture)
+
+BOOST_AUTO_TEST_CASE(PacedByExpiry)
+{
+  HandoffReforwarder handoff(makeSend(), options);
+  handoff.enqueue(1, {insertPending("/mp/A", 4_s), insertPending("/mp/B", 1_s),
+                      insertPending("/mp/C", 3_s), insertPending("/mp/D", 2_s),
+                      insertPending("/mp/E", 500_ms)});
+
+  // first batch uses the full bucket
+  BOOST_CHECK_EQUAL(sent.size(), 2);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 3);
+
+  // one token is refilled every 10ms
+  this->advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(sent.size(), 3);
+  this->advanceClocks(10_ms, 2);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 0);
+
+  std::vector<Name> expected{"/mp/E", "/mp/B", "/mp/D", "/mp/C", "/mp/A"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(handoff.getCounters().nReforwarded, 5);
+  BOOST_CHECK_EQUAL(handoff.getCounters().nExpiredBeforeResend, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DeduplicateAndExpire)
+{
+  options.burst = 1;
+  HandoffReforwarder handoff(makeSend(), options);
+  auto entryA = insertPending("/mp/A", 100_ms);
+  auto entryB = insertPending("/mp/B", 200_ms);
+  auto entryC = insertPending("/mp/C", 300_ms);
+
+  handoff.enqueue(1, {entryA, entryB, entryC});
+  BOOST_CHECK_EQUAL(sent.size(), 1);
+  handoff.enqueue(1, {entryB, entryC});
+  BOOST_CHECK_EQUAL(handoff.getCounters().nDeduplicated, 2);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 2);
+
+  // entryB is satisfied before its turn
+  entryB->clearInRecords();
+  this->advanceClocks(10_ms, 2);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 0);
+  std::vector<Name> expected{"/mp/A", "/mp/C"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(handoff.getCounters().nReforwarded, 2);
+  BOOST_CHECK_EQUAL(handoff.getCounters().nExpiredBeforeResend, 1);
+
+  // once drained, the same entry may be queued again
+  handoff.enqueue(1, {entryA});
+  this->advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(handoff.getCounters().nReforwarded, 3);
+  BOOST_CHECK_EQUAL(handoff.getCounters().nDeduplicated, 2);
+}
+
+BOOST_AUTO_TEST_CASE(FaceGone)
+{
+  HandoffReforwarder handoff(makeSend(), options);
+  handoff.enqueue(2, {insertPending("/mp/A", 1_s), insertPending("/mp/B", 1_s),
+                      insertPending("/mp/C", 1_s)});
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(2), 0);
+  BOOST_CHECK(sent.empty());
+
+  handoff.enqueue(1, {insertPending("/mp/A", 1_s), insertPending("/mp/B", 1_s),
+                      insertPending("/mp/C", 1_s)});
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 1);
+  handoff.cancel(1);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 0);
+  this->advanceClocks(10_ms, 5);
+  BOOST_CHECK_EQUAL(sent.size(), 2);
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CancelPitEntries)
+{
+  HandoffReforwarder handoff(makeSend(), options);
+  auto entryA = insertPending("/mp/A", 1_s);
+  auto entryB = insertPending("/mp/B", 2_s);
+  auto entryC = insertPending("/mp/C", 3_s);
+  auto entryD = insertPending("/mp/D", 4_s);
+  handoff.enqueue(1, {entryA, entryB, entryC, entryD});
+  BOOST_CHECK_EQUAL(sent.size(), 2);
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 2);
+
+  // entries that are not queued are ignored
+  handoff.cancel(1, {entryA, entryC});
+  BOOST_CHECK_EQUAL(handoff.getQueueLength(1), 1);
+  this->advanceClocks(10_ms, 5);
+  std::vector<Name> expected{"/mp/A", "/mp/B", "/mp/D"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(handoff.getCounters().nExpiredBeforeResend, 0);
+
+  // cancelling every queued entry drops the queue
+  handoff.enqueue(1, {entryA, entryB, entryC, entryD});
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 1);
+  handoff.cancel(1, {entryC, entryD});
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 0);
+  this->advanceClocks(10_ms, 5);
+  BOOST_CHECK_EQUAL(sent.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(DrainedQueuesErased)
+{
+  HandoffReforwarder handoff(makeSend(), options);
+  handoff.enqueue(1, {insertPending("/mp/A", 1_s)});
+  BOOST_CHECK_EQUAL(sent.size(), 1);
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 0);
+
+  handoff.enqueue(1, {insertPending("/mp/B", 1_s), insertPending("/mp/C", 1_s),
+                      insertPending("/mp/D", 1_s)});
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 1);
+  this->advanceClocks(10_ms, 5);
+  BOOST_CHECK_EQUAL(sent.size(), 4);
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 0);
+
+  // an empty enqueue creates no queue
+  handoff.enqueue(3, {});
+  BOOST_CHECK_EQUAL(handoff.getNQueues(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidOptions)
+{
+  options.rate = 0;
+  BOOST_CHECK_THROW(HandoffReforwarder(makeSend(), options), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteHandoff
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-measurements.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/fw/choose-strategy.hpp"
+#include "tests/daemon/fw/dummy-strategy.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+namespace tests {
+
+using namespace nfd::tests;
+
+class KiteMeasurementsTestStrategy : public DummyStrategy
+{
+public:
+  static void
+  registerAs(const Name& strategyName)
+  {
+    registerAsImpl<KiteMeasurementsTestStrategy>(strategyName);
+  }
+
+  KiteMeasurementsTestStrategy(Forwarder& forwarder, const Name& name)
+    : DummyStrategy(forwarder, name)
+  {
+  }
+
+  MeasurementsAccessor&
+  getMeasurementsAccessor()
+  {
+    return this->getMeasurements();
+  }
+};
+
+class KiteMeasurementsFixture : public GlobalIoTimeFixture
+{
+protected:
+  KiteMeasurementsFixture()
+  {
+    const auto strategyName = Name("/kite-measurements-test-strategy").appendVersion(1);
+    KiteMeasurementsTestStrategy::registerAs(strategyName);
+    accessor = &choose<KiteMeasurementsTestStrategy>(forwarder, "/rv", strategyName)
+                 .getMeasurementsAccessor();
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  MeasurementsAccessor* accessor;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestKiteMeasurements, KiteMeasurementsFixture)
+
+BOOST_AUTO_TEST_CASE(RvInfoCost)
+{
+  RvInfo info(make_shared<ndn::util::RttEstimator::Options>());
+  BOOST_CHECK_EQUAL(info.hasRttMeasurement(), false);
+  BOOST_CHECK_EQUAL(info.getCost(), 1_s);
+
+  info.recordRtt(100_ms);
+  BOOST_CHECK_EQUAL(info.hasRttMeasurement(), true);
+  BOOST_CHECK_EQUAL(info.getSrtt(), 100_ms);
+  BOOST_CHECK_EQUAL(info.getCost(), 100_ms);
+
+  info.recordNack();
+  BOOST_CHECK_CLOSE(info.getNackRate(), RvInfo::NACK_RATE_WEIGHT, 0.001);
+  BOOST_CHECK_EQUAL(info.getCost(), 150_ms);
+
+  auto rto = info.getRto();
+  info.recordTimeout();
+  BOOST_CHECK_EQUAL(info.getRto(), rto * 2);
+  BOOST_CHECK_GT(info.getNackRate(), RvInfo::NACK_RATE_WEIGHT);
+
+  info.recordRtt(100_ms);
+  BOOST_CHECK_LT(info.getNackRate(), RvInfo::NACK_RATE_WEIGHT * 2);
+}
+
+BOOST_AUTO_TEST_CASE(Rank)
+{
+  KiteMeasurements measurements(*accessor);
+  const Name interestName("/rv/producer/data");
+  BOOST_CHECK(measurements.getOrCreateRvInfo("/other/A", "/other/data") == nullptr);
+  BOOST_CHECK(measurements.getRvInfo("/rv/A", interestName) == nullptr);
+  BOOST_CHECK_EQUAL(measurements.getRvTimeout("/rv/A", interestName), 1_s);
+
+  std::vector<Name> hints{"/rv/A", "/rv/B", "/rv/C", "/other"};
+
+  // without measurements the ForwardingHint order is kept
+  auto ranked = measurements.rankRvs(hints, interestName);
+  BOOST_CHECK_EQUAL_COLLECTIONS(ranked.begin(), ranked.end(), hints.begin(), hints.end());
+
+  measurements.getOrCreateRvInfo("/rv/B", interestName)->recordRtt(50_ms);
+  measurements.getOrCreateRvInfo("/rv/C", interestName)->recordRtt(20_ms);
+  ranked = measurements.rankRvs(hints, interestName);
+  std::vector<Name> expected{"/rv/C", "/rv/B", "/rv/A", "/other"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ranked.begin(), ranked.end(), expected.begin(), expected.end());
+
+  // a Nacking RV falls behind a slower one
+  for (int i = 0; i < 10; ++i) {
+    measurements.getRvInfo("/rv/C", interestName)->recordNack();
+  }
+  ranked = measurements.rankRvs(hints, interestName);
+  BOOST_CHECK_EQUAL(ranked.front(), "/rv/B");
+  BOOST_CHECK_EQUAL(measurements.getRvTimeout("/rv/B", interestName),
+                    measurements.getRvInfo("/rv/B", interestName)->getRto());
+
+  this->advanceClocks(KiteMeasurements::MEASUREMENTS_LIFETIME + 1_s);
+  BOOST_CHECK(measurements.getRvInfo("/rv/B", interestName) == nullptr); // expired
+}
+
+BOOST_AUTO_TEST_CASE(RvOutsideNamespace)
+{
+  KiteMeasurements measurements(*accessor);
+  const Name interestName("/rv/producer/data");
+  BOOST_CHECK(measurements.getRvInfo("/other/A", interestName) == nullptr);
+
+  // the RV prefix belongs to another strategy, its RvInfo is kept in the KITE namespace
+  auto* infoA = measurements.getOrCreateRvInfo("/other/A", interestName);
+  BOOST_REQUIRE(infoA != nullptr);
+  BOOST_CHECK_EQUAL(measurements.getOrCreateRvInfo("/other/A", interestName), infoA);
+  BOOST_CHECK_EQUAL(measurements.getRvInfo("/other/A", interestName), infoA);
+  BOOST_CHECK(accessor->findExactMatch("/other/A") == nullptr);
+
+  // another Interest of the namespace finds the same RvInfo
+  BOOST_CHECK_EQUAL(measurements.getRvInfo("/other/A", "/rv/producer/other-data"), infoA);
+
+  infoA->recordRtt(50_ms);
+  measurements.getOrCreateRvInfo("/other/B", interestName)->recordRtt(20_ms);
+  std::vector<Name> hints{"/other/A", "/other/B", "/other/C"};
+  auto ranked = measurements.rankRvs(hints, interestName);
+  std::vector<Name> expected{"/other/B", "/other/A", "/other/C"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(ranked.begin(), ranked.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(measurements.getRvTimeout("/other/A", interestName), infoA->getRto());
+
+  this->advanceClocks(KiteMeasurements::MEASUREMENTS_LIFETIME + 1_s);
+  BOOST_CHECK(measurements.getRvInfo("/other/A", interestName) == nullptr); // expired
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteMeasurements
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-pending-interests.hpp"
+#include "table/pit.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestKitePendingInterests, GlobalIoFixture)
+
+BOOST_AUTO_TEST_CASE(InsertErase)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  auto entryA = pit.insert(*makeInterest("/mp/A")).first;
+  auto entryB = pit.insert(*makeInterest("/mp/B")).first;
+  auto entryB2 = pit.insert(*makeInterest("/mp/B", true)).first;
+  BOOST_REQUIRE_NE(entryB, entryB2);
+
+  PendingInterestTable table;
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK_EQUAL(table.insert(entryA), true);
+  BOOST_CHECK_EQUAL(table.insert(entryA), false);
+  BOOST_CHECK_EQUAL(table.insert(entryB), true);
+  BOOST_CHECK_EQUAL(table.insert(entryB2), true);
+  BOOST_CHECK_EQUAL(table.size(), 3);
+
+  auto record = entryB->getStrategyInfo<PendingInterestRecord>();
+  BOOST_REQUIRE(record != nullptr);
+  BOOST_CHECK_EQUAL(record->getHash(), nameTree.getEntry(*entryB)->getHash());
+  BOOST_CHECK_EQUAL(record->getHash(), entryB2->getStrategyInfo<PendingInterestRecord>()->getHash());
+
+  BOOST_CHECK_EQUAL(table.erase(*entryB), true);
+  BOOST_CHECK_EQUAL(table.erase(*entryB), false);
+  BOOST_CHECK(!table.contains(*entryB));
+  BOOST_CHECK(table.contains(*entryB2));
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  auto entries = table.getPitEntries();
+  BOOST_CHECK_EQUAL(entries.size(), 2);
+  BOOST_CHECK(std::find(entries.begin(), entries.end(), entryA) != entries.end());
+  BOOST_CHECK(std::find(entries.begin(), entries.end(), entryB2) != entries.end());
+}
+
+BOOST_AUTO_TEST_CASE(ExpireWithPitEntry)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  PendingInterestTable table;
+
+  auto entry = pit.insert(*makeInterest("/mp/A")).first;
+  table.insert(entry);
+  BOOST_CHECK_EQUAL(table.size(), 1);
+
+  pit.erase(entry.get());
+  BOOST_CHECK_EQUAL(table.size(), 1); // still referenced by this test
+  entry.reset();
+  BOOST_CHECK_EQUAL(table.size(), 0);
+  BOOST_CHECK(table.getPitEntries().empty());
+
+  entry = pit.insert(*makeInterest("/mp/A")).first;
+  table.insert(entry);
+  entry->clearStrategyInfo();
+  BOOST_CHECK_EQUAL(table.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(MoveBetweenTables)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  auto entry = pit.insert(*makeInterest("/mp/A")).first;
+
+  PendingInterestTable table1;
+  table1.insert(entry);
+  {
+    PendingInterestTable table2;
+    BOOST_CHECK_EQUAL(table2.insert(entry), true);
+    BOOST_CHECK_EQUAL(table1.size(), 0);
+    BOOST_CHECK_EQUAL(table2.size(), 1);
+    BOOST_CHECK(table2.contains(*entry));
+  }
+
+  // table2 is gone, the record must not refer to it anymore
+  auto record = entry->getStrategyInfo<PendingInterestRecord>();
+  BOOST_REQUIRE(record != nullptr);
+  BOOST_CHECK(record->getTable() == nullptr);
+  BOOST_CHECK_EQUAL(table1.insert(entry), true);
+  BOOST_CHECK_EQUAL(table1.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKitePendingInterests
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-rib-updates.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+namespace tests {
+
+using namespace nfd::tests;
+
+class RibUpdatesFixture : public GlobalIoTimeFixture
+{
+protected:
+  RibUpdatesFixture()
+    : coalescer([this] (std::vector<RouteUpdate> batch, RibUpdateCoalescer::DoneCallback cb) {
+        batches.push_back(std::move(batch));
+        done = std::move(cb);
+      })
+  {
+    coalescer.setWindow(10_ms);
+  }
+
+protected:
+  std::vector<std::vector<RouteUpdate>> batches;
+  RibUpdateCoalescer::DoneCallback done;
+  RibUpdateCoalescer coalescer;
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestKiteRibUpdates, RibUpdatesFixture)
+
+BOOST_AUTO_TEST_CASE(Coalesce)
+{
+  auto paA = makePrefixAnn("/mp/A", 1_h);
+  auto paB = makePrefixAnn("/mp/B", 1_h);
+
+  coalescer.announce(paA, 1, 5_min);
+  coalescer.announce(paB, 1, 5_min);
+  coalescer.withdraw("/mp/A", 1);
+  coalescer.announce(paA, 2, 5_min);
+  coalescer.withdraw("/mp/B", 1);
+  coalescer.announce(paB, 1, 5_min);
+  BOOST_CHECK_EQUAL(coalescer.getNPending(), 3);
+  BOOST_CHECK(batches.empty());
+
+  this->advanceClocks(5_ms, 2);
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  const auto& batch = batches.front();
+  BOOST_REQUIRE_EQUAL(batch.size(), 3);
+  // ordered by (prefix, face)
+  BOOST_CHECK(batch[0].action == RouteUpdate::Action::WITHDRAW);
+  BOOST_CHECK_EQUAL(batch[0].prefix, "/mp/A");
+  BOOST_CHECK_EQUAL(batch[0].faceId, 1);
+  BOOST_CHECK(batch[1].action == RouteUpdate::Action::ANNOUNCE);
+  BOOST_CHECK_EQUAL(batch[1].prefix, "/mp/A");
+  BOOST_CHECK_EQUAL(batch[1].faceId, 2);
+  BOOST_CHECK(batch[2].action == RouteUpdate::Action::ANNOUNCE);
+  BOOST_CHECK_EQUAL(batch[2].prefix, "/mp/B");
+  BOOST_REQUIRE(batch[2].announcement);
+  BOOST_CHECK_EQUAL(batch[2].announcement->getAnnouncedName(), "/mp/B");
+
+  const auto& stats = coalescer.getStats();
+  BOOST_CHECK_EQUAL(stats.nRequested, 6);
+  BOOST_CHECK_EQUAL(stats.nCoalesced, 3);
+  BOOST_CHECK_EQUAL(stats.nBatches, 1);
+  BOOST_CHECK_EQUAL(coalescer.getNPending(), 0);
+
+  // a new window starts with the next update
+  coalescer.withdraw("/mp/A", 2);
+  coalescer.flush();
+  BOOST_CHECK_EQUAL(batches.size(), 2);
+  this->advanceClocks(5_ms, 4);
+  BOOST_CHECK_EQUAL(batches.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceFromAck)
+{
+  auto paData = makeData("/mp/A/32=PA/v=1/seg=0")->wireEncode();
+  coalescer.announce("/mp/A", paData, 1, 5_min);
+  coalescer.flush();
+
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE_EQUAL(batches[0].size(), 1);
+  const auto& update = batches[0][0];
+  BOOST_CHECK(update.action == RouteUpdate::Action::ANNOUNCE);
+  BOOST_CHECK_EQUAL(update.prefix, "/mp/A");
+  BOOST_CHECK(!update.announcement);
+  // the encoded announcement is passed on without a copy
+  BOOST_CHECK(update.announcementData.getBuffer() == paData.getBuffer());
+}
+
+BOOST_AUTO_TEST_CASE(InstallLatency)
+{
+  std::vector<std::pair<Name, time::nanoseconds>> installed;
+  coalescer.afterInstall.connect([&] (const RouteUpdate& update, time::nanoseconds latency) {
+    installed.emplace_back(update.prefix, latency);
+  });
+
+  coalescer.announce(makePrefixAnn("/mp/A", 1_h), 1, 5_min);
+  coalescer.announce(makePrefixAnn("/mp/B", 1_h), 1, 5_min);
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE(done != nullptr);
+
+  this->advanceClocks(20_ms);
+  done(batches[0][0], true);
+  this->advanceClocks(30_ms);
+  done(batches[0][1], false);
+
+  const auto& stats = coalescer.getStats();
+  BOOST_CHECK_EQUAL(stats.nInstalled, 1);
+  BOOST_CHECK_EQUAL(stats.nFailed, 1);
+  BOOST_CHECK_EQUAL(stats.lastInstallLatency, 30_ms);
+  BOOST_CHECK_EQUAL(stats.maxInstallLatency, 30_ms);
+  BOOST_CHECK_EQUAL(stats.totalInstallLatency, 30_ms);
+
+  BOOST_REQUIRE_EQUAL(installed.size(), 1);
+  BOOST_CHECK_EQUAL(installed[0].first, "/mp/A");
+  BOOST_CHECK_EQUAL(installed[0].second, 30_ms);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidWindow)
+{
+  BOOST_CHECK_THROW(coalescer.setWindow(-1_ms), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteRibUpdates
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace kite
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-route-lifetime.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace kite {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_AUTO_TEST_SUITE(TestKiteRouteLifetime)
+
+BOOST_AUTO_TEST_CASE(NoHandoff)
+{
+  RouteLifetimeEstimator::Options options;
+  options.minLifetime = 1_s;
+  options.maxLifetime = 300_s;
+
+  RouteLifetimeEstimator estimator;
+  auto t0 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0), 300_s);
+
+  estimator.addAck(false, t0);
+  estimator.addAck(false, t0 + 10_s);
+  BOOST_CHECK_EQUAL(estimator.hasDwellTime(), false);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 10_s), 300_s);
+}
+
+BOOST_AUTO_TEST_CASE(DwellTime)
+{
+  RouteLifetimeEstimator::Options options;
+  options.minLifetime = 1_s;
+  options.maxLifetime = 300_s;
+
+  RouteLifetimeEstimator estimator;
+  auto t0 = time::steady_clock::now();
+  estimator.addAck(false, t0);
+  estimator.addAck(true, t0 + 20_s);
+  BOOST_REQUIRE_EQUAL(estimator.hasDwellTime(), true);
+  BOOST_CHECK_EQUAL(estimator.getDwellTime(), 20_s);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 20_s), 20_s);
+
+  // smoothed: 20s * 0.75 + 60s * 0.25
+  estimator.addAck(true, t0 + 80_s);
+  BOOST_CHECK_EQUAL(estimator.getDwellTime(), 30_s);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 80_s), 30_s);
+
+  // attached longer than the dwell time
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 130_s), 50_s);
+
+  // clamped to the bounds
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 1000_s), 300_s);
+  estimator.addAck(true, t0 + 80_s + 100_ms);
+  estimator.addAck(true, t0 + 80_s + 200_ms);
+  estimator.addAck(true, t0 + 80_s + 300_ms);
+  estimator.addAck(true, t0 + 80_s + 400_ms);
+  estimator.addAck(true, t0 + 80_s + 500_ms);
+  estimator.addAck(true, t0 + 80_s + 600_ms);
+  estimator.addAck(true, t0 + 80_s + 700_ms);
+  estimator.addAck(true, t0 + 80_s + 800_ms);
+  estimator.addAck(true, t0 + 80_s + 900_ms);
+  estimator.addAck(true, t0 + 81_s);
+  BOOST_CHECK_LT(estimator.getDwellTime(), 5_s);
+  options.minLifetime = 5_s;
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 81_s), 5_s);
+}
+
+BOOST_AUTO_TEST_CASE(StaleRoute)
+{
+  RouteLifetimeEstimator::Options options;
+  options.minLifetime = 1_s;
+  options.maxLifetime = 300_s;
+
+  RouteLifetimeEstimator estimator;
+  auto t0 = time::steady_clock::now();
+  estimator.addAck(false, t0);
+  estimator.addAck(true, t0 + 40_s);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 40_s);
+
+  estimator.addStaleRoute();
+  BOOST_CHECK_EQUAL(estimator.getScale(), 0.5);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 20_s);
+
+  for (int i = 0; i < 10; ++i) {
+    estimator.addStaleRoute();
+  }
+  BOOST_CHECK_EQUAL(estimator.getScale(), RouteLifetimeEstimator::MIN_SCALE);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 5_s);
+
+  // Acks on the same face let the lifetime grow back
+  for (int i = 0; i < 10; ++i) {
+    estimator.addAck(false, t0 + 40_s);
+  }
+  BOOST_CHECK_EQUAL(estimator.getScale(), 1.0);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 40_s);
+}
+
+BOOST_AUTO_TEST_CASE(RefreshInterval)
+{
+  RouteLifetimeEstimator::Options options;
+  options.minLifetime = 1_s;
+  options.maxLifetime = 300_s;
+
+  RouteLifetimeEstimator estimator;
+  auto t0 = time::steady_clock::now();
+  estimator.addAck(false, t0);
+  BOOST_CHECK_EQUAL(estimator.hasRefreshInterval(), false);
+  estimator.addAck(false, t0 + 10_s);
+  BOOST_REQUIRE_EQUAL(estimator.hasRefreshInterval(), true);
+  BOOST_CHECK_EQUAL(estimator.getRefreshInterval(), 10_s);
+
+  // a handoff is not a refresh
+  estimator.addAck(true, t0 + 20_s);
+  BOOST_CHECK_EQUAL(estimator.getRefreshInterval(), 10_s);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 20_s), 20_s);
+
+  // stale routes do not shrink the lifetime below 1.5 refresh intervals
+  for (int i = 0; i < 10; ++i) {
+    estimator.addStaleRoute();
+  }
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 20_s), 15_s);
+
+  // smoothed: 10s * 0.75 + 20s * 0.25
+  estimator.addAck(false, t0 + 40_s);
+  BOOST_CHECK_EQUAL(estimator.getRefreshInterval(), 12500_ms);
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 18750_ms);
+
+  // still clamped to the bounds
+  options.maxLifetime = 10_s;
+  BOOST_CHECK_EQUAL(estimator.computeLifetime(options, t0 + 40_s), 10_s);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteRouteLifetime
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace kite
+} // namespace fw
+} // namespace nfd
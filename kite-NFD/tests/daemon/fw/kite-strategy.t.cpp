@@ -0,0 +1,355 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/kite-strategy.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/global-io-fixture.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+#include "choose-strategy.hpp"
+#include "strategy-tester.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using KiteStrategyTester = StrategyTester<KiteStrategy>;
+NFD_REGISTER_STRATEGY(KiteStrategyTester);
+
+using Stage = KiteStrategy::InterestRetrasmissionStage;
+
+class KiteStrategyFixture : public GlobalIoTimeFixture
+{
+protected:
+  KiteStrategyFixture()
+  {
+    for (auto face : {consumer1, consumer2, consumer3, producerFace, rvFace1, rvFace2}) {
+      faceTable.add(face);
+    }
+    // route updates are not under test
+    strategy.setRibDispatch([] (auto&&...) {});
+
+    fib.addOrUpdateNextHop(*fib.insert("/rv1").first, *rvFace1, 10);
+    fib.addOrUpdateNextHop(*fib.insert("/rv2").first, *rvFace2, 10);
+  }
+
+  shared_ptr<Interest>
+  makeKiteInterest(uint32_t nonce)
+  {
+    auto interest = makeInterest("/mp/data", false, nullopt, nonce);
+    interest->setForwardingHint({Name().append(ndn::kite::KITE_KEYWORD).append("rv1"),
+                                 Name().append(ndn::kite::KITE_KEYWORD).append("rv2")});
+    return interest;
+  }
+
+  /** \brief deliver an Interest from \p consumer to the strategy
+   */
+  shared_ptr<pit::Entry>
+  receiveInterest(Face& consumer, uint32_t nonce)
+  {
+    auto interest = makeKiteInterest(nonce);
+    auto pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(consumer, *interest);
+    strategy.afterReceiveInterest(*interest, FaceEndpoint(consumer, 0), pitEntry);
+    return pitEntry;
+  }
+
+  void
+  receiveNack(Face& upstream, const shared_ptr<pit::Entry>& pitEntry)
+  {
+    auto outRecord = pitEntry->getOutRecord(upstream);
+    BOOST_REQUIRE(outRecord != pitEntry->out_end());
+    // the Nack answers the last transmission to the upstream
+    Interest interest(pitEntry->getInterest());
+    interest.setNonce(outRecord->getLastNonce());
+    auto nack = makeNack(interest, lp::NackReason::NO_ROUTE);
+    outRecord->setIncomingNack(nack);
+    strategy.afterReceiveNack(nack, FaceEndpoint(upstream, 0), pitEntry);
+  }
+
+  size_t
+  countSentTo(const Face& face) const
+  {
+    return std::count_if(strategy.sendInterestHistory.begin(), strategy.sendInterestHistory.end(),
+                         [&] (const auto& args) { return args.outFaceId == face.getId(); });
+  }
+
+  /** \brief check that every in-record of \p pitEntry is in \p stage
+   */
+  static bool
+  areAllInRecordsIn(const pit::Entry& pitEntry, Stage stage)
+  {
+    return std::all_of(pitEntry.in_begin(), pitEntry.in_end(), [stage] (const pit::InRecord& inRecord) {
+      auto status = inRecord.getStrategyInfo<KiteStrategy::KiteInterestStatus>();
+      return status != nullptr && status->retrasmissionStage == stage;
+    });
+  }
+
+protected:
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  // installed in StrategyChoice, so that it may access Measurements
+  KiteStrategyTester& strategy{choose<KiteStrategyTester>(forwarder)};
+  Fib& fib{forwarder.getFib()};
+  Pit& pit{forwarder.getPit()};
+
+  shared_ptr<DummyFace> consumer1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> consumer2 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> consumer3 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> producerFace = make_shared<DummyFace>();
+  shared_ptr<DummyFace> rvFace1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> rvFace2 = make_shared<DummyFace>();
+};
+
+BOOST_AUTO_TEST_SUITE(Fw)
+BOOST_FIXTURE_TEST_SUITE(TestKiteStrategy, KiteStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(AggregateInRvStage)
+{
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+
+  BOOST_CHECK(receiveInterest(*consumer2, 2) == pitEntry);
+  BOOST_CHECK(receiveInterest(*consumer3, 3) == pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvInterests, 1);
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 2);
+}
+
+BOOST_AUTO_TEST_CASE(RvTimeoutFailsOverOnce)
+{
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  receiveInterest(*consumer2, 2);
+  receiveInterest(*consumer3, 3);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+
+  // rv1 stays silent: one transmission towards rv2 serves all three consumers
+  advanceClocks(10_ms, 1100_ms);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace2), 1);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvInterests, 2);
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 4);
+}
+
+BOOST_AUTO_TEST_CASE(NackMovesAllConsumers)
+{
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  receiveInterest(*consumer2, 2);
+  BOOST_CHECK_EQUAL(countSentTo(*producerFace), 2);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::STRAIGHT_FORWARD));
+
+  receiveNack(*producerFace, pitEntry);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 1);
+
+  // a consumer arriving later is served by the same transmission
+  receiveInterest(*consumer3, 3);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 2);
+}
+
+BOOST_AUTO_TEST_CASE(StraightTimeoutMovesAllConsumers)
+{
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  receiveInterest(*consumer2, 2);
+  receiveInterest(*consumer3, 3);
+  BOOST_CHECK_EQUAL(countSentTo(*producerFace), 3);
+
+  // the producer left without a Nack
+  advanceClocks(10_ms, 1100_ms);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace2), 0);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 2);
+}
+
+BOOST_AUTO_TEST_CASE(BackToStraightForward)
+{
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  receiveInterest(*consumer2, 2);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+
+  // the producer reattached, and a consumer retransmits
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+  receiveInterest(*consumer2, 4);
+  BOOST_CHECK_EQUAL(countSentTo(*producerFace), 1);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::STRAIGHT_FORWARD));
+  BOOST_CHECK(pitEntry->getStrategyInfo<KiteStrategy::KiteRvTimer>() == nullptr);
+
+  // the straight-forward path fails again; rv1 has been tried, so rv2 serves everyone
+  receiveNack(*producerFace, pitEntry);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace2), 1);
+  BOOST_CHECK(areAllInRecordsIn(*pitEntry, Stage::RV));
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RetxAfterLastRvTimeout)
+{
+  // the in-record expires before rv2 times out, so the last failover finds no consumer
+  auto interest = makeKiteInterest(1);
+  interest->setInterestLifetime(1500_ms);
+  auto pitEntry = pit.insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(*consumer1, *interest);
+  strategy.afterReceiveInterest(*interest, FaceEndpoint(*consumer1, 0), pitEntry);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+
+  advanceClocks(10_ms, 2500_ms);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace2), 1);
+
+  // no transmission is pending anymore, the retransmission starts over from the best RV
+  receiveInterest(*consumer1, 2);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 2);
+  BOOST_CHECK_EQUAL(strategy.getRvCounters().nRvRetxSaved, 0);
+}
+
+BOOST_AUTO_TEST_CASE(NackWithoutRv)
+{
+  fib.erase("/rv1");
+  fib.erase("/rv2");
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  BOOST_CHECK_EQUAL(countSentTo(*producerFace), 1);
+  BOOST_REQUIRE_EQUAL(strategy.getProducers().size(), 1);
+  const auto& mpInfo = **strategy.getProducers().begin();
+
+  // no RV to fall back to: one Nack downstream, and the route is not counted as stale
+  receiveNack(*producerFace, pitEntry);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 1);
+  BOOST_CHECK_EQUAL(strategy.sendInterestHistory.size(), 1);
+  BOOST_CHECK_EQUAL(mpInfo.nNackFallbacks, 0);
+  BOOST_CHECK_EQUAL(mpInfo.routeLifetimeEstimator.getScale(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(NackFallbackCounted)
+{
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  BOOST_REQUIRE_EQUAL(strategy.getProducers().size(), 1);
+  const auto& mpInfo = **strategy.getProducers().begin();
+
+  receiveNack(*producerFace, pitEntry);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+  BOOST_CHECK_EQUAL(strategy.sendNackHistory.size(), 0);
+  BOOST_CHECK_EQUAL(mpInfo.nNackFallbacks, 1);
+  BOOST_CHECK_EQUAL(mpInfo.routeLifetimeEstimator.getScale(),
+                    kite::RouteLifetimeEstimator::STALE_DECREASE);
+}
+
+BOOST_AUTO_TEST_CASE(RouteLifetimeParameters)
+{
+  auto makeName = [] (const std::string& params) {
+    return Name(KiteStrategy::getStrategyName()).append(Name(params));
+  };
+
+  KiteStrategy kite(forwarder, makeName("/route-lifetime-min~2000/route-lifetime-max~60000"));
+  BOOST_CHECK_EQUAL(kite.getRouteLifetimeOptions().minLifetime, 2_s);
+  BOOST_CHECK_EQUAL(kite.getRouteLifetimeOptions().maxLifetime, 60_s);
+
+  BOOST_CHECK_THROW(KiteStrategy(forwarder, makeName("/route-lifetime-min~0")), std::invalid_argument);
+  BOOST_CHECK_THROW(KiteStrategy(forwarder, makeName("/route-lifetime-min~2000/route-lifetime-max~1000")),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(StraightTimeoutFollowsRtt)
+{
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+
+  // the producer answers after 50 ms
+  auto pitEntry = receiveInterest(*consumer1, 1);
+  advanceClocks(10_ms, 50_ms);
+  strategy.beforeSatisfyInterest(*makeData("/mp/data"), FaceEndpoint(*producerFace, 0), pitEntry);
+  pit.erase(pitEntry.get());
+
+  // the fallback waits for 3 x SRTT = 150 ms instead of the initial RTO of 1 s
+  receiveInterest(*consumer1, 2);
+  advanceClocks(10_ms, 140_ms);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 0);
+  advanceClocks(10_ms, 20_ms);
+  BOOST_CHECK_EQUAL(countSentTo(*rvFace1), 1);
+}
+
+BOOST_AUTO_TEST_CASE(StraightTimeoutMin)
+{
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *producerFace, 10);
+  auto& mpStrategy = choose<KiteStrategyTester>(forwarder, "/mp",
+    Name(KiteStrategyTester::getStrategyName()).append(Name("/mp-timeout-multiplier~2/mp-timeout-min~500")));
+  mpStrategy.setRibDispatch([] (auto&&...) {});
+
+  auto receive = [&] (uint32_t nonce) {
+    auto interest = makeKiteInterest(nonce);
+    auto pitEntry = pit.insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(*consumer1, *interest);
+    mpStrategy.afterReceiveInterest(*interest, FaceEndpoint(*consumer1, 0), pitEntry);
+    return pitEntry;
+  };
+  auto countSentToRv = [&] {
+    return std::count_if(mpStrategy.sendInterestHistory.begin(), mpStrategy.sendInterestHistory.end(),
+                         [&] (const auto& args) { return args.outFaceId == rvFace1->getId(); });
+  };
+
+  auto pitEntry = receive(1);
+  advanceClocks(10_ms, 50_ms);
+  mpStrategy.beforeSatisfyInterest(*makeData("/mp/data"), FaceEndpoint(*producerFace, 0), pitEntry);
+  pit.erase(pitEntry.get());
+
+  // 2 x SRTT = 100 ms is raised to mp-timeout-min
+  receive(2);
+  advanceClocks(10_ms, 490_ms);
+  BOOST_CHECK_EQUAL(countSentToRv(), 0);
+  advanceClocks(10_ms, 20_ms);
+  BOOST_CHECK_EQUAL(countSentToRv(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(StraightTimeoutParameters)
+{
+  auto makeName = [] (const std::string& params) {
+    return Name(KiteStrategy::getStrategyName()).append(Name(params));
+  };
+
+  BOOST_CHECK_NO_THROW(KiteStrategy(forwarder, makeName("/mp-timeout-multiplier~1/mp-timeout-min~0")));
+  BOOST_CHECK_THROW(KiteStrategy(forwarder, makeName("/mp-timeout-multiplier~0.5")), std::invalid_argument);
+  BOOST_CHECK_THROW(KiteStrategy(forwarder, makeName("/mp-timeout-min~-1")), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteStrategy
+BOOST_AUTO_TEST_SUITE_END() // Fw
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -30,6 +30,8 @@
 #include "tests/daemon/face/dummy-face.hpp"
 #include "dummy-strategy.hpp"
 
+#include <ndn-cxx/kite/request.hpp>
+
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/copy.hpp>
@@ -123,6 +125,42 @@ BOOST_AUTO_TEST_CASE(ParseParameters)
   BOOST_TEST(Strategy::parseParameters("/foo~bar/the-answer~42/foo~foo2") == expected);
 }
 
+class LookupFibTestStrategy : public DummyStrategy
+{
+public:
+  using DummyStrategy::DummyStrategy;
+  using DummyStrategy::lookupFib;
+};
+
+BOOST_AUTO_TEST_CASE(LookupFibKiteKeyword)
+{
+  FaceTable faceTable;
+  Forwarder forwarder(faceTable);
+  LookupFibTestStrategy strategy(forwarder);
+
+  auto face1 = make_shared<DummyFace>();
+  auto face2 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  faceTable.add(face2);
+  Fib& fib = forwarder.getFib();
+  fib.addOrUpdateNextHop(*fib.insert("/").first, *face1, 10);
+  fib.addOrUpdateNextHop(*fib.insert("/net").first, *face2, 10);
+  fib.addOrUpdateNextHop(*fib.insert("/mp").first, *face2, 10);
+
+  // a delegation made of the KITE keyword alone is skipped, although it carries no RV prefix
+  auto interest = makeInterest("/mp/data");
+  interest->setForwardingHint({Name().append(ndn::kite::KITE_KEYWORD), "/net"});
+  BOOST_CHECK(interest->getKiteHints().empty());
+  auto pitEntry = forwarder.getPit().insert(*interest).first;
+  BOOST_CHECK_EQUAL(strategy.lookupFib(*pitEntry).getPrefix(), "/net");
+
+  // with no other delegation, the Interest name is used
+  interest = makeInterest("/mp/data2");
+  interest->setForwardingHint({Name().append(ndn::kite::KITE_KEYWORD)});
+  pitEntry = forwarder.getPit().insert(*interest).first;
+  BOOST_CHECK_EQUAL(strategy.lookupFib(*pitEntry).getPrefix(), "/mp");
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestStrategy
 BOOST_AUTO_TEST_SUITE_END() // Fw
 
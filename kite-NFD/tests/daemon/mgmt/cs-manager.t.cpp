@@ -24,11 +24,15 @@
  */
 
 #include "mgmt/cs-manager.hpp"
+#include "fw/forwarder-shards.hpp"
 
 #include "manager-common-fixture.hpp"
 
 #include <ndn-cxx/mgmt/nfd/cs-info.hpp>
 
+#include <atomic>
+#include <thread>
+
 namespace nfd {
 namespace tests {
 
@@ -198,6 +202,71 @@ BOOST_AUTO_TEST_CASE(Erase)
   BOOST_CHECK_EQUAL(m_cs.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(ForwardingThreads)
+{
+  FaceTable shardedFaces;
+  fw::ForwarderShards::Options options;
+  options.nShards = 2;
+  fw::ForwarderShards shards(m_forwarder, shardedFaces, options);
+  m_manager.setForwarderShards(&shards);
+
+  auto pollUntil = [this] (const std::function<bool()>& pred) {
+    for (int i = 0; i < 5000 && !pred(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      advanceClocks(1_ms);
+    }
+    return pred();
+  };
+
+  // cs/config applies to the CS of every forwarding thread
+  using ndn::nfd::CsFlagBit;
+  auto req = makeControlCommandRequest("/localhost/nfd/cs/config", ControlParameters().setCapacity(100));
+  receiveInterest(req);
+  BOOST_REQUIRE(pollUntil([this] { return m_responses.size() == 1; }));
+  ControlParameters body;
+  body.setCapacity(100);
+  body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_ADMIT, true, false);
+  body.setFlagBit(CsFlagBit::BIT_CS_ENABLE_SERVE, true, false);
+  BOOST_CHECK_EQUAL(checkResponse(0, req.getName(),
+                                  ControlResponse(200, "OK").setBody(body.wireEncode())),
+                    CheckResponseResult::OK);
+
+  auto nConfigured = make_shared<std::atomic<size_t>>(0);
+  bool isDone = false;
+  shards.forEachShard([nConfigured] (Forwarder& forwarder) {
+                        if (forwarder.getCs().getLimit() == 100) {
+                          ++*nConfigured;
+                        }
+                        for (uint64_t i = 0; i < 3; ++i) {
+                          forwarder.getCs().insert(*makeData(Name("/A").appendSequenceNumber(i)));
+                        }
+                      },
+                      [&isDone] { isDone = true; });
+  BOOST_REQUIRE(pollUntil([&isDone] { return isDone; }));
+  BOOST_CHECK_EQUAL(*nConfigured, 2);
+
+  // the requested Count covers all forwarding threads together
+  req = makeControlCommandRequest("/localhost/nfd/cs/erase", ControlParameters().setName("/A").setCount(4));
+  receiveInterest(req);
+  BOOST_REQUIRE(pollUntil([this] { return m_responses.size() == 2; }));
+  body = ControlParameters();
+  body.setName("/A");
+  body.setCount(4);
+  BOOST_CHECK_EQUAL(checkResponse(1, req.getName(),
+                                  ControlResponse(200, "OK").setBody(body.wireEncode())),
+                    CheckResponseResult::OK);
+
+  req = makeControlCommandRequest("/localhost/nfd/cs/erase", ControlParameters().setName("/A"));
+  receiveInterest(req);
+  BOOST_REQUIRE(pollUntil([this] { return m_responses.size() == 3; }));
+  body.setCount(2);
+  BOOST_CHECK_EQUAL(checkResponse(2, req.getName(),
+                                  ControlResponse(200, "OK").setBody(body.wireEncode())),
+                    CheckResponseResult::OK);
+
+  m_manager.setForwarderShards(nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(Info)
 {
   m_cs.setLimit(2681);
@@ -106,6 +106,10 @@ BOOST_AUTO_TEST_CASE(GeneralStatusDataset)
 
   BOOST_CHECK_EQUAL(status.getNSatisfiedInterests(), m_forwarder.getCounters().nSatisfiedInterests);
   BOOST_CHECK_EQUAL(status.getNUnsatisfiedInterests(), m_forwarder.getCounters().nUnsatisfiedInterests);
+
+  const auto& pauses = m_forwarder.getNameTree().getResizePauses().getBins();
+  BOOST_CHECK_EQUAL_COLLECTIONS(status.getNameTreeResizePauses().begin(), status.getNameTreeResizePauses().end(),
+                                pauses.begin(), pauses.end());
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarderStatusManager
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mgmt/kite-manager.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/kite-strategy.hpp"
+
+#include "manager-common-fixture.hpp"
+
+#include <ndn-cxx/mgmt/nfd/kite-producer-status.hpp>
+
+namespace nfd {
+namespace tests {
+
+class KiteManagerFixture : public ManagerCommonFixture
+{
+protected:
+  KiteManagerFixture()
+    : m_forwarder(m_faceTable)
+    , m_manager(m_forwarder, m_dispatcher)
+  {
+    setTopPrefix();
+    m_forwarder.getStrategyChoice().insert("/mp", fw::KiteStrategy::getStrategyName());
+  }
+
+  fw::KiteStrategy&
+  getKiteStrategy()
+  {
+    return dynamic_cast<fw::KiteStrategy&>(m_forwarder.getStrategyChoice().findEffectiveStrategy("/mp"));
+  }
+
+  fw::KiteStrategy::KiteMobileProducerInfo&
+  addProducer(const Name& mpName)
+  {
+    auto& entry = m_forwarder.getMeasurements().get(mpName);
+    return getKiteStrategy().getOrCreateMpInfo(entry, mpName);
+  }
+
+  std::vector<ndn::nfd::KiteProducerStatus>
+  fetchDataset()
+  {
+    m_responses.clear();
+    // MustBeFresh bypasses the Dispatcher's cache of earlier responses, like a real fetcher does
+    receiveInterest(Interest("/localhost/nfd/kite/list").setCanBePrefix(true).setMustBeFresh(true));
+
+    Block content = this->concatenateResponses();
+    content.parse();
+    std::vector<ndn::nfd::KiteProducerStatus> producers;
+    for (const auto& element : content.elements()) {
+      producers.emplace_back(element);
+    }
+    return producers;
+  }
+
+protected:
+  FaceTable m_faceTable;
+  Forwarder m_forwarder;
+  KiteManager m_manager;
+};
+
+BOOST_AUTO_TEST_SUITE(Mgmt)
+BOOST_FIXTURE_TEST_SUITE(TestKiteManager, KiteManagerFixture)
+
+BOOST_AUTO_TEST_CASE(ListProducers)
+{
+  auto& mpB = addProducer("/mp/B");
+  mpB.nHandoffs = 2;
+  mpB.nNackFallbacks = 3;
+  mpB.nTimeoutFallbacks = 1;
+  mpB.routeInstallLatency = 1500_us;
+  mpB.routeLifetime = 45_s;
+  addProducer("/mp/A");
+
+  auto producers = fetchDataset();
+  BOOST_REQUIRE_EQUAL(producers.size(), 2);
+  BOOST_CHECK_EQUAL(producers[0].getPrefix(), "/mp/A");
+  BOOST_CHECK_EQUAL(producers[0].getNHandoffs(), 0);
+  BOOST_CHECK_EQUAL(producers[0].hasRouteInstallLatency(), false);
+  BOOST_CHECK_EQUAL(producers[0].hasRouteLifetime(), false);
+  BOOST_CHECK_EQUAL(producers[1].getPrefix(), "/mp/B");
+  BOOST_CHECK_EQUAL(producers[1].getNPendingInterests(), 0);
+  BOOST_CHECK_EQUAL(producers[1].getNHandoffs(), 2);
+  BOOST_CHECK_EQUAL(producers[1].getNNackFallbacks(), 3);
+  BOOST_CHECK_EQUAL(producers[1].getNTimeoutFallbacks(), 1);
+  BOOST_CHECK_EQUAL(producers[1].getRouteInstallLatency(), 1500_us);
+  BOOST_CHECK_EQUAL(producers[1].getRouteLifetime(), 45_s);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  auto& mpA = addProducer("/mp/A");
+  auto producers = fetchDataset();
+  BOOST_REQUIRE_EQUAL(producers.size(), 1);
+  BOOST_CHECK_EQUAL(producers[0].getNHandoffs(), 0);
+
+  // changes are not visible until the snapshot expires
+  mpA.nHandoffs = 1;
+  this->advanceClocks(100_ms);
+  producers = fetchDataset();
+  BOOST_REQUIRE_EQUAL(producers.size(), 1);
+  BOOST_CHECK_EQUAL(producers[0].getNHandoffs(), 0);
+
+  this->advanceClocks(100_ms, KiteManager::SNAPSHOT_LIFETIME);
+  producers = fetchDataset();
+  BOOST_REQUIRE_EQUAL(producers.size(), 1);
+  BOOST_CHECK_EQUAL(producers[0].getNHandoffs(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ProducerExpired)
+{
+  addProducer("/mp/A");
+  BOOST_CHECK_EQUAL(getKiteStrategy().getProducers().size(), 1);
+
+  // the producer record goes away with its Measurements entry
+  this->advanceClocks(1_s, 10_s);
+  BOOST_CHECK_EQUAL(getKiteStrategy().getProducers().size(), 0);
+  BOOST_CHECK_EQUAL(fetchDataset().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(OtherStrategies)
+{
+  addProducer("/mp/A");
+  m_forwarder.getMeasurements().get("/other");
+
+  auto producers = fetchDataset();
+  BOOST_REQUIRE_EQUAL(producers.size(), 1);
+  BOOST_CHECK_EQUAL(producers[0].getPrefix(), "/mp/A");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteManager
+BOOST_AUTO_TEST_SUITE_END() // Mgmt
+
+} // namespace tests
+} // namespace nfd
@@ -37,6 +37,8 @@
 
 #include <boost/property_tree/info_parser.hpp>
 
+#include <thread>
+
 namespace nfd {
 namespace tests {
 
@@ -86,6 +88,24 @@ public:
     return signPrefixAnn(makePrefixAnn(std::forward<T>(args)...), m_keyChain, m_untrustedSigner);
   }
 
+  /** \brief Poll the io_service until \p pred is satisfied.
+   *
+   *  Validation workers post their results from other threads, so this waits up to a few seconds
+   *  of wall clock time for them to arrive.
+   */
+  bool
+  pollUntil(const std::function<bool()>& pred)
+  {
+    for (int i = 0; i < 5000; ++i) {
+      pollIo();
+      if (pred()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
   /** \brief Invoke manager->slAnnounce and wait for result.
    */
   SlAnnounceResult
@@ -98,7 +118,7 @@ public:
         result = res;
       });
 
-    g_io.poll();
+    pollUntil([&] { return result.has_value(); });
     BOOST_CHECK(result);
     return result.value_or(SlAnnounceResult::ERROR);
   }
@@ -161,6 +181,24 @@ public:
     return oss.str();
   }
 
+  /** \brief Load a trust schema that accepts announcements signed by /trusted only.
+   */
+  void
+  loadTrustSchemaPaConfig()
+  {
+    ConfigSection section;
+    section.put("rule.id", "PA");
+    section.put("rule.for", "data");
+    section.put("rule.checker.type", "customized");
+    section.put("rule.checker.sig-type", "rsa-sha256");
+    section.put("rule.checker.key-locator.type", "name");
+    section.put("rule.checker.key-locator.name", "/trusted");
+    section.put("rule.checker.key-locator.relation", "is-prefix-of");
+    section.put("trust-anchor.type", "base64");
+    section.put("trust-anchor.base64-string", getIdentityCertificateBase64("/trusted"));
+    manager->applyPaConfig(section, "trust-schema.section");
+  }
+
 private:
   void
   loadDefaultPaConfig()
@@ -218,17 +256,7 @@ BOOST_AUTO_TEST_CASE(AnnounceWithEmptyConfig)
 
 BOOST_AUTO_TEST_CASE(AnnounceValidationError)
 {
-  ConfigSection section;
-  section.put("rule.id", "PA");
-  section.put("rule.for", "data");
-  section.put("rule.checker.type", "customized");
-  section.put("rule.checker.sig-type", "rsa-sha256");
-  section.put("rule.checker.key-locator.type", "name");
-  section.put("rule.checker.key-locator.name", "/trusted");
-  section.put("rule.checker.key-locator.relation", "is-prefix-of");
-  section.put("trust-anchor.type", "base64");
-  section.put("trust-anchor.base64-string", getIdentityCertificateBase64("/trusted"));
-  manager->applyPaConfig(section, "trust-schema.section");
+  loadTrustSchemaPaConfig();
 
   auto pa = makeUntrustedAnn("/1nzAe0Y4", 1_h);
   BOOST_CHECK_EQUAL(slAnnounceSync(pa, 2959, 1_h), SlAnnounceResult::VALIDATION_FAILURE);
@@ -236,6 +264,128 @@ BOOST_AUTO_TEST_CASE(AnnounceValidationError)
   BOOST_CHECK(findAnnRoute("/1nzAe0Y4", 2959) == nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(AnnounceCached)
+{
+  loadTrustSchemaPaConfig();
+  const auto& cache = manager->getPaValidationCache();
+
+  auto pa = makeTrustedAnn("/fMXN7UeB", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 0);
+
+  // same Data from another face is not validated again
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 2959, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+  BOOST_CHECK(findAnnRoute("/fMXN7UeB", 2959) != nullptr);
+
+  // failures are not cached
+  auto pa2 = makeUntrustedAnn("/1nzAe0Y4", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa2, 2959, 1_h), SlAnnounceResult::VALIDATION_FAILURE);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  // changing the trust schema invalidates the cache
+  manager->applyPaConfig(makeSection(""), "empty");
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 4832, 1_h), SlAnnounceResult::VALIDATION_FAILURE);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceCacheLifetime)
+{
+  RibManager::PaProcessingOptions options;
+  options.cache.lifetime = 10_s;
+  manager->applyPaProcessingConfig(options);
+  const auto& cache = manager->getPaValidationCache();
+
+  auto pa = makeTrustedAnn("/fMXN7UeB", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  advanceClocks(1_s, 5);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+
+  advanceClocks(1_s, 6);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 2);
+
+  options.cache.lifetime = 0_s;
+  manager->applyPaProcessingConfig(options);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceCacheCapacity)
+{
+  RibManager::PaProcessingOptions options;
+  options.cache.capacity = 2;
+  manager->applyPaProcessingConfig(options);
+  const auto& cache = manager->getPaValidationCache();
+
+  auto pa1 = makeTrustedAnn("/pa1", 1_h);
+  auto pa2 = makeTrustedAnn("/pa2", 1_h);
+  auto pa3 = makeTrustedAnn("/pa3", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa1, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa2, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa1, 3275, 1_h), SlAnnounceResult::OK); // pa1 becomes MRU
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa3, 3275, 1_h), SlAnnounceResult::OK); // evicts pa2
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa1, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 2);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa2, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceOnWorkers)
+{
+  RibManager::PaProcessingOptions options;
+  options.nValidationThreads = 2;
+  manager->applyPaProcessingConfig(options);
+  loadTrustSchemaPaConfig();
+
+  auto pa = makeTrustedAnn("/fMXN7UeB", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK(findAnnRoute("/fMXN7UeB", 3275) != nullptr);
+  BOOST_CHECK_EQUAL(manager->getPaValidationCache().size(), 1);
+
+  auto pa2 = makeUntrustedAnn("/1nzAe0Y4", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa2, 2959, 1_h), SlAnnounceResult::VALIDATION_FAILURE);
+  BOOST_CHECK(findAnnRoute("/1nzAe0Y4", 2959) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceOptimistic)
+{
+  RibManager::PaProcessingOptions options;
+  options.wantOptimisticInstall = true;
+  manager->applyPaProcessingConfig(options);
+  loadTrustSchemaPaConfig();
+
+  auto pa = makeTrustedAnn("/fMXN7UeB", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa, 3275, 1_h), SlAnnounceResult::OK);
+  BOOST_CHECK(findAnnRoute("/fMXN7UeB", 3275) != nullptr);
+
+  // validation fails before the route is installed
+  auto pa2 = makeUntrustedAnn("/1nzAe0Y4", 1_h);
+  BOOST_CHECK_EQUAL(slAnnounceSync(pa2, 2959, 1_h), SlAnnounceResult::VALIDATION_FAILURE);
+  pollIo();
+  BOOST_CHECK(findAnnRoute("/1nzAe0Y4", 2959) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(AnnounceOptimisticRollback)
+{
+  RibManager::PaProcessingOptions options;
+  options.nValidationThreads = 1;
+  options.wantOptimisticInstall = true;
+  manager->applyPaProcessingConfig(options);
+  loadTrustSchemaPaConfig();
+
+  auto pa = makeUntrustedAnn("/1nzAe0Y4", 1_h);
+  optional<SlAnnounceResult> result;
+  manager->slAnnounce(pa, 2959, 1_h, [&] (SlAnnounceResult res) { result = res; });
+  BOOST_CHECK(pollUntil([&] { return result && findAnnRoute("/1nzAe0Y4", 2959) == nullptr; }));
+}
+
 BOOST_AUTO_TEST_CASE(AnnounceInsert_AnnLifetime)
 {
   auto pa = makeTrustedAnn("/EHJYmJz9", 1_h);
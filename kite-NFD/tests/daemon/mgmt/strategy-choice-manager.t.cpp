@@ -24,6 +24,7 @@
  */
 
 #include "mgmt/strategy-choice-manager.hpp"
+#include "fw/forwarder-shards.hpp"
 #include "table/strategy-choice.hpp"
 
 #include "manager-common-fixture.hpp"
@@ -104,6 +105,34 @@ BOOST_AUTO_TEST_CASE(SetSuccess)
   // Table/TestStrategyChoice test suite.
 }
 
+BOOST_AUTO_TEST_CASE(SetOnForwardingThreads)
+{
+  FaceTable shardedFaces;
+  fw::ForwarderShards::Options options;
+  options.nShards = 2;
+  fw::ForwarderShards shards(m_forwarder, shardedFaces, options);
+  manager.setForwarderShards(&shards);
+
+  ControlParameters reqParams;
+  reqParams.setName("/A")
+           .setStrategy("/localhost/nfd/strategy/kite");
+  auto req = makeControlCommandRequest("/localhost/nfd/strategy-choice/set", reqParams);
+  receiveInterest(req);
+
+  BOOST_CHECK_EQUAL(checkResponse(0, req.getName(),
+                                  ControlResponse(409, "Strategy cannot run on forwarding threads")),
+                    CheckResponseResult::OK);
+  BOOST_CHECK_EQUAL(hasEntry("/A"), false);
+
+  // other strategies are accepted
+  reqParams.setStrategy(strategyNameP);
+  req = makeControlCommandRequest("/localhost/nfd/strategy-choice/set", reqParams);
+  receiveInterest(req);
+  BOOST_CHECK_EQUAL(getInstanceName("/A"), strategyNameP);
+
+  manager.setForwarderShards(nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(SetUnknownStrategy)
 {
   ControlParameters reqParams;
@@ -200,6 +200,64 @@ BOOST_AUTO_TEST_CASE(Unknown)
 
 BOOST_AUTO_TEST_SUITE_END() // CsPolicy
 
+BOOST_AUTO_TEST_SUITE(NameTreeHashtable)
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG";
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(forwarder.getNameTree().getHashtableLayout(), name_tree::HashtableLayout::CHAINED);
+}
+
+BOOST_AUTO_TEST_CASE(Known)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_hashtable open-addressing
+    }
+  )CONFIG";
+
+  NameTree& nt = forwarder.getNameTree();
+  name_tree::Entry& nte = nt.lookup("/A/B/C");
+
+  runConfig(CONFIG, true);
+  BOOST_CHECK_EQUAL(nt.getHashtableLayout(), name_tree::HashtableLayout::CHAINED);
+
+  runConfig(CONFIG, false);
+  BOOST_CHECK_EQUAL(nt.getHashtableLayout(), name_tree::HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/B/C"), &nte);
+
+  // option omitted during reload, default is applied
+  runConfig(R"CONFIG(
+    tables
+    {
+    }
+  )CONFIG", false);
+  BOOST_CHECK_EQUAL(nt.getHashtableLayout(), name_tree::HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/B/C"), &nte);
+}
+
+BOOST_AUTO_TEST_CASE(Unknown)
+{
+  const std::string CONFIG = R"CONFIG(
+    tables
+    {
+      name_tree_hashtable cuckoo
+    }
+  )CONFIG";
+
+  BOOST_CHECK_THROW(runConfig(CONFIG, true), ConfigFile::Error);
+  BOOST_CHECK_THROW(runConfig(CONFIG, false), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameTreeHashtable
+
 class CsUnsolicitedPolicyFixture : public TablesConfigSectionFixture
 {
 protected:
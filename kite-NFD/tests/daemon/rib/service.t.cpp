@@ -110,6 +110,49 @@ BOOST_AUTO_TEST_CASE(EmptyPrefixAnnouncementValidation)
   poll();
 }
 
+BOOST_AUTO_TEST_CASE(PrefixAnnouncementProcessing)
+{
+  const std::string CONFIG = R"CONFIG(
+    rib
+    {
+      prefix_announcement_validation
+      {
+        trust-anchor
+        {
+          type any
+        }
+      }
+      prefix_announcement_processing
+      {
+        cache_lifetime 120
+        cache_capacity 1024
+        validation_threads 2
+        optimistic_install yes
+      }
+    }
+  )CONFIG";
+
+  runOnRibIoService([&] {
+    BOOST_CHECK_NO_THROW(Service(makeSection(CONFIG), m_ribKeyChain));
+  });
+  poll();
+
+  const std::string BAD_CONFIG = R"CONFIG(
+    rib
+    {
+      prefix_announcement_processing
+      {
+        validation_threads -1
+      }
+    }
+  )CONFIG";
+
+  runOnRibIoService([&] {
+    BOOST_CHECK_THROW(Service(makeSection(BAD_CONFIG), m_ribKeyChain), ConfigFile::Error);
+  });
+  poll();
+}
+
 BOOST_AUTO_TEST_CASE(LocalhopAndPropagate)
 {
   const std::string CONFIG = R"CONFIG(
@@ -143,6 +143,41 @@ BOOST_AUTO_TEST_CASE(MustBeFresh)
   CHECK_CS_FIND(0);
 }
 
+BOOST_AUTO_TEST_CASE(ExactName_MustBeFresh)
+{
+  // same name, different payloads
+  insert(1, "/A", [] (Data& data) { data.setFreshnessPeriod(0_s); });
+  insert(2, "/A", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+  insert(3, "/A/B", [] (Data& data) { data.setFreshnessPeriod(1_h); });
+
+  advanceClocks(500_ms);
+  startInterest("/A")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(2);
+
+  startInterest("/A/B")
+    .setMustBeFresh(true);
+  CHECK_CS_FIND(3);
+}
+
+BOOST_AUTO_TEST_CASE(ExactName_Evicted)
+{
+  cs.setLimit(2);
+  Name n1 = insert(1, "/A");
+  insert(2, "/B");
+  insert(3, "/C");
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  startInterest("/A");
+  CHECK_CS_FIND(0);
+
+  startInterest(n1);
+  CHECK_CS_FIND(0);
+
+  startInterest("/C");
+  CHECK_CS_FIND(3);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Find
 
 BOOST_AUTO_TEST_CASE(Erase)
@@ -28,6 +28,8 @@
 #include "tests/test-common.hpp"
 #include "tests/daemon/global-io-fixture.hpp"
 
+#include <numeric>
+
 namespace nfd {
 namespace name_tree {
 namespace tests {
@@ -183,6 +185,145 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(2);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2);
+  BOOST_CHECK(ht.getFirstNode() == nullptr);
+
+  std::vector<Name> names;
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 300; ++i) {
+    names.push_back(Name("/A").appendNumber(i));
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(names.back(), 2, computeHashes(names.back()));
+    BOOST_CHECK(isNew);
+    nodes.push_back(node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 300);
+  BOOST_CHECK_GE(ht.getNBuckets(), 300 / 7);
+
+  // nodes are not moved by resizing
+  for (size_t i = 0; i < names.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(names[i], 2), nodes[i]);
+    BOOST_CHECK_EQUAL(ht.insert(names[i], 2, computeHashes(names[i])).first, nodes[i]);
+  }
+
+  std::set<const Node*> enumerated;
+  for (const Node* node = ht.getFirstNode(); node != nullptr; node = ht.getNextNode(node)) {
+    BOOST_CHECK(enumerated.insert(node).second);
+  }
+  BOOST_CHECK(enumerated == std::set<const Node*>(nodes.begin(), nodes.end()));
+
+  // erase every other node, then reinsert them, leaving deleted slots behind
+  for (int round = 0; round < 10; ++round) {
+    for (size_t i = 0; i < names.size(); i += 2) {
+      ht.erase(const_cast<Node*>(nodes[i]));
+    }
+    BOOST_CHECK_EQUAL(ht.size(), 150);
+    for (size_t i = 0; i < names.size(); ++i) {
+      BOOST_CHECK_EQUAL(ht.find(names[i], 2) == nullptr, i % 2 == 0);
+    }
+    for (size_t i = 0; i < names.size(); i += 2) {
+      nodes[i] = ht.insert(names[i], 2, computeHashes(names[i])).first;
+    }
+    BOOST_CHECK_EQUAL(ht.size(), 300);
+  }
+
+  for (const Node* node : nodes) {
+    ht.erase(const_cast<Node*>(node));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2);
+  BOOST_CHECK(ht.getFirstNode() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  for (auto layout : {HashtableLayout::CHAINED, HashtableLayout::OPEN_ADDRESSING}) {
+    BOOST_TEST_CONTEXT("layout=" << layout) {
+      HashtableOptions options(16);
+      options.layout = layout;
+      options.migrationStep = 1;
+      Hashtable ht(options);
+      BOOST_CHECK(!ht.isResizing());
+
+      std::vector<Name> names;
+      std::vector<const Node*> nodes;
+      bool hasResized = false;
+      for (int i = 0; i < 500; ++i) {
+        names.push_back(Name("/A").appendNumber(i));
+        nodes.push_back(ht.insert(names.back(), 2, computeHashes(names.back())).first);
+        hasResized = hasResized || ht.isResizing();
+
+        if (ht.isResizing() && i % 20 == 0) {
+          // every node can be found and is enumerated exactly once during migration
+          for (size_t j = 0; j < names.size(); ++j) {
+            BOOST_CHECK_EQUAL(ht.find(names[j], 2), nodes[j]);
+          }
+          std::set<const Node*> enumerated;
+          for (const Node* node = ht.getFirstNode(); node != nullptr; node = ht.getNextNode(node)) {
+            BOOST_CHECK(enumerated.insert(node).second);
+          }
+          BOOST_CHECK(enumerated == std::set<const Node*>(nodes.begin(), nodes.end()));
+        }
+      }
+      BOOST_CHECK(hasResized);
+
+      // erase nodes that are either migrated or not, while a migration is in progress
+      size_t nErased = 0;
+      while (nErased < names.size() && !ht.isResizing()) {
+        ht.erase(const_cast<Node*>(nodes[nErased]));
+        ++nErased;
+      }
+      BOOST_CHECK(ht.isResizing());
+      for (; nErased < names.size(); ++nErased) {
+        for (size_t j = nErased; j < names.size(); j += 50) {
+          BOOST_CHECK_EQUAL(ht.find(names[j], 2), nodes[j]);
+        }
+        ht.erase(const_cast<Node*>(nodes[nErased]));
+        BOOST_CHECK(ht.find(names[nErased], 2) == nullptr);
+      }
+      BOOST_CHECK_EQUAL(ht.size(), 0);
+      BOOST_CHECK(ht.getFirstNode() == nullptr);
+
+      const auto& bins = ht.getResizePauses().getBins();
+      BOOST_CHECK_GT(std::accumulate(bins.begin(), bins.end(), uint64_t(0)), 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SetLayout)
+{
+  Hashtable ht(HashtableOptions(16));
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+
+  Name name("/A/B/C/D/E/F/G/H/I/J");
+  HashSequence hashes = computeHashes(name);
+  std::vector<const Node*> nodes;
+  for (size_t i = 0; i <= name.size(); ++i) {
+    nodes.push_back(ht.insert(name, i, hashes).first);
+  }
+
+  ht.setLayout(HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(ht.size(), nodes.size());
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(name, i, hashes), nodes[i]);
+  }
+
+  ht.setLayout(HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.getLayout(), HashtableLayout::CHAINED);
+  BOOST_CHECK_EQUAL(ht.size(), nodes.size());
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(ht.find(name, i, hashes), nodes[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -691,6 +832,31 @@ BOOST_FIXTURE_TEST_CASE(IteratorFindAllMatches, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_CASE(PrecomputedHashes)
+{
+  NameTree nt;
+  Name name("/a/b/c/d");
+  HashSequence hashes = computeHashes(name);
+
+  Entry& abc = nt.lookup(name, 3, hashes);
+  BOOST_CHECK_EQUAL(abc.getName(), "/a/b/c");
+  BOOST_CHECK_EQUAL(&abc, &nt.lookup(name, 3));
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+
+  BOOST_CHECK_EQUAL(nt.findExactMatch(name, 3, hashes), &abc);
+  BOOST_CHECK(nt.findExactMatch(name, 4, hashes) == nullptr);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(name, hashes), &abc);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(name, hashes,
+                      [] (const Entry& entry) { return entry.getName().size() < 2; })->getName(), "/a");
+
+  size_t nMatches = 0;
+  for (const Entry& entry : nt.findAllMatches(name, hashes)) {
+    BOOST_CHECK(entry.getName().isPrefixOf(name));
+    ++nMatches;
+  }
+  BOOST_CHECK_EQUAL(nMatches, 4);
+}
+
 BOOST_AUTO_TEST_CASE(HashTableResizeShrink)
 {
   size_t nBuckets = 16;
@@ -0,0 +1,575 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/global.hpp"
+#include "face/face.hpp"
+#include "face/generic-link-service.hpp"
+#include "face/internal-transport.hpp"
+#include "fw/forwarder.hpp"
+#include "fw/kite-strategy.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/kite/ack.hpp>
+#include <ndn-cxx/kite/request.hpp>
+#include <ndn-cxx/security/interest-signer.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+namespace nfd {
+namespace tests {
+
+using face::GenericLinkService;
+using face::InternalClientTransport;
+using face::InternalForwarderTransport;
+using face::InternalTransportBase;
+using fw::KiteStrategy;
+using fw::kite::RibUpdateCoalescer;
+using fw::kite::RouteUpdate;
+using ndn::nfd::FACE_SCOPE_LOCAL;
+using ndn::nfd::FACE_SCOPE_NON_LOCAL;
+
+/** \brief parameters of a simulated KITE handoff scenario
+ */
+struct KiteHandoffParams
+{
+  size_t nProducers = 20;
+  size_t nAccessRouters = 4;
+  time::milliseconds dwellTime = 5_s; ///< mean time a producer stays on an access router
+  time::milliseconds interestInterval = 50_ms; ///< per producer
+  time::milliseconds interestLifetime = 1_s;
+  time::milliseconds linkDelay = 5_ms; ///< one-way delay between routers
+  time::milliseconds ribDelay = 1_ms; ///< time the emulated RIB takes to apply a batch
+  time::milliseconds announcementLifetime = 10_s;
+  time::milliseconds duration = 30_s; ///< simulated time during which producers move
+  uint32_t seed = 1;
+};
+
+struct KiteHandoffResult
+{
+  uint64_t nExpressed = 0;
+  uint64_t nSatisfied = 0;
+  uint64_t nNacked = 0;
+  uint64_t nTimedOut = 0;
+  uint64_t nHandoffs = 0;
+  uint64_t nAcks = 0;
+  std::vector<time::nanoseconds> recoveryTimes;
+  uint64_t nPackets = 0;
+  std::clock_t cpuTime = 0;
+};
+
+/** \brief a forwarder with its own face table
+ */
+class BenchmarkNode : noncopyable
+{
+public:
+  explicit
+  BenchmarkNode(const std::string& label)
+    : label(label)
+  {
+  }
+
+  Face&
+  addFace(const std::string& remote, ndn::nfd::FaceScope scope)
+  {
+    auto face = make_shared<Face>(make_unique<GenericLinkService>(),
+                                  make_unique<InternalForwarderTransport>(
+                                    FaceUri("bench://" + label), FaceUri("bench://" + remote), scope));
+    faceTable.add(face);
+    return *face;
+  }
+
+  static InternalForwarderTransport&
+  getTransport(Face& face)
+  {
+    return static_cast<InternalForwarderTransport&>(*face.getTransport());
+  }
+
+public:
+  const std::string label;
+  FaceTable faceTable;
+  Forwarder forwarder{faceTable};
+  std::map<std::pair<Name, FaceId>, scheduler::ScopedEventId> routeExpiry;
+};
+
+/** \brief delivers packets to a forwarder-side transport after a fixed delay
+ */
+class DelayedPeer final : public InternalTransportBase
+{
+public:
+  DelayedPeer(InternalForwarderTransport& peer, time::nanoseconds delay)
+    : m_peer(peer)
+    , m_delay(delay)
+  {
+  }
+
+  void
+  receivePacket(const Block& packet) final
+  {
+    getScheduler().schedule(m_delay, [this, packet] { m_peer.receivePacket(packet); });
+  }
+
+private:
+  InternalForwarderTransport& m_peer;
+  time::nanoseconds m_delay;
+};
+
+/** \brief a point-to-point link between two routers
+ */
+class BenchmarkLink : noncopyable
+{
+public:
+  BenchmarkLink(BenchmarkNode& a, BenchmarkNode& b, time::nanoseconds delay)
+    : faceA(a.addFace(b.label, FACE_SCOPE_NON_LOCAL))
+    , faceB(b.addFace(a.label, FACE_SCOPE_NON_LOCAL))
+    , m_toA(BenchmarkNode::getTransport(faceA), delay)
+    , m_toB(BenchmarkNode::getTransport(faceB), delay)
+  {
+    BenchmarkNode::getTransport(faceA).setPeer(&m_toB);
+    BenchmarkNode::getTransport(faceB).setPeer(&m_toA);
+  }
+
+public:
+  Face& faceA;
+  Face& faceB;
+
+private:
+  DelayedPeer m_toA;
+  DelayedPeer m_toB;
+};
+
+struct MobileProducer
+{
+  Name prefix;
+  shared_ptr<InternalClientTransport> transport = make_shared<InternalClientTransport>();
+  unique_ptr<ndn::Face> face;
+  std::vector<Face*> arFaces; ///< forwarder-side face on each access router, created on first visit
+  size_t ar = 0;
+  uint64_t epoch = 0; ///< incremented on every attachment, carried in Data content
+  time::steady_clock::TimePoint attachTime;
+  bool hasRecovered = true;
+  uint64_t seq = 0;
+  scheduler::ScopedEventId moveEvent;
+  scheduler::ScopedEventId consumerEvent;
+};
+
+/** \brief simulates mobile producers moving between access routers
+ *
+ *  The topology is a consumer router K, a core router C, a rendezvous router R with an RV
+ *  application, and access routers AR0..ARn, each connected to C. C, R, and the access routers
+ *  run KiteStrategy, whose route updates are applied to the FIB by an emulated RIB.
+ */
+class KiteHandoffSimulation : noncopyable
+{
+public:
+  explicit
+  KiteHandoffSimulation(const KiteHandoffParams& params)
+    : m_params(params)
+    , m_rng(params.seed)
+    , m_consumerNode("K")
+    , m_core("C")
+    , m_rvNode("R")
+    , m_keyChain("pib-memory:", "tpm-memory:")
+    , m_signer(m_keyChain)
+  {
+    for (size_t i = 0; i < m_params.nAccessRouters; ++i) {
+      m_ars.push_back(make_unique<BenchmarkNode>("AR" + to_string(i)));
+    }
+
+    m_links.push_back(make_unique<BenchmarkLink>(m_consumerNode, m_core, m_params.linkDelay));
+    addRoute(m_consumerNode, "/", m_links.back()->faceA);
+    m_links.push_back(make_unique<BenchmarkLink>(m_core, m_rvNode, m_params.linkDelay));
+    addRoute(m_core, RV_PREFIX, m_links.back()->faceA);
+    for (auto& ar : m_ars) {
+      m_links.push_back(make_unique<BenchmarkLink>(*ar, m_core, m_params.linkDelay));
+      addRoute(*ar, RV_PREFIX, m_links.back()->faceA);
+      useKiteStrategy(*ar);
+    }
+    useKiteStrategy(m_core);
+    useKiteStrategy(m_rvNode);
+
+    auto& rvFace = m_rvNode.addFace("rv", FACE_SCOPE_LOCAL);
+    addRoute(m_rvNode, RV_PREFIX, rvFace);
+    m_rvApp = makeApp(rvFace, m_rvTransport);
+    m_rvApp->setInterestFilter(Name(RV_PREFIX).append(ndn::kite::KITE_KEYWORD),
+                               [this] (const auto&, const Interest& interest) { this->answerRequest(interest); });
+    m_consumer = makeApp(m_consumerNode.addFace("consumer", FACE_SCOPE_LOCAL), m_consumerTransport);
+
+    m_producers.resize(m_params.nProducers);
+    for (size_t i = 0; i < m_producers.size(); ++i) {
+      auto& mp = m_producers[i];
+      mp.prefix = Name("/mp").appendNumber(i);
+      mp.face = make_unique<ndn::Face>(mp.transport, getGlobalIoService(), m_keyChain);
+      mp.arFaces.resize(m_ars.size());
+      mp.face->setInterestFilter(mp.prefix,
+                                 [this, &mp] (const auto&, const Interest& interest) { this->produce(mp, interest); });
+    }
+  }
+
+  KiteHandoffResult
+  run(time::UnitTestSteadyClock& steadyClock, time::UnitTestSystemClock& systemClock)
+  {
+    std::uniform_int_distribution<size_t> pickAr(0, m_ars.size() - 1);
+    auto start = time::steady_clock::now();
+    m_endTime = start + m_params.duration;
+    for (size_t i = 0; i < m_producers.size(); ++i) {
+      auto& mp = m_producers[i];
+      attach(mp, pickAr(m_rng));
+      scheduleMove(mp);
+      // stagger the consumers so that Interests are spread over each interval
+      mp.consumerEvent = getScheduler().schedule(m_params.interestInterval * i / m_producers.size() + 1_s,
+                                                 [this, &mp] { this->consume(mp); });
+    }
+
+    auto& io = getGlobalIoService();
+    auto drainTime = m_endTime + m_params.interestLifetime + 1_s;
+    std::clock_t cpuStart = std::clock();
+    while (time::steady_clock::now() < drainTime) {
+      steadyClock.advance(TICK);
+      systemClock.advance(TICK);
+      if (io.stopped()) {
+#if BOOST_VERSION >= 106600
+        io.restart();
+#else
+        io.reset();
+#endif
+      }
+      io.poll();
+    }
+    m_result.cpuTime = std::clock() - cpuStart;
+
+    for (const auto* node : {&m_consumerNode, &m_core, &m_rvNode}) {
+      m_result.nPackets += countPackets(*node);
+    }
+    for (const auto& ar : m_ars) {
+      m_result.nPackets += countPackets(*ar);
+    }
+    return m_result;
+  }
+
+private:
+  static void
+  addRoute(BenchmarkNode& node, const Name& prefix, Face& face)
+  {
+    Fib& fib = node.forwarder.getFib();
+    fib.addOrUpdateNextHop(*fib.insert(prefix).first, face, 0);
+  }
+
+  static void
+  removeRoute(BenchmarkNode& node, const std::pair<Name, FaceId>& key)
+  {
+    Fib& fib = node.forwarder.getFib();
+    Face* face = node.faceTable.get(key.second);
+    fib::Entry* entry = fib.findExactMatch(key.first);
+    if (face != nullptr && entry != nullptr) {
+      fib.removeNextHop(*entry, *face);
+    }
+  }
+
+  static uint64_t
+  countPackets(const BenchmarkNode& node)
+  {
+    const auto& counters = node.forwarder.getCounters();
+    return counters.nInInterests + counters.nInData + counters.nInNacks;
+  }
+
+  void
+  useKiteStrategy(BenchmarkNode& node)
+  {
+    auto& sc = node.forwarder.getStrategyChoice();
+    BOOST_VERIFY(sc.insert("/", KiteStrategy::getStrategyName()));
+    auto& strategy = static_cast<KiteStrategy&>(sc.findEffectiveStrategy("/"));
+    strategy.setRibDispatch([this, &node] (std::vector<RouteUpdate> batch, RibUpdateCoalescer::DoneCallback done) {
+      this->emulateRib(node, std::move(batch), std::move(done));
+    });
+  }
+
+  /** \brief applies a batch of route updates directly to the FIB after the RIB delay
+   */
+  void
+  emulateRib(BenchmarkNode& node, std::vector<RouteUpdate> batch, RibUpdateCoalescer::DoneCallback done)
+  {
+    getScheduler().schedule(m_params.ribDelay, [&node, batch = std::move(batch), done = std::move(done)] {
+      for (const auto& update : batch) {
+        Face* face = node.faceTable.get(update.faceId);
+        if (face == nullptr) {
+          done(update, false);
+          continue;
+        }
+        auto key = std::make_pair(update.prefix, update.faceId);
+        if (update.action == RouteUpdate::Action::ANNOUNCE) {
+          addRoute(node, update.prefix, *face);
+          // decoding the announcement is part of the RIB's work
+          ndn::PrefixAnnouncement pa(Data(update.announcementData));
+          auto lifetime = std::min(pa.getExpiration(), update.maxLifetime);
+          node.routeExpiry[key] = getScheduler().schedule(lifetime, [&node, key] { removeRoute(node, key); });
+        }
+        else {
+          removeRoute(node, key);
+          node.routeExpiry.erase(key);
+        }
+        done(update, true);
+      }
+    });
+  }
+
+  unique_ptr<ndn::Face>
+  makeApp(Face& face, shared_ptr<InternalClientTransport>& transport)
+  {
+    transport = make_shared<InternalClientTransport>();
+    transport->connectToForwarder(&BenchmarkNode::getTransport(face));
+    return make_unique<ndn::Face>(transport, getGlobalIoService(), m_keyChain);
+  }
+
+  void
+  answerRequest(const Interest& interest)
+  {
+    ndn::kite::Request req;
+    try {
+      req.decode(interest);
+    }
+    catch (const ndn::kite::Request::Error&) {
+      return;
+    }
+    ndn::PrefixAnnouncement pa;
+    pa.setAnnouncedName(req.getProducerPrefix());
+    pa.setExpiration(req.getExpiration().value_or(m_params.announcementLifetime));
+    ndn::kite::Ack ack;
+    ack.setPrefixAnnouncement(std::move(pa));
+    m_rvApp->put(ack.makeData(interest, m_keyChain, ndn::security::signingWithSha256()));
+  }
+
+  void
+  attach(MobileProducer& mp, size_t ar)
+  {
+    Face*& arFace = mp.arFaces[ar];
+    if (arFace == nullptr) {
+      arFace = &m_ars[ar]->addFace(mp.prefix.toUri(), FACE_SCOPE_NON_LOCAL);
+    }
+    mp.transport->connectToForwarder(&BenchmarkNode::getTransport(*arFace));
+    mp.ar = ar;
+    ++mp.epoch;
+    mp.attachTime = time::steady_clock::now();
+    mp.hasRecovered = false;
+
+    ndn::kite::Request req;
+    req.setRvPrefix(RV_PREFIX);
+    req.setProducerSuffix(mp.prefix);
+    req.setExpiration(m_params.announcementLifetime);
+    mp.face->expressInterest(req.makeInterest(m_signer, ndn::security::signingWithSha256()),
+                             [this] (const Interest&, const Data&) { ++m_result.nAcks; },
+                             [] (const Interest&, const lp::Nack&) {},
+                             [] (const Interest&) {});
+  }
+
+  void
+  scheduleMove(MobileProducer& mp)
+  {
+    std::uniform_real_distribution<double> jitter(0.5, 1.5);
+    auto dwell = time::duration_cast<time::nanoseconds>(m_params.dwellTime * jitter(m_rng));
+    mp.moveEvent = getScheduler().schedule(dwell, [this, &mp] {
+      if (time::steady_clock::now() >= m_endTime) {
+        return;
+      }
+      std::uniform_int_distribution<size_t> pickAr(1, m_ars.size() - 1);
+      ++m_result.nHandoffs;
+      attach(mp, (mp.ar + pickAr(m_rng)) % m_ars.size());
+      scheduleMove(mp);
+    });
+  }
+
+  void
+  consume(MobileProducer& mp)
+  {
+    if (time::steady_clock::now() >= m_endTime) {
+      return;
+    }
+    Interest interest(Name(mp.prefix).appendNumber(mp.seq++));
+    interest.setForwardingHint({Name().append(ndn::kite::KITE_KEYWORD).append(RV_PREFIX)});
+    interest.setInterestLifetime(m_params.interestLifetime);
+    ++m_result.nExpressed;
+    m_consumer->expressInterest(interest,
+      [this, &mp] (const Interest&, const Data& data) {
+        ++m_result.nSatisfied;
+        if (readNonNegativeInteger(data.getContent()) == mp.epoch && !mp.hasRecovered) {
+          mp.hasRecovered = true;
+          if (mp.epoch > 1) {
+            m_result.recoveryTimes.push_back(time::steady_clock::now() - mp.attachTime);
+          }
+        }
+      },
+      [this] (const Interest&, const lp::Nack&) { ++m_result.nNacked; },
+      [this] (const Interest&) { ++m_result.nTimedOut; });
+    mp.consumerEvent = getScheduler().schedule(m_params.interestInterval, [this, &mp] { this->consume(mp); });
+  }
+
+  void
+  produce(MobileProducer& mp, const Interest& interest)
+  {
+    Data data(interest.getName());
+    data.setContent(ndn::encoding::makeNonNegativeIntegerBlock(tlv::Content, mp.epoch));
+    m_keyChain.sign(data, ndn::security::signingWithSha256());
+    mp.face->put(data);
+  }
+
+private:
+  static const Name RV_PREFIX;
+  static constexpr time::milliseconds TICK = 1_ms;
+
+  const KiteHandoffParams m_params;
+  std::mt19937 m_rng;
+  time::steady_clock::TimePoint m_endTime;
+  KiteHandoffResult m_result;
+
+  BenchmarkNode m_consumerNode;
+  BenchmarkNode m_core;
+  BenchmarkNode m_rvNode;
+  std::vector<unique_ptr<BenchmarkNode>> m_ars;
+  std::vector<unique_ptr<BenchmarkLink>> m_links;
+
+  ndn::KeyChain m_keyChain;
+  ndn::security::InterestSigner m_signer;
+  shared_ptr<InternalClientTransport> m_rvTransport;
+  unique_ptr<ndn::Face> m_rvApp;
+  shared_ptr<InternalClientTransport> m_consumerTransport;
+  unique_ptr<ndn::Face> m_consumer;
+  std::vector<MobileProducer> m_producers;
+};
+
+const Name KiteHandoffSimulation::RV_PREFIX("/rv");
+constexpr time::milliseconds KiteHandoffSimulation::TICK;
+
+class KiteHandoffBenchmarkFixture
+{
+protected:
+  KiteHandoffBenchmarkFixture()
+    : m_steadyClock(make_shared<time::UnitTestSteadyClock>())
+    , m_systemClock(make_shared<time::UnitTestSystemClock>())
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+    time::setCustomClocks(m_steadyClock, m_systemClock);
+  }
+
+  ~KiteHandoffBenchmarkFixture()
+  {
+    time::setCustomClocks(nullptr, nullptr);
+  }
+
+  void
+  runScenario(const std::string& title, const KiteHandoffParams& params)
+  {
+    KiteHandoffResult result;
+    {
+      KiteHandoffSimulation sim(params);
+      result = sim.run(*m_steadyClock, *m_systemClock);
+    }
+    resetGlobalIoService();
+
+    auto ms = [] (time::nanoseconds d) {
+      return time::duration_cast<time::duration<double, boost::milli>>(d).count();
+    };
+    uint64_t nCompleted = result.nSatisfied + result.nNacked + result.nTimedOut;
+    auto& recovery = result.recoveryTimes;
+    std::sort(recovery.begin(), recovery.end());
+    auto percentile = [&recovery] (double p) {
+      return recovery[std::min(recovery.size() - 1, static_cast<size_t>(p * recovery.size()))];
+    };
+
+    std::cout << title << ": " << params.nProducers << " producers, "
+              << params.nAccessRouters << " access routers, dwell " << params.dwellTime << ", "
+              << "Interest every " << params.interestInterval << ", link delay " << params.linkDelay << ", "
+              << "RIB delay " << params.ribDelay << ", " << params.duration << " simulated\n"
+              << std::fixed << std::setprecision(2)
+              << "  Interests: expressed=" << result.nExpressed << " satisfied=" << result.nSatisfied
+              << " nacked=" << result.nNacked << " timed-out=" << result.nTimedOut
+              << " satisfaction=" << (nCompleted == 0 ? 0.0 : 100.0 * result.nSatisfied / nCompleted) << "%\n"
+              << "  Handoffs: " << result.nHandoffs << " acks=" << result.nAcks
+              << " recovered=" << recovery.size();
+    if (!recovery.empty()) {
+      auto total = std::accumulate(recovery.begin(), recovery.end(), time::nanoseconds::zero());
+      std::cout << " recovery mean=" << ms(total / recovery.size()) << "ms"
+                << " p50=" << ms(percentile(0.5)) << "ms"
+                << " p95=" << ms(percentile(0.95)) << "ms"
+                << " max=" << ms(recovery.back()) << "ms";
+    }
+    std::cout << "\n"
+              << "  Forwarders: packets=" << result.nPackets
+              << " cpu=" << (result.nPackets == 0 ? 0.0 :
+                             1e6 * result.cpuTime / CLOCKS_PER_SEC / result.nPackets) << "us/packet"
+              << std::endl;
+  }
+
+private:
+  shared_ptr<time::UnitTestSteadyClock> m_steadyClock;
+  shared_ptr<time::UnitTestSystemClock> m_systemClock;
+};
+
+BOOST_FIXTURE_TEST_SUITE(KiteHandoffBenchmark, KiteHandoffBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Baseline)
+{
+  KiteHandoffParams params;
+  runScenario("Baseline", params);
+}
+
+BOOST_AUTO_TEST_CASE(FastMobility)
+{
+  KiteHandoffParams params;
+  params.dwellTime = 500_ms;
+  runScenario("FastMobility", params);
+}
+
+BOOST_AUTO_TEST_CASE(SlowRib)
+{
+  KiteHandoffParams params;
+  params.dwellTime = 1_s;
+  params.ribDelay = 50_ms;
+  runScenario("SlowRib", params);
+}
+
+BOOST_AUTO_TEST_CASE(ManyProducers)
+{
+  KiteHandoffParams params;
+  params.nProducers = 200;
+  params.nAccessRouters = 8;
+  params.interestInterval = 100_ms;
+  params.duration = 20_s;
+  runScenario("ManyProducers", params);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // KiteHandoffBenchmark
+
+} // namespace tests
+} // namespace nfd
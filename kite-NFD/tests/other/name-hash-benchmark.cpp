@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark-helpers.hpp"
+#include "common/city-hash.hpp"
+#include "common/crc32c.hpp"
+#include "table/name-tree-hashtable.hpp"
+
+#include <iostream>
+
+#ifdef NFD_HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+using name_tree::HashSequence;
+using name_tree::HashValue;
+
+class NameHashBenchmarkFixture
+{
+protected:
+  NameHashBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    std::cerr << "Benchmark compiled in debug mode is unreliable, please compile in release mode.\n";
+#endif
+  }
+
+  static time::microseconds
+  timedRun(const std::function<void()>& f)
+  {
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    auto t1 = time::steady_clock::now();
+    f();
+    auto t2 = time::steady_clock::now();
+
+#ifdef NFD_HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+  /** \brief the previous prefix hashing: CityHash64 of each component, visited through Name::at
+   */
+  static HashSequence
+  computeHashesCity(const Name& name)
+  {
+    name.wireEncode();
+
+    HashSequence seq;
+    seq.reserve(name.size() + 1);
+
+    HashValue h = 0;
+    seq.push_back(h);
+    for (const auto& comp : name) {
+      h ^= CityHash64(reinterpret_cast<const char*>(comp.data()), comp.size());
+      seq.push_back(h);
+    }
+    return seq;
+  }
+
+  static std::vector<Name>
+  makeNames(size_t count, size_t nComps, size_t compLength)
+  {
+    std::vector<Name> names(count);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < nComps; ++j) {
+        std::string comp = to_string(i * nComps + j);
+        comp.resize(compLength, 'x');
+        names[i].append(comp);
+      }
+      names[i].wireEncode();
+    }
+    return names;
+  }
+
+  template<typename F>
+  void
+  run(const std::string& label, const std::vector<Name>& names, const F& f)
+  {
+    size_t sink = 0;
+    time::microseconds d = timedRun([&] {
+      for (size_t r = 0; r < REPEAT; ++r) {
+        for (const Name& name : names) {
+          sink += f(name).back();
+        }
+      }
+    });
+    std::cout << label << " " << (names.size() * REPEAT) << ": " << d << std::endl;
+    // prevent the computation from being optimized away
+    BOOST_CHECK_NE(sink, 1);
+  }
+
+  void
+  compare(const std::vector<Name>& names)
+  {
+    run("CityHash", names, &computeHashesCity);
+    run("computeHashes", names, [] (const Name& name) {
+      return name_tree::computeHashes(name);
+    });
+  }
+
+protected:
+  static constexpr size_t N_NAMES = 100000;
+  static constexpr size_t REPEAT = 20;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NameHash, NameHashBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(ShortComponents)
+{
+  std::cout << "CRC32C instruction: " << (hasCrc32cInstruction() ? "yes" : "no") << std::endl;
+  compare(makeNames(N_NAMES, 6, 4));
+}
+
+BOOST_AUTO_TEST_CASE(LongComponents)
+{
+  compare(makeNames(N_NAMES, 4, 40));
+}
+
+BOOST_AUTO_TEST_CASE(Crc32c)
+{
+  std::vector<uint8_t> buf(64);
+  for (size_t length : {8, 16, 64}) {
+    uint32_t sink = 0;
+    time::microseconds portable = timedRun([&] {
+      for (size_t i = 0; i < N_NAMES * REPEAT; ++i) {
+        sink ^= crc32cPortable(buf.data(), length, sink);
+      }
+    });
+    std::cout << "crc32cPortable(" << length << ") " << (N_NAMES * REPEAT) << ": " << portable << std::endl;
+
+    if (hasCrc32cInstruction()) {
+      time::microseconds sse42 = timedRun([&] {
+        for (size_t i = 0; i < N_NAMES * REPEAT; ++i) {
+          sink ^= crc32cSse42(buf.data(), length, sink);
+        }
+      });
+      std::cout << "crc32cSse42(" << length << ") " << (N_NAMES * REPEAT) << ": " << sse42 << std::endl;
+    }
+    BOOST_CHECK_NE(sink, 1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // NameHash
+
+} // namespace tests
+} // namespace nfd
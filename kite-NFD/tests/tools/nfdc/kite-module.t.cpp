@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2019,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nfdc/kite-module.hpp"
+
+#include "status-fixture.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Nfdc)
+BOOST_FIXTURE_TEST_SUITE(TestKiteModule, StatusFixture<KiteModule>)
+
+const std::string STATUS_XML = stripXmlSpaces(R"XML(
+  <kiteProducers>
+    <kiteProducer>
+      <prefix>/mp/A</prefix>
+      <nPendingInterests>5</nPendingInterests>
+      <nHandoffs>2</nHandoffs>
+      <nNackFallbacks>7</nNackFallbacks>
+      <nTimeoutFallbacks>3</nTimeoutFallbacks>
+      <routeInstallLatency>PT0.012S</routeInstallLatency>
+      <routeLifetime>PT30S</routeLifetime>
+    </kiteProducer>
+    <kiteProducer>
+      <prefix>/mp/B</prefix>
+      <nPendingInterests>0</nPendingInterests>
+      <nHandoffs>0</nHandoffs>
+      <nNackFallbacks>0</nNackFallbacks>
+      <nTimeoutFallbacks>1</nTimeoutFallbacks>
+    </kiteProducer>
+  </kiteProducers>
+)XML");
+
+const std::string STATUS_TEXT = std::string(R"TEXT(
+KITE producers:
+  /mp/A pending=5 handoffs=2 nack-fallbacks=7 timeout-fallbacks=3 route-install=12500us route-lifetime=30000ms
+  /mp/B pending=0 handoffs=0 nack-fallbacks=0 timeout-fallbacks=1
+)TEXT").substr(1);
+
+BOOST_AUTO_TEST_CASE(Status)
+{
+  this->fetchStatus();
+  KiteProducerStatus payload1;
+  payload1.setPrefix("/mp/A")
+          .setNPendingInterests(5)
+          .setNHandoffs(2)
+          .setNNackFallbacks(7)
+          .setNTimeoutFallbacks(3)
+          .setRouteInstallLatency(12500_us)
+          .setRouteLifetime(30_s);
+  KiteProducerStatus payload2;
+  payload2.setPrefix("/mp/B")
+          .setNTimeoutFallbacks(1);
+  this->sendDataset("/localhost/nfd/kite/list", payload1, payload2);
+  this->prepareStatusOutput();
+
+  BOOST_CHECK(statusXml.is_equal(STATUS_XML));
+  BOOST_CHECK(statusText.is_equal(STATUS_TEXT));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteModule
+BOOST_AUTO_TEST_SUITE_END() // Nfdc
+
+} // namespace tests
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
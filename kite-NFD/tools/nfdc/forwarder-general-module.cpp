@@ -91,6 +91,14 @@ ForwarderGeneralModule::formatItemXml(std::ostream& os, const ForwarderStatus& i
   os << "<nSatisfiedInterests>" << item.getNSatisfiedInterests() << "</nSatisfiedInterests>";
   os << "<nUnsatisfiedInterests>" << item.getNUnsatisfiedInterests() << "</nUnsatisfiedInterests>";
 
+  if (!item.getNameTreeResizePauses().empty()) {
+    os << "<nameTreeResizePauses>";
+    for (uint64_t n : item.getNameTreeResizePauses()) {
+      os << "<nPauses>" << n << "</nPauses>";
+    }
+    os << "</nameTreeResizePauses>";
+  }
+
   os << "</generalStatus>";
 }
 
@@ -127,6 +135,14 @@ ForwarderGeneralModule::formatItemText(std::ostream& os, const ForwarderStatus&
      << ia("nSatisfiedInterests") << item.getNSatisfiedInterests()
      << ia("nUnsatisfiedInterests") << item.getNUnsatisfiedInterests();
 
+  if (!item.getNameTreeResizePauses().empty()) {
+    os << ia("nameTreeResizePauses");
+    text::Separator sep(" ");
+    for (uint64_t n : item.getNameTreeResizePauses()) {
+      os << sep << n;
+    }
+  }
+
   os << ia.end();
 }
 
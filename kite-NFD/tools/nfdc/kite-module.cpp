@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2022,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *                           Harbin Institute of Technology
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "kite-module.hpp"
+#include "format-helpers.hpp"
+
+namespace nfd {
+namespace tools {
+namespace nfdc {
+
+void
+KiteModule::fetchStatus(Controller& controller,
+                        const std::function<void()>& onSuccess,
+                        const Controller::DatasetFailCallback& onFailure,
+                        const CommandOptions& options)
+{
+  controller.fetch<ndn::nfd::KiteProducerDataset>(
+    [this, onSuccess] (const std::vector<KiteProducerStatus>& result) {
+      m_status = result;
+      onSuccess();
+    },
+    onFailure, options);
+}
+
+void
+KiteModule::formatStatusXml(std::ostream& os) const
+{
+  os << "<kiteProducers>";
+  for (const KiteProducerStatus& item : m_status) {
+    this->formatItemXml(os, item);
+  }
+  os << "</kiteProducers>";
+}
+
+void
+KiteModule::formatItemXml(std::ostream& os, const KiteProducerStatus& item) const
+{
+  os << "<kiteProducer>";
+
+  os << "<prefix>" << xml::Text{item.getPrefix().toUri()} << "</prefix>";
+  os << "<nPendingInterests>" << item.getNPendingInterests() << "</nPendingInterests>";
+  os << "<nHandoffs>" << item.getNHandoffs() << "</nHandoffs>";
+  os << "<nNackFallbacks>" << item.getNNackFallbacks() << "</nNackFallbacks>";
+  os << "<nTimeoutFallbacks>" << item.getNTimeoutFallbacks() << "</nTimeoutFallbacks>";
+  if (item.hasRouteInstallLatency()) {
+    os << "<routeInstallLatency>" << xml::formatDuration(item.getRouteInstallLatency())
+       << "</routeInstallLatency>";
+  }
+  if (item.hasRouteLifetime()) {
+    os << "<routeLifetime>" << xml::formatDuration(item.getRouteLifetime()) << "</routeLifetime>";
+  }
+
+  os << "</kiteProducer>";
+}
+
+void
+KiteModule::formatStatusText(std::ostream& os) const
+{
+  os << "KITE producers:\n";
+  for (const KiteProducerStatus& item : m_status) {
+    this->formatItemText(os, item);
+  }
+}
+
+void
+KiteModule::formatItemText(std::ostream& os, const KiteProducerStatus& item) const
+{
+  text::ItemAttributes ia;
+  os << "  " << item.getPrefix() << ' '
+     << ia("pending") << item.getNPendingInterests()
+     << ia("handoffs") << item.getNHandoffs()
+     << ia("nack-fallbacks") << item.getNNackFallbacks()
+     << ia("timeout-fallbacks") << item.getNTimeoutFallbacks();
+  if (item.hasRouteInstallLatency()) {
+    os << ia("route-install") << text::formatDuration<time::microseconds>(item.getRouteInstallLatency());
+  }
+  if (item.hasRouteLifetime()) {
+    os << ia("route-lifetime") << text::formatDuration<time::milliseconds>(item.getRouteLifetime());
+  }
+  os << ia.end();
+  os << "\n";
+}
+
+} // namespace nfdc
+} // namespace tools
+} // namespace nfd
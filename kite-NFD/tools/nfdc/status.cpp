@@ -31,6 +31,7 @@
 #include "rib-module.hpp"
 #include "cs-module.hpp"
 #include "strategy-choice-module.hpp"
+#include "kite-module.hpp"
 
 #include <ndn-cxx/security/validator-null.hpp>
 
@@ -71,6 +72,10 @@ reportStatus(ExecuteContext& ctx, const StatusReportOptions& options)
     report.sections.push_back(make_unique<StrategyChoiceModule>());
   }
 
+  if (options.wantKite) {
+    report.sections.push_back(make_unique<KiteModule>());
+  }
+
   uint32_t code = report.collect(ctx.face, ctx.keyChain,
                                  ndn::security::getAcceptAllValidator(),
                                  CommandOptions());
@@ -152,6 +157,13 @@ registerStatusCommands(CommandParser& parser)
   parser.addCommand(defCsInfo,
                     std::bind(&reportStatusSingleSection, _1, &StatusReportOptions::wantCs));
   parser.addAlias("cs", "info", "");
+
+  CommandDefinition defKiteList("kite", "list");
+  defKiteList
+    .setTitle("print KITE mobile producers");
+  parser.addCommand(defKiteList,
+                    std::bind(&reportStatusSingleSection, _1, &StatusReportOptions::wantKite));
+  parser.addAlias("kite", "list", "");
 }
 
 } // namespace nfdc
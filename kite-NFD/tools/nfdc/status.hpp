@@ -43,6 +43,7 @@ struct StatusReportOptions
   bool wantRib = false;
   bool wantCs = false;
   bool wantStrategyChoice = false;
+  bool wantKite = false;
 };
 
 /** \brief collect a status report and write to stdout
@@ -58,6 +59,7 @@ reportStatus(ExecuteContext& ctx, const StatusReportOptions& options);
  *  \li channel list
  *  \li strategy list
  *  \li fib list
+ *  \li kite list
  *  \li route list
  */
 void
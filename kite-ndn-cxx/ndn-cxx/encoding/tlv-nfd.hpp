@@ -85,6 +85,8 @@ enum {
   NOutBytes             = 149,
   NSatisfiedInterests   = 153,
   NUnsatisfiedInterests = 154,
+  NameTreeResizePauses  = 155,
+  NPauses               = 156,
 
   // Content Store Management
   CsInfo  = 128,
@@ -100,7 +102,16 @@ enum {
 
   // RIB Management
   RibEntry = 128,
-  Route    = 129
+  Route    = 129,
+
+  // KITE Management
+  KiteProducerStatus  = 128,
+  NPendingInterests   = 129,
+  NHandoffs           = 130,
+  NNackFallbacks      = 131,
+  NTimeoutFallbacks   = 132,
+  RouteInstallLatency = 133,
+  RouteLifetime       = 134
 };
 
 } // namespace nfd
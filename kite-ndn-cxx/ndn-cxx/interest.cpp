@@ -22,6 +22,7 @@
 #include "ndn-cxx/interest.hpp"
 #include "ndn-cxx/data.hpp"
 #include "ndn-cxx/encoding/buffer-stream.hpp"
+#include "ndn-cxx/kite/request.hpp"
 #include "ndn-cxx/security/transform/digest-filter.hpp"
 #include "ndn-cxx/security/transform/step-source.hpp"
 #include "ndn-cxx/security/transform/stream-sink.hpp"
@@ -183,6 +184,8 @@ Interest::wireDecode(const Block& wire)
 
   m_canBePrefix = m_mustBeFresh = false;
   m_forwardingHint.clear();
+  m_kiteHints.clear();
+  m_nKiteDelegations = 0;
   m_nonce.reset();
   m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
   m_hopLimit.reset();
@@ -248,6 +251,7 @@ Interest::wireDecode(const Block& wire)
               break;
           }
         }
+        extractKiteHints();
         lastElement = 4;
         break;
       }
@@ -385,10 +389,28 @@ Interest&
 Interest::setForwardingHint(std::vector<Name> value)
 {
   m_forwardingHint = std::move(value);
+  extractKiteHints();
   m_wire.reset();
   return *this;
 }
 
+void
+Interest::extractKiteHints()
+{
+  m_kiteHints.clear();
+  m_nKiteDelegations = 0;
+  for (const auto& delegation : m_forwardingHint) {
+    if (delegation.empty() || delegation[0] != kite::KITE_KEYWORD) {
+      continue;
+    }
+    ++m_nKiteDelegations;
+    // a lone keyword carries no RV prefix
+    if (delegation.size() > 1) {
+      m_kiteHints.push_back(delegation.getSubName(1));
+    }
+  }
+}
+
 static auto
 generateNonce()
 {
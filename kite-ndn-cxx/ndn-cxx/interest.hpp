@@ -227,6 +227,31 @@ public: // element access
   Interest&
   setForwardingHint(std::vector<Name> value);
 
+  /** @brief Get the RV prefixes carried by KITE delegations in the ForwardingHint.
+   *
+   *  A KITE delegation is a ForwardingHint name whose first component is kite::KITE_KEYWORD,
+   *  followed by at least one component.
+   *  The returned names are those delegations without the keyword, in ForwardingHint order.
+   *  They are extracted once, when the ForwardingHint is decoded or set, and their components
+   *  share the underlying buffer of the ForwardingHint.
+   */
+  span<const Name>
+  getKiteHints() const noexcept
+  {
+    return m_kiteHints;
+  }
+
+  /** @brief Get the number of ForwardingHint delegations whose first component is kite::KITE_KEYWORD.
+   *
+   *  Unlike getKiteHints(), this also counts a lone keyword. Zero means that no delegation
+   *  needs to be checked for the keyword.
+   */
+  size_t
+  getNKiteDelegations() const noexcept
+  {
+    return m_nKiteDelegations;
+  }
+
   /** @brief Check if the Nonce element is present.
    */
   bool
@@ -484,11 +509,16 @@ private:
   std::vector<Block>::const_iterator
   findFirstParameter(uint32_t type) const;
 
+  void
+  extractKiteHints();
+
 private:
   static bool s_autoCheckParametersDigest;
 
   Name m_name;
   std::vector<Name> m_forwardingHint;
+  std::vector<Name> m_kiteHints;
+  size_t m_nKiteDelegations = 0;
   mutable optional<Nonce> m_nonce;
   time::milliseconds m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
   optional<uint8_t> m_hopLimit;
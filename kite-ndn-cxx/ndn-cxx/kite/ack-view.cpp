@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/kite/ack-view.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
+
+#include <array>
+
+namespace ndn {
+namespace kite {
+
+/** \brief Read the TLV element at \p pos within \p parent, sharing the buffer of \p parent.
+ *  \post \p pos points past the element
+ */
+static Block
+readElement(const Block& parent, Block::const_iterator& pos)
+{
+  auto begin = pos;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(pos, parent.value_end(), type) ||
+      !tlv::readVarNumber(pos, parent.value_end(), length) ||
+      length > static_cast<uint64_t>(std::distance(pos, parent.value_end()))) {
+    NDN_THROW(AckView::Error("Truncated TLV element in KITE acknowledgment"));
+  }
+  auto valueBegin = pos;
+  pos += length;
+  return Block(parent.getBuffer(), type, begin, pos, valueBegin, pos);
+}
+
+AckView::AckView(const Data& data)
+{
+  if (data.getContentType() != tlv::ContentType_KiteAck) {
+    NDN_THROW(Error("Not a KITE acknowledgment, ContentType is " +
+                    to_string(data.getContentType())));
+  }
+
+  const Block& content = data.getContent();
+  if (!content.hasWire()) {
+    NDN_THROW(Error("No valid prefix announcement"));
+  }
+  for (auto pos = content.value_begin(); pos != content.value_end();) {
+    Block element = readElement(content, pos);
+    if (element.type() == tlv::Data) {
+      m_paData = std::move(element);
+      break;
+    }
+  }
+  if (!m_paData.isValid()) {
+    NDN_THROW(Error("No valid prefix announcement"));
+  }
+
+  try {
+    decodePrefixAnnouncement();
+  }
+  catch (const Error&) {
+    throw;
+  }
+  catch (const tlv::Error&) {
+    NDN_THROW_NESTED(Error("No valid prefix announcement"));
+  }
+}
+
+void
+AckView::decodePrefixAnnouncement()
+{
+  // the same structure as checked by PrefixAnnouncement(Data)
+  auto pos = m_paData.value_begin();
+  if (pos == m_paData.value_end()) {
+    NDN_THROW(Error("Prefix announcement is empty"));
+  }
+  Block name = readElement(m_paData, pos);
+  if (name.type() != tlv::Name) {
+    NDN_THROW(Error("Prefix announcement does not start with a Name"));
+  }
+
+  // remember where each of the last three components begins
+  std::array<Block, 3> lastComponents;
+  size_t nComponents = 0;
+  for (auto cpos = name.value_begin(); cpos != name.value_end(); ++nComponents) {
+    lastComponents[nComponents % 3] = readElement(name, cpos);
+  }
+  if (nComponents < 3 ||
+      name::Component(lastComponents[(nComponents - 3) % 3]) != PrefixAnnouncement::getKeywordComponent() ||
+      !name::Component(lastComponents[(nComponents - 2) % 3]).isVersion() ||
+      !name::Component(lastComponents[(nComponents - 1) % 3]).isSegment()) {
+    NDN_THROW(Error("Data is not a prefix announcement: wrong name structure"));
+  }
+  const Block& keyword = lastComponents[(nComponents - 3) % 3];
+  m_announcedName = make_span(&*name.value_begin(),
+                              static_cast<size_t>(std::distance(name.value_begin(), keyword.begin())));
+
+  uint64_t contentType = tlv::ContentType_Blob;
+  Block payload;
+  while (pos != m_paData.value_end()) {
+    Block element = readElement(m_paData, pos);
+    if (element.type() == tlv::MetaInfo) {
+      for (auto mpos = element.value_begin(); mpos != element.value_end();) {
+        Block field = readElement(element, mpos);
+        if (field.type() == tlv::ContentType) {
+          contentType = readNonNegativeInteger(field);
+        }
+      }
+    }
+    else if (element.type() == tlv::Content) {
+      payload = std::move(element);
+    }
+    else if (element.type() == tlv::SignatureInfo) {
+      break;
+    }
+  }
+
+  if (contentType != tlv::ContentType_PrefixAnn) {
+    NDN_THROW(Error("Data is not a prefix announcement: ContentType is " + to_string(contentType)));
+  }
+  if (!payload.isValid() || payload.value_size() == 0) {
+    NDN_THROW(Error("Prefix announcement is empty"));
+  }
+
+  bool hasExpiration = false;
+  for (auto ppos = payload.value_begin(); ppos != payload.value_end();) {
+    Block element = readElement(payload, ppos);
+    if (element.type() == tlv::nfd::ExpirationPeriod) {
+      if (!hasExpiration) {
+        m_expiration = time::milliseconds(readNonNegativeInteger(element));
+        hasExpiration = true;
+      }
+    }
+    else if (element.type() == tlv::ValidityPeriod) {
+      if (m_validity.empty()) {
+        m_validity = make_span(element.wire(), element.size());
+      }
+    }
+    else if (tlv::isCriticalType(element.type())) {
+      NDN_THROW(Error("Unrecognized element of critical type " + to_string(element.type())));
+    }
+  }
+  if (!hasExpiration) {
+    NDN_THROW(Error("Prefix announcement has no ExpirationPeriod"));
+  }
+}
+
+Name
+AckView::getAnnouncedName() const
+{
+  return Name(makeBinaryBlock(tlv::Name, m_announcedName));
+}
+
+} // namespace kite
+} // namespace ndn
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_KITE_ACK_VIEW_HPP
+#define NDN_KITE_ACK_VIEW_HPP
+
+#include "ndn-cxx/kite/ack.hpp"
+
+namespace ndn {
+namespace kite {
+
+/** \brief Read-only view of a KITE acknowledgment.
+ *
+ *  Ack decodes the embedded PrefixAnnouncement into its own Data, Name, and ValidityPeriod.
+ *  AckView only walks the TLV structure of the Ack content. Its accessors return spans into
+ *  the wire encoding of the original Data, and constructing it does not allocate. The view
+ *  shares the wire buffer of the Data, so it stays valid after the Data is destroyed.
+ *
+ *  As with Ack, the signature of the prefix announcement is not checked.
+ */
+class AckView
+{
+public:
+  using Error = Ack::Error;
+
+  /** \brief Decode a KITE acknowledgment from Data.
+   *  \throw Error \p data is not a KITE acknowledgment, or does not carry a well-formed
+   *               prefix announcement.
+   */
+  explicit
+  AckView(const Data& data);
+
+  /** \brief Get the TLV-VALUE of the announced name, i.e., its encoded name components.
+   */
+  span<const uint8_t>
+  getAnnouncedNameWire() const
+  {
+    return m_announcedName;
+  }
+
+  /** \brief Get the announced name.
+   *  \note Unlike the other accessors, this allocates a Name.
+   */
+  Name
+  getAnnouncedName() const;
+
+  /** \brief Get the expiration period of the prefix announcement.
+   */
+  time::milliseconds
+  getExpiration() const
+  {
+    return m_expiration;
+  }
+
+  /** \brief Get the wire encoding of the ValidityPeriod element.
+   *  \return the ValidityPeriod TLV, or an empty span if the announcement does not have one
+   */
+  span<const uint8_t>
+  getValidityPeriodWire() const
+  {
+    return m_validity;
+  }
+
+  /** \brief Get the prefix announcement Data element, sharing the buffer of the Ack.
+   *
+   *  This can be passed to another thread and decoded into a PrefixAnnouncement there.
+   */
+  const Block&
+  getPrefixAnnouncementData() const
+  {
+    return m_paData;
+  }
+
+private:
+  void
+  decodePrefixAnnouncement();
+
+private:
+  Block m_paData;
+  span<const uint8_t> m_announcedName;
+  time::milliseconds m_expiration = 0_ms;
+  span<const uint8_t> m_validity;
+};
+
+} // namespace kite
+} // namespace ndn
+
+#endif // NDN_KITE_ACK_VIEW_HPP
@@ -58,6 +58,16 @@ ForwarderStatus::wireEncode(EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  if (!m_nameTreeResizePauses.empty()) {
+    size_t pausesLength = 0;
+    for (auto it = m_nameTreeResizePauses.rbegin(); it != m_nameTreeResizePauses.rend(); ++it) {
+      pausesLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NPauses, *it);
+    }
+    pausesLength += encoder.prependVarNumber(pausesLength);
+    pausesLength += encoder.prependVarNumber(tlv::nfd::NameTreeResizePauses);
+    totalLength += pausesLength;
+  }
+
   totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NUnsatisfiedInterests, m_nUnsatisfiedInterests);
   totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NSatisfiedInterests, m_nSatisfiedInterests);
   totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, m_nOutNacks);
@@ -238,6 +248,18 @@ ForwarderStatus::wireDecode(const Block& block)
   else {
     NDN_THROW(Error("missing required NUnsatisfiedInterests field"));
   }
+
+  m_nameTreeResizePauses.clear();
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NameTreeResizePauses) {
+    val->parse();
+    for (const auto& element : val->elements()) {
+      if (element.type() != tlv::nfd::NPauses) {
+        NDN_THROW(Error("NPauses", element.type()));
+      }
+      m_nameTreeResizePauses.push_back(readNonNegativeInteger(element));
+    }
+    ++val;
+  }
 }
 
 ForwarderStatus&
@@ -368,6 +390,14 @@ ForwarderStatus::setNUnsatisfiedInterests(uint64_t nUnsatisfiedInterests)
   return *this;
 }
 
+ForwarderStatus&
+ForwarderStatus::setNameTreeResizePauses(std::vector<uint64_t> nameTreeResizePauses)
+{
+  m_wire.reset();
+  m_nameTreeResizePauses = std::move(nameTreeResizePauses);
+  return *this;
+}
+
 bool
 operator==(const ForwarderStatus& a, const ForwarderStatus& b)
 {
@@ -386,7 +416,8 @@ operator==(const ForwarderStatus& a, const ForwarderStatus& b)
       a.getNOutData() == b.getNOutData() &&
       a.getNOutNacks() == b.getNOutNacks() &&
       a.getNSatisfiedInterests() == b.getNSatisfiedInterests() &&
-      a.getNUnsatisfiedInterests() == b.getNUnsatisfiedInterests();
+      a.getNUnsatisfiedInterests() == b.getNUnsatisfiedInterests() &&
+      a.getNameTreeResizePauses() == b.getNameTreeResizePauses();
 }
 
 std::ostream&
@@ -407,8 +438,18 @@ operator<<(std::ostream& os, const ForwarderStatus& status)
      << "                         Nacks: {in: " << status.getNInNacks() << ", "
      << "out: " << status.getNOutNacks() << "},\n"
      << "                         SatisfiedInterests: " << status.getNSatisfiedInterests() << ",\n"
-     << "                         UnsatisfiedInterests: " << status.getNUnsatisfiedInterests() << "}\n"
-     << "              )";
+     << "                         UnsatisfiedInterests: " << status.getNUnsatisfiedInterests() << "}";
+
+  const auto& pauses = status.getNameTreeResizePauses();
+  if (!pauses.empty()) {
+    os << ",\n              NameTreeResizePauses: [";
+    for (size_t i = 0; i < pauses.size(); ++i) {
+      os << (i == 0 ? "" : ", ") << pauses[i];
+    }
+    os << "]";
+  }
+
+  os << "\n              )";
 
   return os;
 }
@@ -214,6 +214,22 @@ public: // getters & setters
   ForwarderStatus&
   setNUnsatisfiedInterests(uint64_t nUnsatisfiedInterests);
 
+  /** \brief get number of NameTree resize pauses per duration bin
+   *
+   *  Bin 0 counts pauses shorter than 1 microsecond, bin i counts pauses shorter than
+   *  10^i microseconds but not shorter than 10^(i-1) microseconds, and the last bin
+   *  counts all longer pauses. This field is optional; it is empty if the forwarder
+   *  did not report it.
+   */
+  const std::vector<uint64_t>&
+  getNameTreeResizePauses() const
+  {
+    return m_nameTreeResizePauses;
+  }
+
+  ForwarderStatus&
+  setNameTreeResizePauses(std::vector<uint64_t> nameTreeResizePauses);
+
 private:
   std::string m_nfdVersion;
   time::system_clock::TimePoint m_startTimestamp;
@@ -231,6 +247,7 @@ private:
   uint64_t m_nOutNacks;
   uint64_t m_nSatisfiedInterests;
   uint64_t m_nUnsatisfiedInterests;
+  std::vector<uint64_t> m_nameTreeResizePauses;
 
   mutable Block m_wire;
 };
@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/mgmt/nfd/kite-producer-status.hpp"
+#include "ndn-cxx/encoding/block-helpers.hpp"
+#include "ndn-cxx/encoding/encoding-buffer.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
+#include "ndn-cxx/util/concepts.hpp"
+
+namespace ndn {
+namespace nfd {
+
+BOOST_CONCEPT_ASSERT((StatusDatasetItem<KiteProducerStatus>));
+
+KiteProducerStatus::KiteProducerStatus()
+  : m_nPendingInterests(0)
+  , m_nHandoffs(0)
+  , m_nNackFallbacks(0)
+  , m_nTimeoutFallbacks(0)
+{
+}
+
+KiteProducerStatus::KiteProducerStatus(const Block& block)
+{
+  this->wireDecode(block);
+}
+
+template<encoding::Tag TAG>
+size_t
+KiteProducerStatus::wireEncode(EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  if (m_routeLifetime) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::RouteLifetime,
+                                                  static_cast<uint64_t>(m_routeLifetime->count()));
+  }
+  if (m_routeInstallLatency) {
+    totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::RouteInstallLatency,
+                                                  static_cast<uint64_t>(m_routeInstallLatency->count()));
+  }
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NTimeoutFallbacks, m_nTimeoutFallbacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NNackFallbacks, m_nNackFallbacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NHandoffs, m_nHandoffs);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NPendingInterests, m_nPendingInterests);
+  totalLength += m_prefix.wireEncode(encoder);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::nfd::KiteProducerStatus);
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(KiteProducerStatus);
+
+const Block&
+KiteProducerStatus::wireEncode() const
+{
+  if (m_wire.hasWire())
+    return m_wire;
+
+  EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+  return m_wire;
+}
+
+void
+KiteProducerStatus::wireDecode(const Block& block)
+{
+  if (block.type() != tlv::nfd::KiteProducerStatus) {
+    NDN_THROW(Error("KiteProducerStatus", block.type()));
+  }
+  m_wire = block;
+  m_wire.parse();
+  auto val = m_wire.elements_begin();
+
+  if (val != m_wire.elements_end() && val->type() == tlv::Name) {
+    m_prefix.wireDecode(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("missing required Name field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NPendingInterests) {
+    m_nPendingInterests = readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("missing required NPendingInterests field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NHandoffs) {
+    m_nHandoffs = readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("missing required NHandoffs field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NNackFallbacks) {
+    m_nNackFallbacks = readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("missing required NNackFallbacks field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::NTimeoutFallbacks) {
+    m_nTimeoutFallbacks = readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("missing required NTimeoutFallbacks field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::RouteInstallLatency) {
+    m_routeInstallLatency.emplace(readNonNegativeInteger(*val));
+    ++val;
+  }
+  else {
+    m_routeInstallLatency = nullopt;
+  }
+
+  if (val != m_wire.elements_end() && val->type() == tlv::nfd::RouteLifetime) {
+    m_routeLifetime.emplace(readNonNegativeInteger(*val));
+    ++val;
+  }
+  else {
+    m_routeLifetime = nullopt;
+  }
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setPrefix(const Name& prefix)
+{
+  m_wire.reset();
+  m_prefix = prefix;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setNPendingInterests(uint64_t nPendingInterests)
+{
+  m_wire.reset();
+  m_nPendingInterests = nPendingInterests;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setNHandoffs(uint64_t nHandoffs)
+{
+  m_wire.reset();
+  m_nHandoffs = nHandoffs;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setNNackFallbacks(uint64_t nNackFallbacks)
+{
+  m_wire.reset();
+  m_nNackFallbacks = nNackFallbacks;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setNTimeoutFallbacks(uint64_t nTimeoutFallbacks)
+{
+  m_wire.reset();
+  m_nTimeoutFallbacks = nTimeoutFallbacks;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setRouteInstallLatency(time::nanoseconds latency)
+{
+  m_wire.reset();
+  m_routeInstallLatency = latency;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::unsetRouteInstallLatency()
+{
+  m_wire.reset();
+  m_routeInstallLatency = nullopt;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::setRouteLifetime(time::milliseconds lifetime)
+{
+  m_wire.reset();
+  m_routeLifetime = lifetime;
+  return *this;
+}
+
+KiteProducerStatus&
+KiteProducerStatus::unsetRouteLifetime()
+{
+  m_wire.reset();
+  m_routeLifetime = nullopt;
+  return *this;
+}
+
+bool
+operator==(const KiteProducerStatus& a, const KiteProducerStatus& b)
+{
+  return a.getPrefix() == b.getPrefix() &&
+      a.getNPendingInterests() == b.getNPendingInterests() &&
+      a.getNHandoffs() == b.getNHandoffs() &&
+      a.getNNackFallbacks() == b.getNNackFallbacks() &&
+      a.getNTimeoutFallbacks() == b.getNTimeoutFallbacks() &&
+      a.hasRouteInstallLatency() == b.hasRouteInstallLatency() &&
+      (!a.hasRouteInstallLatency() || a.getRouteInstallLatency() == b.getRouteInstallLatency()) &&
+      a.hasRouteLifetime() == b.hasRouteLifetime() &&
+      (!a.hasRouteLifetime() || a.getRouteLifetime() == b.getRouteLifetime());
+}
+
+std::ostream&
+operator<<(std::ostream& os, const KiteProducerStatus& status)
+{
+  os << "KiteProducerStatus(Prefix: " << status.getPrefix() << ",\n"
+     << "                   PendingInterests: " << status.getNPendingInterests() << ",\n"
+     << "                   Handoffs: " << status.getNHandoffs() << ",\n"
+     << "                   NackFallbacks: " << status.getNNackFallbacks() << ",\n"
+     << "                   TimeoutFallbacks: " << status.getNTimeoutFallbacks() << ",\n";
+
+  if (status.hasRouteInstallLatency()) {
+    os << "                   RouteInstallLatency: " << status.getRouteInstallLatency() << ",\n";
+  }
+  if (status.hasRouteLifetime()) {
+    os << "                   RouteLifetime: " << status.getRouteLifetime() << ",\n";
+  }
+
+  return os << "                   )";
+}
+
+} // namespace nfd
+} // namespace ndn
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_MGMT_NFD_KITE_PRODUCER_STATUS_HPP
+#define NDN_CXX_MGMT_NFD_KITE_PRODUCER_STATUS_HPP
+
+#include "ndn-cxx/name.hpp"
+#include "ndn-cxx/encoding/block.hpp"
+#include "ndn-cxx/util/optional.hpp"
+#include "ndn-cxx/util/time.hpp"
+
+namespace ndn {
+namespace nfd {
+
+/** \ingroup management
+ *  \brief represents an item in the KITE producer dataset (kite/list)
+ *
+ *  Each item describes a mobile producer known to KiteStrategy on the forwarder.
+ */
+class KiteProducerStatus
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    using tlv::Error::Error;
+  };
+
+  KiteProducerStatus();
+
+  explicit
+  KiteProducerStatus(const Block& block);
+
+  /** \brief get the prefix announced by the mobile producer
+   */
+  const Name&
+  getPrefix() const
+  {
+    return m_prefix;
+  }
+
+  KiteProducerStatus&
+  setPrefix(const Name& prefix);
+
+  /** \brief get number of Interests waiting for the producer to reattach
+   */
+  uint64_t
+  getNPendingInterests() const
+  {
+    return m_nPendingInterests;
+  }
+
+  KiteProducerStatus&
+  setNPendingInterests(uint64_t nPendingInterests);
+
+  /** \brief get number of times the producer moved to a new face
+   */
+  uint64_t
+  getNHandoffs() const
+  {
+    return m_nHandoffs;
+  }
+
+  KiteProducerStatus&
+  setNHandoffs(uint64_t nHandoffs);
+
+  /** \brief get number of Interests that fell back to an RV after a Nack from the producer
+   */
+  uint64_t
+  getNNackFallbacks() const
+  {
+    return m_nNackFallbacks;
+  }
+
+  KiteProducerStatus&
+  setNNackFallbacks(uint64_t nNackFallbacks);
+
+  /** \brief get number of Interests that fell back to an RV because the producer stayed silent
+   */
+  uint64_t
+  getNTimeoutFallbacks() const
+  {
+    return m_nTimeoutFallbacks;
+  }
+
+  KiteProducerStatus&
+  setNTimeoutFallbacks(uint64_t nTimeoutFallbacks);
+
+  bool
+  hasRouteInstallLatency() const
+  {
+    return !!m_routeInstallLatency;
+  }
+
+  /** \brief get the time from the last KITE Ack until its route was installed in the FIB
+   */
+  time::nanoseconds
+  getRouteInstallLatency() const
+  {
+    BOOST_ASSERT(hasRouteInstallLatency());
+    return *m_routeInstallLatency;
+  }
+
+  KiteProducerStatus&
+  setRouteInstallLatency(time::nanoseconds latency);
+
+  KiteProducerStatus&
+  unsetRouteInstallLatency();
+
+  bool
+  hasRouteLifetime() const
+  {
+    return !!m_routeLifetime;
+  }
+
+  /** \brief get the lifetime chosen for the route installed by the last KITE Ack
+   */
+  time::milliseconds
+  getRouteLifetime() const
+  {
+    BOOST_ASSERT(hasRouteLifetime());
+    return *m_routeLifetime;
+  }
+
+  KiteProducerStatus&
+  setRouteLifetime(time::milliseconds lifetime);
+
+  KiteProducerStatus&
+  unsetRouteLifetime();
+
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const;
+
+  const Block&
+  wireEncode() const;
+
+  void
+  wireDecode(const Block& wire);
+
+private:
+  Name m_prefix;
+  uint64_t m_nPendingInterests;
+  uint64_t m_nHandoffs;
+  uint64_t m_nNackFallbacks;
+  uint64_t m_nTimeoutFallbacks;
+  optional<time::nanoseconds> m_routeInstallLatency;
+  optional<time::milliseconds> m_routeLifetime;
+
+  mutable Block m_wire;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(KiteProducerStatus);
+
+bool
+operator==(const KiteProducerStatus& a, const KiteProducerStatus& b);
+
+inline bool
+operator!=(const KiteProducerStatus& a, const KiteProducerStatus& b)
+{
+  return !(a == b);
+}
+
+std::ostream&
+operator<<(std::ostream& os, const KiteProducerStatus& status);
+
+} // namespace nfd
+} // namespace ndn
+
+#endif // NDN_CXX_MGMT_NFD_KITE_PRODUCER_STATUS_HPP
@@ -171,5 +171,16 @@ RibDataset::parseResult(ConstBufferPtr payload) const
   return parseDatasetVector<RibEntry>(payload);
 }
 
+KiteProducerDataset::KiteProducerDataset()
+  : StatusDataset("kite/list")
+{
+}
+
+KiteProducerDataset::ResultType
+KiteProducerDataset::parseResult(ConstBufferPtr payload) const
+{
+  return parseDatasetVector<KiteProducerStatus>(payload);
+}
+
 } // namespace nfd
 } // namespace ndn
@@ -31,6 +31,7 @@
 #include "ndn-cxx/mgmt/nfd/cs-info.hpp"
 #include "ndn-cxx/mgmt/nfd/strategy-choice.hpp"
 #include "ndn-cxx/mgmt/nfd/rib-entry.hpp"
+#include "ndn-cxx/mgmt/nfd/kite-producer-status.hpp"
 
 namespace ndn {
 namespace nfd {
@@ -253,6 +254,21 @@ public:
   parseResult(ConstBufferPtr payload) const;
 };
 
+/**
+ * \ingroup management
+ * \brief represents a kite/list dataset
+ */
+class KiteProducerDataset : public StatusDataset
+{
+public:
+  KiteProducerDataset();
+
+  using ResultType = std::vector<KiteProducerStatus>;
+
+  ResultType
+  parseResult(ConstBufferPtr payload) const;
+};
+
 } // namespace nfd
 } // namespace ndn
 
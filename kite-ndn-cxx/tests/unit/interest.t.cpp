@@ -21,6 +21,7 @@
 
 #include "ndn-cxx/interest.hpp"
 #include "ndn-cxx/data.hpp"
+#include "ndn-cxx/kite/request.hpp"
 
 #include "tests/test-common.hpp"
 
@@ -745,6 +746,36 @@ BOOST_AUTO_TEST_CASE(SetMustBeFresh)
   BOOST_CHECK_EQUAL(i.getMustBeFresh(), false);
 }
 
+BOOST_AUTO_TEST_CASE(KiteHints)
+{
+  Interest i("/I");
+  BOOST_CHECK_EQUAL(i.getKiteHints().empty(), true);
+
+  i.setForwardingHint({"/H",
+                       Name().append(kite::KITE_KEYWORD).append("rv1"),
+                       Name().append(kite::KITE_KEYWORD).append("rv2").append("x")});
+  BOOST_TEST(i.getKiteHints() == std::vector<Name>({"/rv1", "/rv2/x"}), boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(i.getNKiteDelegations(), 2);
+
+  // extracted again when decoding
+  Interest i2(i.wireEncode());
+  BOOST_TEST(i2.getForwardingHint() == i.getForwardingHint(), boost::test_tools::per_element());
+  BOOST_TEST(i2.getKiteHints() == std::vector<Name>({"/rv1", "/rv2/x"}), boost::test_tools::per_element());
+
+  // a lone keyword carries no RV prefix
+  i2.setForwardingHint({Name().append(kite::KITE_KEYWORD), "/H"});
+  BOOST_CHECK_EQUAL(i2.getKiteHints().empty(), true);
+  BOOST_CHECK_EQUAL(i2.getNKiteDelegations(), 1);
+
+  i2.setForwardingHint({"/H"});
+  BOOST_CHECK_EQUAL(i2.getKiteHints().empty(), true);
+  BOOST_CHECK_EQUAL(i2.getNKiteDelegations(), 0);
+
+  i.wireDecode(Interest("/J").wireEncode());
+  BOOST_CHECK_EQUAL(i.getKiteHints().empty(), true);
+  BOOST_CHECK_EQUAL(i.getNKiteDelegations(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(GetNonce)
 {
   unique_ptr<Interest> i1, i2;
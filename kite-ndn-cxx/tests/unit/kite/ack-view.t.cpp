@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/kite/ack-view.hpp"
+#include "ndn-cxx/kite/request.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/key-chain-fixture.hpp"
+
+namespace ndn {
+namespace kite {
+namespace tests {
+
+class AckViewFixture : public ndn::tests::KeyChainFixture
+{
+protected:
+  /** \brief Wrap \p paData into a KITE Ack decoded from the wire.
+   */
+  Data
+  makeAck(const Data& paData)
+  {
+    Data ack("/rv/KITE/alice/params-sha256=0000000000000000000000000000000000000000000000000000000000000000");
+    ack.setContentType(tlv::ContentType_KiteAck);
+    Block content(tlv::Content);
+    content.push_back(paData.wireEncode());
+    content.encode();
+    ack.setContent(content);
+    m_keyChain.sign(ack, security::signingWithSha256());
+    return Data(ack.wireEncode());
+  }
+
+  Data
+  makePaData(uint32_t contentType, const Block& payload, const Name& name = "/alice/32=PA/v=1/seg=0")
+  {
+    Data paData(name);
+    paData.setContentType(contentType);
+    paData.setContent(payload);
+    m_keyChain.sign(paData, security::signingWithSha256());
+    return paData;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestAckView, AckViewFixture)
+
+BOOST_AUTO_TEST_CASE(DecodeGood)
+{
+  Data data(
+    "06C2 0719 rv-prefix=/rv 08027276"
+    "          keyword 20044B495445"
+    "          suffix=/alice 0805616C696365"
+    "          timestamp 0800"
+    "          nonce 0800"
+    "          signing-components 0800 0800"
+    "     1403 content-type=kite-ack 180106"
+    "     1579 content:prefix announcement"
+    "          0677 0717 announced-name=/rv/alice 08027276 0805616C696365"
+    "                    keyword-prefix-ann=20025041 version=0802FD01 segment=08020000"
+    "               1403 content-type=prefix-ann 180105"
+    "               1530 expire in one hour 6D040036EE80"
+    "                    validity FD00FD26 FD00FE0F323031383130333054303030303030"
+    "                                      FD00FF0F323031383131323454323335393539"
+    "               1603 1B0100 signature"
+    "               1720 0000000000000000000000000000000000000000000000000000000000000000"
+    "     1603 1B0100 signature"
+    "     1720 0000000000000000000000000000000000000000000000000000000000000000"_block);
+
+  AckView view(data);
+  const std::vector<uint8_t> nameWire{0x08, 0x02, 0x72, 0x76, 0x08, 0x05, 0x61, 0x6C, 0x69, 0x63, 0x65};
+  BOOST_TEST(view.getAnnouncedNameWire() == nameWire, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(view.getAnnouncedName(), "/rv/alice");
+  BOOST_CHECK_EQUAL(view.getExpiration(), 1_h);
+
+  Ack ack(data);
+  auto validity = ack.getPrefixAnnouncement()->getValidityPeriod()->wireEncode();
+  BOOST_TEST(view.getValidityPeriodWire() == validity, boost::test_tools::per_element());
+  BOOST_CHECK_EQUAL(view.getPrefixAnnouncementData(), ack.getPrefixAnnouncement()->getData()->wireEncode());
+
+  // the view points into the buffer of the Ack
+  BOOST_CHECK(view.getPrefixAnnouncementData().getBuffer() == data.wireEncode().getBuffer());
+  BOOST_CHECK(view.getAnnouncedNameWire().data() >= data.wireEncode().wire());
+  BOOST_CHECK(view.getAnnouncedNameWire().data() < data.wireEncode().wire() + data.wireEncode().size());
+}
+
+BOOST_AUTO_TEST_CASE(MatchesAck)
+{
+  PrefixAnnouncement pa;
+  pa.setAnnouncedName("/rv/alice");
+  pa.setExpiration(10_s);
+  auto now = time::system_clock::now();
+  pa.setValidityPeriod(security::ValidityPeriod(now, now + 1_h));
+  Ack ack;
+  ack.setPrefixAnnouncement(pa);
+
+  Request req;
+  req.setRvPrefix("/rv");
+  req.setProducerSuffix("/rv/alice");
+  security::InterestSigner signer(m_keyChain);
+  auto data = ack.makeData(req.makeInterest(signer, security::signingWithSha256()), m_keyChain);
+
+  optional<AckView> view;
+  {
+    Data copy(data.wireEncode());
+    view.emplace(copy);
+  }
+  BOOST_CHECK_EQUAL(view->getAnnouncedName(), pa.getAnnouncedName());
+  BOOST_CHECK_EQUAL(view->getExpiration(), pa.getExpiration());
+  BOOST_CHECK_EQUAL(security::ValidityPeriod(Block(view->getValidityPeriodWire())), *pa.getValidityPeriod());
+  BOOST_CHECK_EQUAL(PrefixAnnouncement(Data(view->getPrefixAnnouncementData())), pa);
+
+  // without ValidityPeriod
+  pa.setValidityPeriod(nullopt);
+  ack.setPrefixAnnouncement(pa);
+  AckView view2(ack.makeData(req.makeInterest(signer, security::signingWithSha256()), m_keyChain));
+  BOOST_CHECK(view2.getValidityPeriodWire().empty());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeBad)
+{
+  // not a KITE Ack
+  Data data("/rv/KITE/alice");
+  data.setContentType(tlv::ContentType_Key);
+  BOOST_CHECK_THROW(AckView{data}, AckView::Error);
+
+  // empty content
+  data.setContentType(tlv::ContentType_KiteAck);
+  BOOST_CHECK_THROW(AckView{data}, AckView::Error);
+
+  // no prefix announcement element
+  data.setContent("F000"_block);
+  BOOST_CHECK_THROW(AckView{data}, AckView::Error);
+
+  const auto payload = "1504 6D020E10"_block;
+  BOOST_CHECK_NO_THROW(AckView{makeAck(makePaData(tlv::ContentType_PrefixAnn, payload))});
+
+  // wrong name structure
+  BOOST_CHECK_THROW(AckView{makeAck(makePaData(tlv::ContentType_PrefixAnn, payload, "/alice/v=1/seg=0"))},
+                    AckView::Error);
+  BOOST_CHECK_THROW(AckView{makeAck(makePaData(tlv::ContentType_PrefixAnn, payload, "/alice/32=PA/v=1"))},
+                    AckView::Error);
+
+  // wrong ContentType
+  BOOST_CHECK_THROW(AckView{makeAck(makePaData(tlv::ContentType_Blob, payload))}, AckView::Error);
+
+  // missing ExpirationPeriod
+  BOOST_CHECK_THROW(AckView{makeAck(makePaData(tlv::ContentType_PrefixAnn, "1503 FC0100"_block))},
+                    AckView::Error);
+
+  // unrecognized critical element
+  BOOST_CHECK_THROW(AckView{makeAck(makePaData(tlv::ContentType_PrefixAnn, "1507 6D020E10 010100"_block))},
+                    AckView::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestAckView
+
+} // namespace tests
+} // namespace kite
+} // namespace ndn
@@ -20,6 +20,7 @@
  */
 
 #include "ndn-cxx/mgmt/nfd/forwarder-status.hpp"
+#include "ndn-cxx/encoding/tlv-nfd.hpp"
 
 #include "tests/boost-test.hpp"
 
@@ -84,6 +85,28 @@ BOOST_AUTO_TEST_CASE(Encode)
   BOOST_CHECK_EQUAL(status1, status2);
 }
 
+BOOST_AUTO_TEST_CASE(NameTreeResizePauses)
+{
+  ForwarderStatus status1 = makeForwarderStatus();
+  status1.setNameTreeResizePauses({5, 0, 300});
+  Block wire = status1.wireEncode();
+
+  wire.parse();
+  const Block& pauses = wire.elements().back();
+  BOOST_CHECK_EQUAL(pauses.type(), tlv::nfd::NameTreeResizePauses);
+  pauses.parse();
+  BOOST_CHECK_EQUAL(pauses.elements_size(), 3);
+
+  ForwarderStatus status2(wire);
+  BOOST_CHECK_EQUAL(status1, status2);
+  BOOST_CHECK(status2.getNameTreeResizePauses() == std::vector<uint64_t>({5, 0, 300}));
+
+  // a status without the field decodes to an empty histogram
+  ForwarderStatus status3(makeForwarderStatus().wireEncode());
+  BOOST_CHECK(status3.getNameTreeResizePauses().empty());
+  BOOST_CHECK_NE(status1, status3);
+}
+
 BOOST_AUTO_TEST_CASE(Equality)
 {
   ForwarderStatus status1, status2;
@@ -131,6 +154,24 @@ BOOST_AUTO_TEST_CASE(Print)
                     "                         SatisfiedInterests: 961020,\n"
                     "                         UnsatisfiedInterests: 941024}\n"
                     "              )");
+
+  status.setNameTreeResizePauses({7, 2, 0});
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(status),
+                    "GeneralStatus(NfdVersion: 0.5.1-14-g05dd444,\n"
+                    "              StartTimestamp: 375193249325000000 nanoseconds since Jan 1, 1970,\n"
+                    "              CurrentTimestamp: 886109034272000000 nanoseconds since Jan 1, 1970,\n"
+                    "              Counters: {NameTreeEntries: 1849943160,\n"
+                    "                         FibEntries: 621739748,\n"
+                    "                         PitEntries: 482129741,\n"
+                    "                         MeasurementsEntries: 1771725298,\n"
+                    "                         CsEntries: 1264968688,\n"
+                    "                         Interests: {in: 612811615, out: 952144445},\n"
+                    "                         Data: {in: 1843576050, out: 138198826},\n"
+                    "                         Nacks: {in: 1234, out: 4321},\n"
+                    "                         SatisfiedInterests: 961020,\n"
+                    "                         UnsatisfiedInterests: 941024},\n"
+                    "              NameTreeResizePauses: [7, 2, 0]\n"
+                    "              )");
 }
 
 BOOST_AUTO_TEST_SUITE_END() // TestForwarderStatus
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013-2022 Regents of the University of California.
+ *                         Harbin Institute of Technology
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "ndn-cxx/mgmt/nfd/kite-producer-status.hpp"
+
+#include "tests/boost-test.hpp"
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Mgmt)
+BOOST_AUTO_TEST_SUITE(Nfd)
+BOOST_AUTO_TEST_SUITE(TestKiteProducerStatus)
+
+static KiteProducerStatus
+makeKiteProducerStatus()
+{
+  return KiteProducerStatus()
+    .setPrefix("/A")
+    .setNPendingInterests(5)
+    .setNHandoffs(2)
+    .setNNackFallbacks(7)
+    .setNTimeoutFallbacks(3)
+    .setRouteInstallLatency(1500_us)
+    .setRouteLifetime(30_s);
+}
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  KiteProducerStatus status1 = makeKiteProducerStatus();
+  Block wire = status1.wireEncode();
+
+  static const uint8_t EXPECTED[] = {
+    0x80, 0x1B, // KiteProducerStatus
+          0x07, 0x03, 0x08, 0x01, 0x41, // Name
+          0x81, 0x01, 0x05, // NPendingInterests
+          0x82, 0x01, 0x02, // NHandoffs
+          0x83, 0x01, 0x07, // NNackFallbacks
+          0x84, 0x01, 0x03, // NTimeoutFallbacks
+          0x85, 0x04, 0x00, 0x16, 0xE3, 0x60, // RouteInstallLatency
+          0x86, 0x02, 0x75, 0x30, // RouteLifetime
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+
+  KiteProducerStatus status2(wire);
+  BOOST_CHECK_EQUAL(status1, status2);
+
+  status1.unsetRouteInstallLatency();
+  KiteProducerStatus status3(status1.wireEncode());
+  BOOST_CHECK_EQUAL(status3.hasRouteInstallLatency(), false);
+  BOOST_CHECK_EQUAL(status3.getNTimeoutFallbacks(), 3);
+  BOOST_CHECK_EQUAL(status3.getRouteLifetime(), 30_s);
+
+  status1.unsetRouteLifetime();
+  KiteProducerStatus status4(status1.wireEncode());
+  BOOST_CHECK_EQUAL(status4.hasRouteLifetime(), false);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMissingField)
+{
+  static const uint8_t WIRE[] = {
+    0x80, 0x08, // KiteProducerStatus
+          0x07, 0x03, 0x08, 0x01, 0x41, // Name
+          0x81, 0x01, 0x05, // NPendingInterests
+  };
+  BOOST_CHECK_THROW(KiteProducerStatus(Block(WIRE)), KiteProducerStatus::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Equality)
+{
+  KiteProducerStatus status1, status2;
+  BOOST_CHECK_EQUAL(status1, status2);
+
+  status1 = makeKiteProducerStatus();
+  BOOST_CHECK_NE(status1, status2);
+  status2 = status1;
+  BOOST_CHECK_EQUAL(status1, status2);
+
+  status2.setNHandoffs(status2.getNHandoffs() + 1);
+  BOOST_CHECK_NE(status1, status2);
+  status2 = status1;
+
+  status2.unsetRouteInstallLatency();
+  BOOST_CHECK_NE(status1, status2);
+  status2 = status1;
+
+  status2.setRouteLifetime(1_min);
+  BOOST_CHECK_NE(status1, status2);
+  status2 = status1;
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  KiteProducerStatus status = makeKiteProducerStatus();
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(status),
+                    "KiteProducerStatus(Prefix: /A,\n"
+                    "                   PendingInterests: 5,\n"
+                    "                   Handoffs: 2,\n"
+                    "                   NackFallbacks: 7,\n"
+                    "                   TimeoutFallbacks: 3,\n"
+                    "                   RouteInstallLatency: 1500000 nanoseconds,\n"
+                    "                   RouteLifetime: 30000 milliseconds,\n"
+                    "                   )");
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestKiteProducerStatus
+BOOST_AUTO_TEST_SUITE_END() // Nfd
+BOOST_AUTO_TEST_SUITE_END() // Mgmt
+
+} // namespace tests
+} // namespace nfd
+} // namespace ndn
@@ -454,6 +454,29 @@ BOOST_AUTO_TEST_CASE(RibList)
   BOOST_CHECK_EQUAL(failCodes.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(KiteProducerList)
+{
+  bool hasResult = false;
+  controller.fetch<KiteProducerDataset>(
+    [&hasResult] (const std::vector<KiteProducerStatus>& result) {
+      hasResult = true;
+      BOOST_CHECK_EQUAL(result.size(), 2);
+      BOOST_CHECK_EQUAL(result.front().getPrefix(), "/mp/Gx7pEq");
+    },
+    datasetFailCallback);
+  this->advanceClocks(500_ms);
+
+  KiteProducerStatus payload1;
+  payload1.setPrefix("/mp/Gx7pEq");
+  KiteProducerStatus payload2;
+  payload2.setPrefix("/mp/b3TzWn");
+  this->sendDataset("/localhost/nfd/kite/list", payload1, payload2);
+  this->advanceClocks(500_ms);
+
+  BOOST_CHECK(hasResult);
+  BOOST_CHECK_EQUAL(failCodes.size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(RibListWithOptions)
 {
   CommandOptions options;
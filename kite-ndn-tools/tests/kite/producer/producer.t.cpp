@@ -0,0 +1,249 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/kite/producer/producer.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/io-fixture.hpp"
+#include "tests/key-chain-fixture.hpp"
+
+#include <ndn-cxx/kite/ack.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <thread>
+
+namespace ndn {
+namespace kite {
+namespace producer {
+namespace tests {
+
+using namespace ndn::tests;
+
+class ProducerFixture : public IoFixture, public KeyChainFixture
+{
+protected:
+  ProducerFixture()
+  {
+    m_keyChain.createIdentity("/rv");
+    m_keyChain.createIdentity("/alice");
+    m_keyChain.createIdentity("/bob");
+  }
+
+  static Options
+  makeOptions()
+  {
+    Options opt;
+    opt.prefixPairs = {{"/rv", "/alice"}, {"/rv", "/bob"}};
+    opt.interval = 10_s;
+    opt.lifetime = 4_s;
+    opt.action = 2;
+    opt.sendInterest = false;
+    opt.jitter = 0.0;
+    return opt;
+  }
+
+  Data
+  makeAck(const Interest& request)
+  {
+    Request req;
+    req.decode(request);
+    PrefixAnnouncement pa;
+    pa.setAnnouncedName(req.getProducerPrefix());
+    pa.setExpiration(*req.getExpiration());
+    Ack ack;
+    ack.setPrefixAnnouncement(pa);
+    return ack.makeData(request, m_keyChain, security::signingByIdentity("/rv"));
+  }
+
+  /**
+   * @brief KITE requests sent by the producer, without the prefix registration commands
+   */
+  std::vector<Interest>
+  getSentRequests() const
+  {
+    std::vector<Interest> requests;
+    std::copy_if(face.sentInterests.begin(), face.sentInterests.end(), std::back_inserter(requests),
+                 [] (const Interest& interest) { return !Name("/localhost").isPrefixOf(interest.getName()); });
+    return requests;
+  }
+
+protected:
+  util::DummyClientFace face{m_io, m_keyChain, {true, true}};
+  Options options{makeOptions()};
+  Producer producer{face, m_keyChain, options};
+};
+
+BOOST_AUTO_TEST_SUITE(Kite)
+BOOST_FIXTURE_TEST_SUITE(TestProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(Delays)
+{
+  BOOST_TEST(producer.getRefreshDelay(4_s) == 3_s);
+  BOOST_TEST(producer.getRefreshDelay(1_min) == 10_s); // capped by interval
+
+  BOOST_TEST(producer.getNextBackoff(0_ms) == 100_ms);
+  BOOST_TEST(producer.getNextBackoff(100_ms) == 200_ms);
+  BOOST_TEST(producer.getNextBackoff(8_s) == 10_s);
+}
+
+BOOST_AUTO_TEST_CASE(RefreshBeforeExpiry)
+{
+  producer.start();
+  advanceClocks(1_ms, 10);
+  auto requests = getSentRequests();
+  BOOST_REQUIRE_EQUAL(requests.size(), 2);
+  BOOST_TEST(requests[0].getName().getPrefix(3) == Name("/rv").append(KITE_KEYWORD).append("alice"));
+  BOOST_TEST(requests[1].getName().getPrefix(3) == Name("/rv").append(KITE_KEYWORD).append("bob"));
+
+  face.receive(makeAck(requests[0]));
+  face.receive(makeAck(requests[1]));
+  advanceClocks(1_ms, 10);
+  face.sentInterests.clear();
+
+  // refreshed at 75% of the 4 s announcement lifetime
+  advanceClocks(100_ms, 29);
+  BOOST_TEST(face.sentInterests.size() == 0);
+  advanceClocks(100_ms, 1);
+  BOOST_TEST(face.sentInterests.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(BackoffOnNack)
+{
+  producer.start();
+  advanceClocks(1_ms, 10);
+  auto requests = getSentRequests();
+  BOOST_REQUIRE_EQUAL(requests.size(), 2);
+  Interest aliceRequest = requests[0];
+  face.receive(makeAck(requests[1]));
+  face.sentInterests.clear();
+
+  lp::Nack nack(aliceRequest);
+  nack.setReason(lp::NackReason::NO_ROUTE);
+  face.receive(nack);
+  advanceClocks(1_ms, 10);
+
+  // retried within [initialBackoff / 2, initialBackoff]
+  advanceClocks(10_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  BOOST_TEST(face.sentInterests[0].getName().getPrefix(3) == Name("/rv").append(KITE_KEYWORD).append("alice"));
+
+  // the retry times out after the InterestLifetime and is retried again, while bob refreshes
+  face.sentInterests.clear();
+  advanceClocks(100_ms, 50);
+  requests = getSentRequests();
+  BOOST_TEST(std::count_if(requests.begin(), requests.end(), [] (const Interest& interest) {
+    return interest.getName().getPrefix(3) == Name("/rv").append(KITE_KEYWORD).append("alice");
+  }) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(Manual)
+{
+  options.wantRefresh = false;
+  producer.start();
+  advanceClocks(1_ms, 10);
+  BOOST_TEST(getSentRequests().size() == 0);
+
+  producer.sendKiteRequest();
+  advanceClocks(1_ms, 10);
+  BOOST_TEST(getSentRequests().size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(DataCache)
+{
+  options.wantRefresh = false;
+  options.action = 0;
+  options.signingMode = SigningMode::SHA256;
+  options.cacheSize = 10;
+  Producer cachingProducer(face, m_keyChain, options);
+  cachingProducer.start();
+  advanceClocks(1_ms, 10);
+
+  face.receive(Interest("/alice/1"));
+  face.receive(Interest("/alice/1"));
+  face.receive(Interest("/alice/2"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_TEST(face.sentData[0].getSignatureType() == tlv::DigestSha256);
+  BOOST_TEST(face.sentData[0].wireEncode() == face.sentData[1].wireEncode());
+  BOOST_TEST(cachingProducer.nSigned == 2);
+  BOOST_TEST(cachingProducer.nCacheHits == 1);
+}
+
+BOOST_AUTO_TEST_CASE(SignerThreads)
+{
+  options.wantRefresh = false;
+  options.action = 0;
+  options.nSigners = 2;
+  Producer threadedProducer(face, m_keyChain, options);
+  threadedProducer.start();
+  advanceClocks(1_ms, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    face.receive(Interest(Name("/bob").appendNumber(i)));
+  }
+  for (int i = 0; i < 1000 && threadedProducer.nSigned < 10; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    advanceClocks(1_ms);
+  }
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 10);
+  auto bobKey = m_keyChain.getPib().getIdentity("/bob").getDefaultKey();
+  for (const auto& data : face.sentData) {
+    BOOST_TEST(security::verifySignature(data, bobKey));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StopWhileSigning)
+{
+  options.wantRefresh = false;
+  options.action = 0;
+  options.nSigners = 2;
+  Producer threadedProducer(face, m_keyChain, options);
+  threadedProducer.start();
+  advanceClocks(1_ms, 10);
+
+  for (int i = 0; i < 10; ++i) {
+    face.receive(Interest(Name("/bob").appendNumber(i)));
+  }
+  threadedProducer.stop();
+
+  // results of the signers are dropped once the Producer has stopped
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  advanceClocks(1_ms, 10);
+  BOOST_TEST(face.sentData.size() == 0);
+  BOOST_TEST(threadedProducer.nSigned == 0);
+}
+
+BOOST_AUTO_TEST_CASE(MalformedHmacKey)
+{
+  options.wantRefresh = false;
+  options.action = 0;
+  options.signingMode = SigningMode::HMAC;
+  options.hmacKey = "not a base64 key";
+  Producer hmacProducer(face, m_keyChain, options);
+  BOOST_CHECK_THROW(hmacProducer.start(), std::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestProducer
+BOOST_AUTO_TEST_SUITE_END() // Kite
+
+} // namespace tests
+} // namespace producer
+} // namespace kite
+} // namespace ndn
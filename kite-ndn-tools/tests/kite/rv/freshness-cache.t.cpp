@@ -0,0 +1,300 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/kite/rv/freshness-cache.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/clock-fixture.hpp"
+#include "tests/key-chain-fixture.hpp"
+
+#include <ndn-cxx/security/interest-signer.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+namespace tests {
+
+using namespace ndn::tests;
+using Decision = FreshnessCache::Decision;
+
+BOOST_AUTO_TEST_SUITE(Kite)
+
+BOOST_FIXTURE_TEST_CASE(TestNonceFilter, ClockFixture)
+{
+  NonceFilter filter(1024, 10_s);
+  const std::vector<uint8_t> n1{0x01, 0x02, 0x03, 0x04};
+  const std::vector<uint8_t> n2{0x05, 0x06, 0x07, 0x08};
+  BOOST_TEST(!filter.contains(n1));
+
+  filter.add(n1);
+  BOOST_TEST(filter.contains(n1));
+  BOOST_TEST(!filter.contains(n2));
+
+  // n1 moves to the previous bucket
+  advanceClocks(6_s, 2);
+  filter.add(n2);
+  BOOST_TEST(filter.contains(n1));
+  BOOST_TEST(filter.contains(n2));
+
+  // the bucket holding n1 is dropped
+  advanceClocks(5_s, 2);
+  filter.add(n2);
+  BOOST_TEST(!filter.contains(n1));
+  BOOST_TEST(filter.contains(n2));
+
+  // nothing was added for two intervals
+  advanceClocks(10_s, 2);
+  BOOST_TEST(!filter.contains(n2));
+}
+
+class FreshnessCacheFixture : public ClockFixture, public KeyChainFixture
+{
+protected:
+  FreshnessCacheFixture()
+  {
+    options.keyLifetime = 1_h;
+    options.gracePeriod = 10_s;
+  }
+
+  Interest
+  makeRequest(Request& req, const Name& rvPrefix = "/rv", const Name& suffix = "/producer")
+  {
+    req.setRvPrefix(rvPrefix).setProducerSuffix(suffix).setExpiration(10_s);
+    Interest interest = req.makeInterest(signer, security::signingByCertificate(cert));
+    req = Request();
+    req.decode(interest);
+    return interest;
+  }
+
+protected:
+  security::Certificate cert = m_keyChain.createIdentity("/producer").getDefaultKey().getDefaultCertificate();
+  Name keyLocator = cert.getName();
+  security::InterestSigner signer{m_keyChain};
+  FreshnessCache::Options options;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFreshnessCache, FreshnessCacheFixture)
+
+BOOST_AUTO_TEST_CASE(LookupAfterInsert)
+{
+  FreshnessCache cache(options);
+  Request r1;
+  makeRequest(r1);
+  BOOST_TEST((cache.lookup(r1, keyLocator).decision == Decision::VALIDATE));
+
+  cache.insert(r1, keyLocator, cert);
+  BOOST_TEST(cache.size() == 1);
+  BOOST_TEST(cache.getNKeys() == 1);
+
+  advanceClocks(1_s);
+  Request r2;
+  Interest i2 = makeRequest(r2);
+  auto lookup = cache.lookup(r2, keyLocator);
+  BOOST_TEST((lookup.decision == Decision::VERIFY));
+  BOOST_REQUIRE(lookup.key != nullptr);
+  BOOST_TEST(security::verifySignature(i2, *lookup.key));
+
+  // the validator's decision depends on the RV prefix and the KeyLocator
+  BOOST_TEST((cache.lookup(r2, "/other/KEY/1").decision == Decision::VALIDATE));
+  Request r3;
+  makeRequest(r3, "/other-rv");
+  BOOST_TEST((cache.lookup(r3, keyLocator).decision == Decision::VALIDATE));
+  Request r4;
+  makeRequest(r4, "/rv", "/other-producer");
+  BOOST_TEST((cache.lookup(r4, keyLocator).decision == Decision::VALIDATE));
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  FreshnessCache cache(options);
+  Request r1;
+  makeRequest(r1);
+  Request r2;
+  makeRequest(r2);
+  cache.insert(r2, keyLocator, cert);
+
+  // same timestamp as an accepted request
+  BOOST_TEST((cache.lookup(r2, keyLocator).decision == Decision::REJECT));
+  // older than an accepted request
+  BOOST_TEST((cache.lookup(r1, keyLocator).decision == Decision::REJECT));
+
+  Request r3;
+  makeRequest(r3);
+  BOOST_TEST((cache.lookup(r3, keyLocator).decision == Decision::VERIFY));
+  BOOST_TEST(cache.accept(r3, keyLocator));
+  BOOST_TEST(!cache.accept(r3, keyLocator));
+  BOOST_TEST((cache.lookup(r3, keyLocator).decision == Decision::REJECT));
+}
+
+BOOST_AUTO_TEST_CASE(GracePeriod)
+{
+  FreshnessCache cache(options);
+  Request r1;
+  makeRequest(r1);
+  cache.insert(r1, keyLocator, cert);
+
+  Request r2;
+  makeRequest(r2);
+  advanceClocks(6_s, 2);
+  BOOST_TEST((cache.lookup(r2, keyLocator).decision == Decision::REJECT));
+  BOOST_TEST(!cache.accept(r2, keyLocator));
+
+  // also rejected without any cached state
+  FreshnessCache empty(options);
+  BOOST_TEST((empty.lookup(r2, keyLocator).decision == Decision::REJECT));
+}
+
+BOOST_AUTO_TEST_CASE(KeyLifetime)
+{
+  options.keyLifetime = 5_s;
+  FreshnessCache cache(options);
+  Request r1;
+  makeRequest(r1);
+  cache.insert(r1, keyLocator, cert);
+
+  advanceClocks(3_s, 2);
+  Request r2;
+  makeRequest(r2);
+  BOOST_TEST((cache.lookup(r2, keyLocator).decision == Decision::VALIDATE));
+  // the timestamp of the last accepted request outlives the key
+  BOOST_TEST((cache.lookup(r1, keyLocator).decision == Decision::REJECT));
+
+  cache.insert(r2, keyLocator, cert);
+  Request r3;
+  makeRequest(r3);
+  BOOST_TEST((cache.lookup(r3, keyLocator).decision == Decision::VERIFY));
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  options.capacity = 2;
+  FreshnessCache cache(options);
+  Request r1, r2, r3;
+  makeRequest(r1, "/rv", "/p1");
+  cache.insert(r1, keyLocator, cert);
+  advanceClocks(1_s);
+  makeRequest(r2, "/rv", "/p2");
+  cache.insert(r2, keyLocator, cert);
+  advanceClocks(1_s);
+  makeRequest(r3, "/rv", "/p3");
+  cache.insert(r3, keyLocator, cert);
+  BOOST_TEST(cache.size() == 2);
+  BOOST_TEST(cache.getNKeys() == 1);
+
+  Request r4;
+  makeRequest(r4, "/rv", "/p1");
+  BOOST_TEST((cache.lookup(r4, keyLocator).decision == Decision::VALIDATE));
+  Request r5;
+  makeRequest(r5, "/rv", "/p3");
+  BOOST_TEST((cache.lookup(r5, keyLocator).decision == Decision::VERIFY));
+
+  options.capacity = 0;
+  FreshnessCache disabled(options);
+  disabled.insert(r5, keyLocator, cert);
+  BOOST_TEST(disabled.size() == 0);
+  BOOST_TEST(disabled.getNKeys() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(EvictLeastRecentlyAccepted)
+{
+  options.capacity = 2;
+  FreshnessCache cache(options);
+  Request r1, r2;
+  makeRequest(r1, "/rv", "/p1");
+  cache.insert(r1, "/k1", cert);
+  advanceClocks(1_s);
+  makeRequest(r2, "/rv", "/p2");
+  cache.insert(r2, "/k2", cert);
+  advanceClocks(1_s);
+
+  // a refresh under /k1 makes /k2 and /p2 the least recently accepted
+  Request r3;
+  makeRequest(r3, "/rv", "/p1");
+  BOOST_TEST((cache.lookup(r3, "/k1").decision == Decision::VERIFY));
+  BOOST_TEST(cache.accept(r3, "/k1"));
+  // keys are evicted only once their newest request is out of the grace period
+  advanceClocks(10_s);
+
+  Request r4;
+  makeRequest(r4, "/rv", "/p3");
+  cache.insert(r4, "/k3", cert);
+  BOOST_TEST(cache.size() == 2);
+  BOOST_TEST(cache.getNKeys() == 2);
+
+  Request r5, r6;
+  makeRequest(r5, "/rv", "/p1");
+  BOOST_TEST((cache.lookup(r5, "/k1").decision == Decision::VERIFY));
+  makeRequest(r6, "/rv", "/p2");
+  BOOST_TEST((cache.lookup(r6, "/k2").decision == Decision::VALIDATE));
+}
+
+BOOST_AUTO_TEST_CASE(ReplayWhenFull)
+{
+  options.capacity = 2;
+  FreshnessCache cache(options);
+  Request r1, r2;
+  makeRequest(r1, "/rv", "/p1");
+  cache.insert(r1, "/k1", cert);
+  advanceClocks(1_s);
+  makeRequest(r2, "/rv", "/p2");
+  cache.insert(r2, "/k2", cert);
+  advanceClocks(1_s);
+
+  // a refresh accepted with the cached key never reaches the full validator
+  Request r3;
+  makeRequest(r3, "/rv", "/p1");
+  BOOST_TEST((cache.lookup(r3, "/k1").decision == Decision::VERIFY));
+  BOOST_TEST(cache.accept(r3, "/k1"));
+  advanceClocks(1_s);
+
+  // the table is full of recently used keys, a new key is not cached
+  Request r4;
+  makeRequest(r4, "/rv", "/p3");
+  cache.insert(r4, "/k3", cert);
+  BOOST_TEST(cache.getNKeys() == 2);
+  BOOST_TEST((cache.lookup(r3, "/k1").decision == Decision::REJECT));
+  BOOST_TEST((cache.lookup(r2, "/k2").decision == Decision::REJECT));
+  advanceClocks(1_s);
+
+  Request r5;
+  makeRequest(r5, "/rv", "/p4");
+  cache.insert(r5, "/k4", cert);
+  BOOST_TEST(cache.getNKeys() == 2);
+  BOOST_TEST((cache.lookup(r3, "/k1").decision == Decision::REJECT));
+
+  // once out of the grace period, the least recently used key makes room
+  advanceClocks(10_s);
+  Request r6;
+  makeRequest(r6, "/rv", "/p3");
+  cache.insert(r6, "/k3", cert);
+  BOOST_TEST(cache.getNKeys() == 2);
+  Request r7;
+  makeRequest(r7, "/rv", "/p3");
+  BOOST_TEST((cache.lookup(r7, "/k3").decision == Decision::VERIFY));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFreshnessCache
+BOOST_AUTO_TEST_SUITE_END() // Kite
+
+} // namespace tests
+} // namespace rv
+} // namespace kite
+} // namespace ndn
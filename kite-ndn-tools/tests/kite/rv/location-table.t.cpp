@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/kite/rv/location-table.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+namespace tests {
+
+class LocationTableFixture
+{
+protected:
+  LocationTableFixture()
+  {
+    boost::filesystem::create_directories(snapshotPath.parent_path());
+    boost::filesystem::remove(snapshotPath);
+  }
+
+  ~LocationTableFixture()
+  {
+    boost::filesystem::remove(snapshotPath);
+  }
+
+  Location
+  makeLocation(const Name& producerPrefix, time::milliseconds lifetime) const
+  {
+    Location location;
+    location.producerPrefix = producerPrefix;
+    location.rvPrefix = "/rv";
+    location.expiry = now + lifetime;
+    return location;
+  }
+
+protected:
+  const time::system_clock::time_point now = time::fromUnixTimestamp(time::milliseconds(1600000000000));
+  const boost::filesystem::path snapshotPath =
+    boost::filesystem::path(UNIT_TESTS_TMPDIR) / "kite-rv" / "locations.snapshot";
+};
+
+BOOST_AUTO_TEST_SUITE(Kite)
+BOOST_FIXTURE_TEST_SUITE(TestLocationTable, LocationTableFixture)
+
+BOOST_AUTO_TEST_CASE(UpdateFind)
+{
+  LocationTable table;
+  BOOST_TEST(table.find("/alice") == nullptr);
+
+  table.update(makeLocation("/alice", 10_s));
+  table.update(makeLocation("/alice/phone", 10_s));
+  BOOST_TEST(table.size() == 2);
+  BOOST_REQUIRE(table.find("/alice") != nullptr);
+  BOOST_TEST(table.find("/alice")->rvPrefix == "/rv");
+
+  BOOST_TEST(table.findLongestPrefixMatch("/alice/phone/video")->producerPrefix == "/alice/phone");
+  BOOST_TEST(table.findLongestPrefixMatch("/alice/laptop")->producerPrefix == "/alice");
+  BOOST_TEST(table.findLongestPrefixMatch("/bob") == nullptr);
+
+  // a new request replaces the old record and its expiry
+  auto location = makeLocation("/alice", 20_s);
+  location.faceId = 262;
+  table.update(location);
+  BOOST_TEST(table.size() == 2);
+  BOOST_TEST(*table.find("/alice")->faceId == 262);
+  BOOST_TEST(table.getNextExpiry().value() == now + 10_s);
+
+  BOOST_TEST(table.erase("/alice/phone"));
+  BOOST_TEST(!table.erase("/alice/phone"));
+  BOOST_TEST(table.getNextExpiry().value() == now + 20_s);
+}
+
+BOOST_AUTO_TEST_CASE(Sweep)
+{
+  LocationTable table;
+  BOOST_TEST(!table.getNextExpiry().has_value());
+
+  table.update(makeLocation("/a", 1_s));
+  table.update(makeLocation("/b", 2_s));
+  table.update(makeLocation("/c", 3_s));
+  table.update(makeLocation("/a", 4_s));
+
+  BOOST_TEST(table.sweep(now) == 0);
+  BOOST_TEST(table.sweep(now + 2_s) == 1);
+  BOOST_TEST(table.find("/b") == nullptr);
+  BOOST_TEST(table.find("/a") != nullptr);
+  BOOST_TEST(table.sweep(now + 10_s) == 2);
+  BOOST_TEST(table.size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  LocationTable table;
+  BOOST_TEST(table.loadSnapshot(snapshotPath.string(), now) == 0); // no snapshot yet
+
+  auto location = makeLocation("/alice", 10_s);
+  location.faceId = 300;
+  location.timestamp = now - 1_s;
+  location.nonce = {0x01, 0x02, 0x03, 0x04};
+  table.update(location);
+  table.update(makeLocation("/bob", 1_s));
+  table.saveSnapshot(snapshotPath.string());
+
+  LocationTable restored;
+  BOOST_TEST(restored.loadSnapshot(snapshotPath.string(), now + 5_s) == 1); // /bob has expired
+  const Location* alice = restored.find("/alice");
+  BOOST_REQUIRE(alice != nullptr);
+  BOOST_TEST(alice->rvPrefix == "/rv");
+  BOOST_TEST(*alice->faceId == 300);
+  BOOST_TEST(alice->expiry == location.expiry);
+  BOOST_TEST(*alice->timestamp == *location.timestamp);
+  BOOST_TEST(alice->nonce == location.nonce, boost::test_tools::per_element());
+  BOOST_TEST(restored.find("/bob") == nullptr);
+
+  std::ofstream(snapshotPath.string(), std::ios::trunc) << "garbage!garbage!";
+  BOOST_CHECK_THROW(restored.loadSnapshot(snapshotPath.string(), now), LocationTable::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLocationTable
+BOOST_AUTO_TEST_SUITE_END() // Kite
+
+} // namespace tests
+} // namespace rv
+} // namespace kite
+} // namespace ndn
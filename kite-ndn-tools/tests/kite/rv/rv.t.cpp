@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tools/kite/rv/rv.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/io-fixture.hpp"
+#include "tests/key-chain-fixture.hpp"
+
+#include <ndn-cxx/kite/ack.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/security/interest-signer.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <thread>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+namespace tests {
+
+using namespace ndn::tests;
+
+class RvFixture : public IoFixture, public KeyChainFixture
+{
+protected:
+  RvFixture()
+  {
+    m_keyChain.createIdentity("/rv1");
+    m_keyChain.createIdentity("/rv2");
+    m_keyChain.createIdentity("/alice");
+
+    boost::filesystem::create_directories(UNIT_TESTS_TMPDIR);
+    std::string certFile = std::string(UNIT_TESTS_TMPDIR) + "/rv-alice.cert";
+    saveIdentityCert("/alice", certFile);
+
+    options.validatorConfig = std::string(UNIT_TESTS_TMPDIR) + "/rv.conf";
+    std::ofstream conf(options.validatorConfig);
+    conf << "rule\n"
+         << "{\n"
+         << "  id \"kite\"\n"
+         << "  for interest\n"
+         << "  filter { type name regex ^<rv[12]><>*$ }\n"
+         << "  checker\n"
+         << "  {\n"
+         << "    type customized\n"
+         << "    sig-type ecdsa-sha256\n"
+         << "    key-locator { type name name /alice relation is-prefix-of }\n"
+         << "  }\n"
+         << "}\n"
+         << "trust-anchor { type file file-name \"" << certFile << "\" }\n";
+    conf.close();
+
+    options.prefixes = {"/rv1", "/rv2"};
+    options.mpListen = false;
+    options.sendNack = false;
+    options.sendData = false;
+    options.sendInterest = false;
+  }
+
+  ~RvFixture()
+  {
+    boost::system::error_code ec;
+    boost::filesystem::remove(options.validatorConfig, ec);
+  }
+
+  Interest
+  makeRequest(const Name& rvPrefix)
+  {
+    Request req;
+    req.setRvPrefix(rvPrefix).setProducerSuffix("/alice").setExpiration(10_s);
+    return req.makeInterest(signer, security::signingByIdentity("/alice"));
+  }
+
+  /**
+   * @brief Waits for the workers until @p rv has sent @p nAcks Acks
+   */
+  void
+  waitForAcks(const Rv& rv, uint64_t nAcks)
+  {
+    for (int i = 0; i < 1000 && rv.getStats().nAcks < nAcks; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      advanceClocks(1_ms);
+    }
+  }
+
+  bool
+  isAckSignedBy(const Data& data, const Name& identity)
+  {
+    auto key = m_keyChain.getPib().getIdentity(identity).getDefaultKey();
+    return data.getContentType() == tlv::ContentType_KiteAck && security::verifySignature(data, key);
+  }
+
+protected:
+  util::DummyClientFace face{m_io, m_keyChain, {true, true}};
+  security::InterestSigner signer{m_keyChain};
+  Options options;
+};
+
+BOOST_AUTO_TEST_SUITE(Kite)
+BOOST_FIXTURE_TEST_SUITE(TestRv, RvFixture)
+
+BOOST_AUTO_TEST_CASE(MultiplePrefixes)
+{
+  Rv rv(face, m_keyChain, options);
+  rv.start();
+  advanceClocks(1_ms, 10);
+
+  // each prefix answers with its own key
+  face.receive(makeRequest("/rv2"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_TEST(face.sentData[0].getName().getPrefix(1) == "/rv2");
+  BOOST_TEST(isAckSignedBy(face.sentData[0], "/rv2"));
+
+  advanceClocks(1_s);
+  face.receive(makeRequest("/rv1"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_TEST(face.sentData[1].getName().getPrefix(1) == "/rv1");
+  BOOST_TEST(isAckSignedBy(face.sentData[1], "/rv1"));
+  BOOST_TEST(rv.getStats().nValidated == 2);
+
+  // neither prefix is served after stop()
+  rv.stop();
+  advanceClocks(1_s);
+  face.receive(makeRequest("/rv1"));
+  face.receive(makeRequest("/rv2"));
+  advanceClocks(1_ms, 10);
+  BOOST_TEST(face.sentData.size() == 2);
+  BOOST_TEST(rv.getStats().nRequests == 2);
+}
+
+BOOST_AUTO_TEST_CASE(WorkerVerifyAndSign)
+{
+  options.nWorkers = 2;
+  Rv rv(face, m_keyChain, options);
+  rv.start();
+  advanceClocks(1_ms, 10);
+
+  // the first request goes through the full validator and caches the key of /alice
+  face.receive(makeRequest("/rv1"));
+  advanceClocks(1_ms, 10);
+  waitForAcks(rv, 1);
+  BOOST_TEST(rv.getStats().nValidated == 1);
+
+  // the refresh is verified against the cached key and its Ack is signed on a worker
+  advanceClocks(1_s);
+  Interest refresh = makeRequest("/rv1");
+  face.receive(refresh);
+  advanceClocks(1_ms, 10);
+  waitForAcks(rv, 2);
+  BOOST_TEST(rv.getStats().nCacheHits == 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  BOOST_TEST(isAckSignedBy(face.sentData[1], "/rv1"));
+
+  // a replay of the refresh does not reach the workers
+  face.receive(refresh);
+  advanceClocks(1_ms, 10);
+  BOOST_TEST(rv.getStats().nStale == 1);
+  BOOST_TEST(rv.getStats().nRejected == 1);
+  BOOST_TEST(rv.getStats().nAcks == 2);
+  BOOST_TEST(face.sentData.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(LocationStatus)
+{
+  options.statusPrefix = "/status";
+  options.snapshotPath = std::string(UNIT_TESTS_TMPDIR) + "/rv-locations";
+  boost::filesystem::remove(options.snapshotPath);
+  Rv rv(face, m_keyChain, options);
+  rv.start();
+  advanceClocks(1_ms, 10);
+
+  Interest request = makeRequest("/rv1");
+  request.setTag(make_shared<lp::IncomingFaceIdTag>(300));
+  face.receive(request);
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+  // the longest producer prefix of the name is looked up
+  face.receive(Interest("/status/location/alice/video/1"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  const Data& found = face.sentData[1];
+  BOOST_TEST(found.getName() == "/status/location/alice/video/1");
+  BOOST_TEST(found.getContentType() == tlv::ContentType_Blob);
+  std::string content(reinterpret_cast<const char*>(found.getContent().value()),
+                      found.getContent().value_size());
+  BOOST_TEST(content.find("producer=/alice\n") != std::string::npos);
+  BOOST_TEST(content.find("rv=/rv1\n") != std::string::npos);
+  BOOST_TEST(content.find("face=300\n") != std::string::npos);
+
+  face.receive(Interest("/status/location/bob"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_TEST(face.sentData[2].getContentType() == tlv::ContentType_Nack);
+
+  // the table is saved when the Rv stops
+  BOOST_TEST(!boost::filesystem::exists(options.snapshotPath));
+  rv.stop();
+  BOOST_TEST(boost::filesystem::exists(options.snapshotPath));
+  LocationTable restored;
+  BOOST_TEST(restored.loadSnapshot(options.snapshotPath) == 1);
+  boost::filesystem::remove(options.snapshotPath);
+}
+
+BOOST_AUTO_TEST_CASE(PeriodicSnapshot)
+{
+  options.snapshotPath = std::string(UNIT_TESTS_TMPDIR) + "/rv-locations";
+  options.snapshotInterval = 5_s;
+  boost::filesystem::remove(options.snapshotPath);
+  Rv rv(face, m_keyChain, options);
+  rv.start();
+  advanceClocks(1_ms, 10);
+
+  // an unchanged table is not written
+  advanceClocks(1_s, 10);
+  BOOST_TEST(!boost::filesystem::exists(options.snapshotPath));
+
+  face.receive(makeRequest("/rv1"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  advanceClocks(1_s, 6);
+  BOOST_TEST(boost::filesystem::exists(options.snapshotPath));
+
+  // a restarted RV, e.g. after SIGKILL, finds the producer without a stop()
+  LocationTable restored;
+  BOOST_TEST(restored.loadSnapshot(options.snapshotPath) == 1);
+  BOOST_TEST(restored.find("/alice") != nullptr);
+  boost::filesystem::remove(options.snapshotPath);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptSnapshot)
+{
+  options.statusPrefix = "/status";
+  options.snapshotPath = std::string(UNIT_TESTS_TMPDIR) + "/rv-locations";
+  std::ofstream(options.snapshotPath) << "not a snapshot";
+  Rv rv(face, m_keyChain, options);
+  BOOST_CHECK_NO_THROW(rv.start());
+  advanceClocks(1_ms, 10);
+
+  // the RV starts with an empty table and still serves requests
+  face.receive(makeRequest("/rv1"));
+  advanceClocks(1_ms, 10);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+
+  rv.stop();
+  LocationTable restored;
+  BOOST_TEST(restored.loadSnapshot(options.snapshotPath) == 1);
+  boost::filesystem::remove(options.snapshotPath);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRv
+BOOST_AUTO_TEST_SUITE_END() // Kite
+
+} // namespace tests
+} // namespace rv
+} // namespace kite
+} // namespace ndn
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "worker-pool.hpp"
+
+namespace ndn {
+namespace kite {
+
+WorkerPool::WorkerPool(size_t nWorkers)
+{
+  for (size_t i = 0; i < nWorkers; ++i) {
+    auto worker = make_unique<Worker>();
+    worker->thread = std::thread([w = worker.get()] { w->io.run(); });
+    m_workers.push_back(std::move(worker));
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  for (auto& worker : m_workers) {
+    worker->work.reset();
+    worker->io.stop();
+  }
+  for (auto& worker : m_workers) {
+    worker->thread.join();
+  }
+}
+
+void
+WorkerPool::importSigningKey(const security::SafeBag& safeBag, const char* pw, size_t pwLen)
+{
+  for (auto& worker : m_workers) {
+    worker->keyChain.importSafeBag(safeBag, pw, pwLen);
+  }
+}
+
+void
+WorkerPool::post(Task task)
+{
+  BOOST_ASSERT(!m_workers.empty());
+  Worker& worker = *m_workers[m_next];
+  m_next = (m_next + 1) % m_workers.size();
+
+  ++m_nPending;
+  boost::asio::post(worker.io, [this, &worker, task = std::move(task)] {
+    task(worker.keyChain);
+    --m_nPending;
+  });
+}
+
+} // namespace kite
+} // namespace ndn
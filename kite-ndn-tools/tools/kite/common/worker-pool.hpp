@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDN_TOOLS_KITE_COMMON_WORKER_POOL_HPP
+#define NDN_TOOLS_KITE_COMMON_WORKER_POOL_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/security/safe-bag.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace ndn {
+namespace kite {
+
+/**
+ * @brief Threads that verify and sign packets off the Face thread
+ *
+ * KeyChain is not thread-safe, so every worker signs with its own in-memory KeyChain
+ * holding copies of the signing keys.
+ */
+class WorkerPool : noncopyable
+{
+public:
+  using Task = std::function<void(KeyChain& keyChain)>;
+
+  explicit
+  WorkerPool(size_t nWorkers);
+
+  ~WorkerPool();
+
+  /**
+   * @brief Imports a signing certificate and its private key into every worker's KeyChain
+   * @note Must be called before the first post()
+   */
+  void
+  importSigningKey(const security::SafeBag& safeBag, const char* pw, size_t pwLen);
+
+  /**
+   * @brief Runs @p task on the next worker, round-robin
+   */
+  void
+  post(Task task);
+
+  size_t
+  size() const
+  {
+    return m_workers.size();
+  }
+
+  /**
+   * @return number of tasks posted but not finished yet
+   */
+  size_t
+  getNPending() const
+  {
+    return m_nPending;
+  }
+
+private:
+  struct Worker
+  {
+    boost::asio::io_context io;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{io.get_executor()};
+    KeyChain keyChain{"pib-memory:", "tpm-memory:"};
+    std::thread thread;
+  };
+
+  std::vector<unique_ptr<Worker>> m_workers;
+  size_t m_next = 0;
+  std::atomic<size_t> m_nPending{0};
+};
+
+} // namespace kite
+} // namespace ndn
+
+#endif // NDN_TOOLS_KITE_COMMON_WORKER_POOL_HPP
@@ -118,6 +118,7 @@ main(int argc, char* argv[])
   options.lifetime = time::milliseconds(getDefaultLifetime());
   options.action = 0;
   std::string identifier;
+  std::string signingMode;
 
   namespace po = boost::program_options;
 
@@ -125,8 +126,10 @@ main(int argc, char* argv[])
   visibleOptDesc.add_options()
     ("help,h", "print this message and exit")
     ("version,V", "display version and exit")
-    ("rv-prefix,r", po::value<std::string>(), "RV prefix")
-    ("producer-suffix,p", po::value<std::string>(), "producer suffix")
+    ("rv-prefix,r", po::value<std::vector<std::string>>()->composing(),
+                    "RV prefix, may be repeated together with --producer-suffix")
+    ("producer-suffix,p", po::value<std::vector<std::string>>()->composing(),
+                    "producer suffix, the n-th one is announced through the n-th RV prefix")
     ("interval,i", po::value<int>(),
                    ("set interval in milliseconds (default " +
                    std::to_string(getDefaultInterval().count()) + " ms").c_str())
@@ -134,7 +137,19 @@ main(int argc, char* argv[])
                    ("set lifetime in milliseconds (default " +
                    std::to_string(getDefaultLifetime().count()) + " ms").c_str())
     ("action,a", po::value<int>(), "set producer action. 0 means send data, 1 means send nack, 2 means send nothing. default 0")
-    ("send-interest,s", po::bool_switch(&options.sendInterest), "send interest. before mp send trace interest, send a comsuner interest. after regist succeed, mp will receive thr interest.");
+    ("send-interest,s", po::bool_switch(&options.sendInterest), "send interest. before mp send trace interest, send a comsuner interest. after regist succeed, mp will receive thr interest.")
+    ("manual,m", "do not send requests automatically, only on SIGINT")
+    ("jitter,j", po::value<double>(&options.jitter)->default_value(options.jitter),
+                 "shorten each refresh delay by a random fraction of up to this value")
+    ("signing", po::value<std::string>(&signingMode)->default_value("identity"),
+                "Data signature: identity, sha256 (DigestSha256), or hmac")
+    ("hmac-key", po::value<std::string>(&options.hmacKey), "base64-encoded key for --signing=hmac")
+    ("signers", po::value<size_t>(&options.nSigners)->default_value(options.nSigners),
+                "number of signing threads (0 to sign on the main thread)")
+    ("max-pending", po::value<size_t>(&options.maxPendingSigns)->default_value(options.maxPendingSigns),
+                    "Interests waiting for a signing thread before new ones are dropped")
+    ("cache-size", po::value<size_t>(&options.cacheSize)->default_value(options.cacheSize),
+                   "number of signed Data kept to answer repeated Interests (0 to disable)")
   ;
 
   po::options_description optDesc("Allowed options");
@@ -145,8 +160,6 @@ main(int argc, char* argv[])
     po::store(po::command_line_parser(argc, argv).options(optDesc).run(), optVm);
     po::notify(optVm);
 
-    PrefixPair prefixPair;
-
     if (optVm.count("help") > 0) {
       usage(visibleOptDesc);
     }
@@ -156,23 +169,52 @@ main(int argc, char* argv[])
       exit(0);
     }
 
-    if (optVm.count("rv-prefix") > 0) {
-      prefixPair.rvPrefix = Name(optVm["rv-prefix"].as<std::string>());
-    }
-    else {
+    if (optVm.count("rv-prefix") == 0) {
       std::cerr << "ERROR: No RV prefix specified" << std::endl;
       usage(visibleOptDesc);
     }
 
-    if (optVm.count("producer-suffix") > 0) {
-      prefixPair.producerSuffix = Name(optVm["producer-suffix"].as<std::string>());
-    }
-    else {
+    if (optVm.count("producer-suffix") == 0) {
       std::cerr << "ERROR: No producer suffix specified" << std::endl;
       usage(visibleOptDesc);
     }
 
-    options.prefixPairs.push_back(prefixPair);
+    const auto& rvPrefixes = optVm["rv-prefix"].as<std::vector<std::string>>();
+    const auto& producerSuffixes = optVm["producer-suffix"].as<std::vector<std::string>>();
+    if (rvPrefixes.size() != producerSuffixes.size()) {
+      std::cerr << "ERROR: Each producer suffix needs exactly one RV prefix" << std::endl;
+      usage(visibleOptDesc);
+    }
+    for (size_t i = 0; i < rvPrefixes.size(); ++i) {
+      PrefixPair prefixPair;
+      prefixPair.rvPrefix = Name(rvPrefixes[i]);
+      prefixPair.producerSuffix = Name(producerSuffixes[i]);
+      options.prefixPairs.push_back(prefixPair);
+    }
+
+    options.wantRefresh = optVm.count("manual") == 0;
+
+    if (signingMode == "identity") {
+      options.signingMode = SigningMode::IDENTITY;
+    }
+    else if (signingMode == "sha256") {
+      options.signingMode = SigningMode::SHA256;
+    }
+    else if (signingMode == "hmac") {
+      options.signingMode = SigningMode::HMAC;
+      if (options.hmacKey.empty()) {
+        std::cerr << "ERROR: --signing=hmac requires --hmac-key" << std::endl;
+        usage(visibleOptDesc);
+      }
+    }
+    else {
+      std::cerr << "ERROR: Unknown signing mode " << signingMode << std::endl;
+      usage(visibleOptDesc);
+    }
+    if (options.jitter < 0.0 || options.jitter >= 1.0) {
+      std::cerr << "ERROR: Jitter must be in [0, 1)" << std::endl;
+      usage(visibleOptDesc);
+    }
 
     if (optVm.count("interval") > 0) {
       options.interval = time::milliseconds(optVm["interval"].as<int>());
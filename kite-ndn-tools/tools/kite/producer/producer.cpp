@@ -25,6 +25,7 @@
 #include <ndn-cxx/kite/request.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
 #include <ndn-cxx/util/logger.hpp>
+#include <ndn-cxx/util/random.hpp>
 
 namespace ndn {
 namespace kite {
@@ -37,33 +38,113 @@ Producer::Producer(Face& face, KeyChain& keyChain, const Options& options)
   , m_face(face)
   , m_keyChain(keyChain)
   , m_scheduler(m_face.getIoService())
+  , m_signer(m_keyChain)
 {
+  if (m_options.signingMode == SigningMode::HMAC) {
+    m_memKeyChain = make_unique<KeyChain>("pib-memory:", "tpm-memory:");
+  }
+  if (m_options.cacheSize > 0) {
+    m_dataCache = make_unique<InMemoryStorageLru>(m_options.cacheSize);
+  }
 }
 
 void
 Producer::start()
 {
-  // only the first prefix now
-  Name producerPrefix(m_options.prefixPairs[0].producerSuffix);
-  m_registeredPrefix = m_face.setInterestFilter(
-                       producerPrefix,
-                       bind(&Producer::onInterest, this, _1, _2),
-                       [] (const auto&, const auto& reason) {
-                         NDN_THROW(std::runtime_error("Failed to register prefix: " + reason));
-                       });
-  
-  // sendKiteRequest();
+  for (const auto& prefixPair : m_options.prefixPairs) {
+    // a malformed HMAC key fails here rather than on every Interest
+    m_registeredPrefixes.push_back(m_face.setInterestFilter(
+      prefixPair.producerSuffix,
+      [this, si = makeSigningInfo(prefixPair.producerSuffix)] (const auto& filter, const auto& interest) {
+        this->onInterest(filter, interest, si);
+      },
+      [] (const auto&, const auto& reason) {
+        NDN_THROW(std::runtime_error("Failed to register prefix: " + reason));
+      }));
+
+    auto state = make_unique<PairState>();
+    state->prefixPair = prefixPair;
+    m_pairs.push_back(std::move(state));
+  }
+
+  if (m_options.nSigners > 0 && !setupSigners()) {
+    m_signers.reset();
+  }
+
+  if (m_options.wantRefresh) {
+    sendKiteRequest();
+  }
+}
+
+bool
+Producer::setupSigners()
+{
+  m_signers = make_unique<WorkerPool>(m_options.nSigners);
+  if (m_options.signingMode != SigningMode::IDENTITY) {
+    return true;
+  }
+
+  // the password only protects the SafeBag while it is copied in memory
+  std::array<char, 16> pw;
+  random::generateSecureBytes(make_span(reinterpret_cast<uint8_t*>(pw.data()), pw.size()));
+  for (const auto& prefixPair : m_options.prefixPairs) {
+    try {
+      auto cert = m_keyChain.getPib().getIdentity(prefixPair.producerSuffix)
+                  .getDefaultKey().getDefaultCertificate();
+      auto safeBag = m_keyChain.exportSafeBag(cert, pw.data(), pw.size());
+      m_signers->importSigningKey(*safeBag, pw.data(), pw.size());
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_WARN("Cannot copy signing key of " << prefixPair.producerSuffix
+                   << " to signers, signing on the Face thread: " << e.what());
+      return false;
+    }
+  }
+  return true;
+}
+
+security::SigningInfo
+Producer::makeSigningInfo(const Name& producerPrefix) const
+{
+  switch (m_options.signingMode) {
+    case SigningMode::SHA256:
+      return security::signingWithSha256();
+    case SigningMode::HMAC: {
+      security::SigningInfo si;
+      si.setSigningHmacKey(m_options.hmacKey);
+      return si;
+    }
+    case SigningMode::IDENTITY:
+    default:
+      return security::signingByIdentity(producerPrefix);
+  }
+}
+
+void
+Producer::deliver(const shared_ptr<const Data>& data)
+{
+  if (m_dataCache != nullptr) {
+    m_dataCache->insert(*data);
+  }
+  m_face.put(*data);
 }
 
 void
 Producer::stop()
 {
-  m_registeredPrefix.cancel();
+  for (auto& handle : m_registeredPrefixes) {
+    handle.cancel();
+  }
+  m_registeredPrefixes.clear();
+  m_pairs.clear();
   m_scheduler.cancelAllEvents();
+  m_alive = make_shared<int>();
+  m_signingNames.clear();
 }
 
 void
-Producer::onInterest(const InterestFilter& filter, const Interest& interest)
+Producer::onInterest(const InterestFilter& filter, const Interest& interest,
+                     const security::SigningInfo& si)
 {
   afterReceive(interest.getName());
 
@@ -72,11 +153,58 @@ Producer::onInterest(const InterestFilter& filter, const Interest& interest)
   switch(m_options.action) {
     case 0:
     {
-      Name producerPrefix(filter.getPrefix());
+      if (m_dataCache != nullptr) {
+        // answered from the already encoded wire, no signing or encoding
+        auto cached = m_dataCache->find(interest);
+        if (cached != nullptr) {
+          ++nCacheHits;
+          m_face.put(*cached);
+          break;
+        }
+      }
+
       auto data = make_shared<Data>(interest.getName());
       data->setContent(interest.wireEncode());
-      m_keyChain.sign(*data, ndn::security::signingByIdentity(producerPrefix));
-      m_face.put(*data);
+      if (m_signers == nullptr) {
+        (m_memKeyChain != nullptr ? *m_memKeyChain : m_keyChain).sign(*data, si);
+        ++nSigned;
+        deliver(data);
+        break;
+      }
+
+      if (m_signers->getNPending() >= m_options.maxPendingSigns) {
+        NDN_LOG_DEBUG("Signers saturated, dropping " << interest.getName());
+        ++nDropped;
+        break;
+      }
+      if (!m_signingNames.insert(data->getName()).second) {
+        // the Data being signed satisfies this Interest as well
+        break;
+      }
+      // the worker does not touch the Producer, which may be stopped or destroyed meanwhile
+      m_signers->post([this, data, si, alive = weak_ptr<int>(m_alive),
+                       &io = m_face.getIoService()] (KeyChain& keyChain) {
+        try {
+          keyChain.sign(*data, si);
+        }
+        catch (const std::exception& e) {
+          NDN_LOG_WARN("Cannot sign " << data->getName() << ": " << e.what());
+          boost::asio::post(io, [this, alive, name = data->getName()] {
+            if (!alive.expired()) {
+              m_signingNames.erase(name);
+            }
+          });
+          return;
+        }
+        boost::asio::post(io, [this, alive, data] {
+          if (alive.expired()) {
+            return;
+          }
+          m_signingNames.erase(data->getName());
+          ++nSigned;
+          deliver(data);
+        });
+      });
       break;
     }
     case 1:
@@ -89,48 +217,126 @@ Producer::onInterest(const InterestFilter& filter, const Interest& interest)
 }
 
 void
-Producer::onData(const Interest& interest, const Data& data)
+Producer::onData(const Data& data)
 {
-  Request req;
-  req.decode(interest);
-  Ack ack(data);
-
-  NDN_LOG_DEBUG("Received Ack for: " << req.getProducerPrefix());
+  NDN_LOG_DEBUG("Received Data: " << data.getName());
 }
 
 void
 Producer::sendKiteRequest()
 {
-  if(m_options.sendInterest) {
-    Interest interest(m_options.prefixPairs[0].producerSuffix);
+  for (auto& state : m_pairs) {
+    sendKiteRequest(*state);
+  }
+}
+
+void
+Producer::sendKiteRequest(PairState& state)
+{
+  const auto& prefixPair = state.prefixPair;
+  if (m_options.sendInterest) {
+    Interest interest(prefixPair.producerSuffix);
     interest.setCanBePrefix(false);
     interest.setMustBeFresh(false);
     Name fh;
     fh.append(ndn::kite::KITE_KEYWORD);
-    fh.append(m_options.prefixPairs[0].rvPrefix); 
+    fh.append(prefixPair.rvPrefix);
     interest.setForwardingHint({fh});
     interest.setHopLimit(100);
-    m_pendingInterest = m_face.expressInterest(interest,
-                                              [this, &interest] (auto&&, const auto& data) { this->onData(interest, data); },
-                                              [this] (auto&&, const auto& nack) { this->onNack(nack); },
-                                              [this, &interest] (auto&&) { this->onTimeout(interest); });
+    state.pendingInterest = m_face.expressInterest(interest,
+                                                   [this] (auto&&, const auto& data) { this->onData(data); },
+                                                   [this] (auto&&, const auto& nack) { this->onNack(nack); },
+                                                   [this] (const auto& interest) { this->onTimeout(interest); });
   }
-  Name producerPrefix(m_options.prefixPairs[0].rvPrefix);
+
   Request req;
-  req.setRvPrefix(m_options.prefixPairs[0].rvPrefix);
-  req.setProducerSuffix(m_options.prefixPairs[0].producerSuffix);
+  req.setRvPrefix(prefixPair.rvPrefix);
+  req.setProducerSuffix(prefixPair.producerSuffix);
   req.setExpiration(m_options.lifetime);
-  ndn::security::InterestSigner signer(m_keyChain);
-  Interest interest = req.makeInterest(signer, ndn::security::signingByIdentity(Name(m_options.prefixPairs[0].producerSuffix)));
+  Interest interest = req.makeInterest(m_signer, ndn::security::signingByIdentity(prefixPair.producerSuffix));
 
   NDN_LOG_DEBUG("Sending Request: " << interest.getName());
 
-  m_face.expressInterest(interest,
-                         bind(&Producer::onData, this, _1, _2),
-                         bind(&Producer::onNack, this, _2),
-                         bind(&Producer::onTimeout, this, _1));
+  state.nextRefresh.cancel();
+  state.pendingRequest = m_face.expressInterest(interest,
+    [this, &state] (const auto& interest, const auto& data) { this->onAck(state, interest, data); },
+    [this, &state] (auto&&, const auto& nack) {
+      NDN_LOG_DEBUG("Received NACK for request: " << nack.getReason());
+      this->onRequestFailure(state);
+    },
+    [this, &state] (const auto& interest) {
+      NDN_LOG_DEBUG("Request timed out: " << interest.getName());
+      this->onRequestFailure(state);
+    });
+}
+
+void
+Producer::onAck(PairState& state, const Interest& interest, const Data& data)
+{
+  Request req;
+  req.decode(interest);
+  time::milliseconds expiration = m_options.lifetime;
+  try {
+    Ack ack(data);
+    if (!req.canMatch(ack)) {
+      NDN_LOG_DEBUG("Ack does not match request for: " << req.getProducerPrefix());
+      onRequestFailure(state);
+      return;
+    }
+    expiration = ack.getPrefixAnnouncement()->getExpiration();
+  }
+  catch (const tlv::Error& e) {
+    NDN_LOG_DEBUG("Malformed Ack for " << req.getProducerPrefix() << ": " << e.what());
+    onRequestFailure(state);
+    return;
+  }
+
+  NDN_LOG_DEBUG("Received Ack for: " << req.getProducerPrefix());
+  state.backoff = 0_ms;
+  if (m_options.wantRefresh) {
+    scheduleRefresh(state, getRefreshDelay(expiration));
+  }
+}
+
+void
+Producer::onRequestFailure(PairState& state)
+{
+  state.backoff = getNextBackoff(state.backoff);
+  if (m_options.wantRefresh) {
+    scheduleRefresh(state, addJitter(state.backoff, 0.5));
+  }
+}
+
+void
+Producer::scheduleRefresh(PairState& state, time::nanoseconds delay)
+{
+  NDN_LOG_TRACE("Next request for " << state.prefixPair.producerSuffix << " in " << delay);
+  state.nextRefresh = m_scheduler.schedule(delay, [this, &state] { sendKiteRequest(state); });
+}
 
-  // m_nextUpdateEvent = m_scheduler.schedule(m_options.interval, [this] { sendKiteRequest(); });
+time::nanoseconds
+Producer::getRefreshDelay(time::milliseconds expiration) const
+{
+  // refresh well before the announcement expires, and no later than the configured interval
+  auto delay = std::min<time::nanoseconds>(
+    time::duration_cast<time::nanoseconds>(expiration * m_options.refreshRatio), m_options.interval);
+  return addJitter(delay, m_options.jitter);
+}
+
+time::milliseconds
+Producer::getNextBackoff(time::milliseconds backoff) const
+{
+  if (backoff <= 0_ms) {
+    return m_options.initialBackoff;
+  }
+  return std::min(backoff * 2, m_options.maxBackoff);
+}
+
+time::nanoseconds
+Producer::addJitter(time::nanoseconds delay, double jitter)
+{
+  std::uniform_real_distribution<double> dist(0.0, jitter);
+  return time::duration_cast<time::nanoseconds>(delay * (1.0 - dist(random::getRandomNumberEngine())));
 }
 
 void
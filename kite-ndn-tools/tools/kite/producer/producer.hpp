@@ -23,8 +23,13 @@
 #define NDN_TOOLS_KITE_PRODUCER_HPP
 
 #include "core/common.hpp"
+#include "tools/kite/common/worker-pool.hpp"
+
+#include <ndn-cxx/ims/in-memory-storage-lru.hpp>
 #include <ndn-cxx/kite/request.hpp>
 
+#include <set>
+
 namespace ndn
 {
   namespace kite
@@ -40,6 +45,15 @@ namespace ndn
         Name producerSuffix; //!< producer suffix
       };
 
+      /**
+       * @brief How Data packets are signed
+       */
+      enum class SigningMode {
+        IDENTITY, //!< with the key of the producer identity
+        SHA256,   //!< DigestSha256, integrity only
+        HMAC,     //!< HMAC-SHA256 with a shared key
+      };
+
       /**
        * @brief Options for Producer
        */
@@ -51,6 +65,16 @@ namespace ndn
         int action;                          // action. 0 means send data, 1 means send ack, 2 means do nothing
         bool sendInterest;                   // send interest. before mp send trace interest, send a comsuner interest.
                                              // after regist cusseed, mp will receive thr interest.
+        bool wantRefresh = true;             //!< reissue requests before the announcement expires
+        double refreshRatio = 0.75;          //!< refresh after this fraction of the announcement lifetime
+        double jitter = 0.1;                 //!< refresh delays are shortened by up to this fraction
+        time::milliseconds initialBackoff = 100_ms; //!< retry delay after the first Nack or timeout
+        time::milliseconds maxBackoff = 10_s;       //!< retry delay limit
+        SigningMode signingMode = SigningMode::IDENTITY; //!< signature type of Data
+        std::string hmacKey;                 //!< base64-encoded key for SigningMode::HMAC
+        size_t nSigners = 0;                 //!< signing threads (0 == sign on the Face thread)
+        size_t maxPendingSigns = 1024;       //!< Interests waiting for a signer before new ones are dropped
+        size_t cacheSize = 0;                //!< signed Data kept to answer repeated Interests (0 == none)
       };
 
       /**
@@ -83,19 +107,81 @@ namespace ndn
         stop();
 
         /**
-         * @brief Send a new KITE request
+         * @brief Send a new KITE request for every prefix pair
          */
         void
         sendKiteRequest();
 
+      private:
+        /**
+         * @brief Refresh state of one prefix pair
+         */
+        struct PairState
+        {
+          PrefixPair prefixPair;
+          scheduler::ScopedEventId nextRefresh;
+          ScopedPendingInterestHandle pendingRequest;
+          ScopedPendingInterestHandle pendingInterest;
+          time::milliseconds backoff = 0_ms; //!< current retry delay, zero after an Ack
+        };
+
+        void
+        sendKiteRequest(PairState& state);
+
+        void
+        onAck(PairState& state, const Interest& interest, const Data& data);
+
+        void
+        onRequestFailure(PairState& state);
+
+        /**
+         * @brief Copies the producer keys into the signer KeyChains
+         * @return false if a key cannot be exported
+         */
+        bool
+        setupSigners();
+
+        security::SigningInfo
+        makeSigningInfo(const Name& producerPrefix) const;
+
+        /**
+         * @brief Caches a signed Data and sends it
+         */
+        void
+        deliver(const shared_ptr<const Data>& data);
+
+        void
+        scheduleRefresh(PairState& state, time::nanoseconds delay);
+
+        /**
+         * @return @p delay shortened by a random fraction of up to @p jitter
+         */
+        static time::nanoseconds
+        addJitter(time::nanoseconds delay, double jitter);
+
+      PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+        /**
+         * @return delay before the next request after an Ack that announced @p expiration
+         */
+        time::nanoseconds
+        getRefreshDelay(time::milliseconds expiration) const;
+
+        /**
+         * @return next retry delay after a Nack or timeout, given the current one
+         */
+        time::milliseconds
+        getNextBackoff(time::milliseconds backoff) const;
+
       private:
         /**
          * @brief Called when Interest received
          *
          * @param interest incoming Interest
+         * @param si how Data under @p filter is signed, built once in start()
          */
         void
-        onInterest(const InterestFilter &filter, const Interest &interest);
+        onInterest(const InterestFilter &filter, const Interest &interest,
+                   const security::SigningInfo &si);
 
         /**
          * @brief Called when Data received
@@ -103,7 +189,7 @@ namespace ndn
          * @param data incoming data
          */
         void
-        onData(const Interest &interest, const Data &data);
+        onData(const Data &data);
 
         /**
          * @brief Process a potential KITE acknowledgment
@@ -133,14 +219,25 @@ namespace ndn
         void
         onTimeout(const Interest &interest);
 
+      public:
+        uint64_t nSigned = 0;    //!< Data signed
+        uint64_t nCacheHits = 0; //!< Interests answered from the Data cache
+        uint64_t nDropped = 0;   //!< Interests dropped because the signers were saturated
+
       private:
         const Options &m_options;
         Face &m_face;
         KeyChain &m_keyChain;
-        RegisteredPrefixHandle m_registeredPrefix;
+        std::vector<RegisteredPrefixHandle> m_registeredPrefixes;
         Scheduler m_scheduler;
-        scheduler::ScopedEventId m_nextUpdateEvent;
-        PendingInterestHandle m_pendingInterest;
+        security::InterestSigner m_signer;
+        std::vector<unique_ptr<PairState>> m_pairs;
+        unique_ptr<KeyChain> m_memKeyChain;  //!< keeps HMAC keys out of the persistent TPM
+        unique_ptr<WorkerPool> m_signers;
+        unique_ptr<InMemoryStorageLru> m_dataCache;
+        std::set<Name> m_signingNames;       //!< Data being signed by a worker
+        /// expires when the Producer stops, signing results posted to the Face thread check it first
+        shared_ptr<int> m_alive = make_shared<int>();
       };
 
     } // namespace producer
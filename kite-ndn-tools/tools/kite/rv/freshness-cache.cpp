@@ -0,0 +1,275 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "freshness-cache.hpp"
+
+#include <ndn-cxx/util/logger.hpp>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+
+NDN_LOG_INIT(kite.rv.FreshnessCache);
+
+NonceFilter::NonceFilter(size_t nBits, time::nanoseconds interval)
+  : m_nBits(std::max<size_t>(nBits, 64))
+  , m_interval(interval)
+  , m_bucketStart(time::steady_clock::now())
+{
+  for (auto& bucket : m_buckets) {
+    bucket.resize((m_nBits + 63) / 64);
+  }
+}
+
+size_t
+NonceFilter::getNLiveBuckets() const
+{
+  auto age = time::steady_clock::now() - m_bucketStart;
+  if (age < m_interval) {
+    return 2;
+  }
+  // the current bucket has become the previous one
+  return age < 2 * m_interval ? 1 : 0;
+}
+
+template<typename F>
+void
+NonceFilter::forEachBit(span<const uint8_t> nonce, const F& f) const
+{
+  // FNV-1a, the second hash for double hashing is taken from the upper half
+  uint64_t h = 0xcbf29ce484222325;
+  for (auto b : nonce) {
+    h = (h ^ b) * 0x100000001b3;
+  }
+  uint64_t step = (h >> 32) | 1;
+  for (size_t i = 0; i < N_HASHES; ++i, h += step) {
+    f(h % m_nBits);
+  }
+}
+
+bool
+NonceFilter::contains(span<const uint8_t> nonce) const
+{
+  size_t nLive = getNLiveBuckets();
+  for (size_t i = 0; i < nLive; ++i) {
+    const auto& bucket = m_buckets[i];
+    bool isFound = true;
+    forEachBit(nonce, [&] (size_t bit) {
+      isFound = isFound && (bucket[bit / 64] & (uint64_t(1) << (bit % 64))) != 0;
+    });
+    if (isFound) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+NonceFilter::add(span<const uint8_t> nonce)
+{
+  auto now = time::steady_clock::now();
+  if (now - m_bucketStart >= m_interval) {
+    if (now - m_bucketStart >= 2 * m_interval) {
+      std::fill(m_buckets[1].begin(), m_buckets[1].end(), 0);
+      m_bucketStart = now;
+    }
+    else {
+      m_bucketStart += m_interval;
+    }
+    std::swap(m_buckets[0], m_buckets[1]);
+    std::fill(m_buckets[0].begin(), m_buckets[0].end(), 0);
+  }
+
+  auto& bucket = m_buckets[0];
+  forEachBit(nonce, [&] (size_t bit) {
+    bucket[bit / 64] |= uint64_t(1) << (bit % 64);
+  });
+}
+
+FreshnessCache::FreshnessCache(const Options& options)
+  : m_options(options)
+{
+}
+
+static bool
+hasUsableKey(const shared_ptr<const security::transform::PublicKey>& key,
+             time::steady_clock::time_point expiry, time::system_clock::time_point notAfter)
+{
+  return key != nullptr && expiry > time::steady_clock::now() && notAfter > time::system_clock::now();
+}
+
+FreshnessCache::Lookup
+FreshnessCache::lookup(const Request& req, const Name& keyLocator) const
+{
+  if (!req.getTimestamp() || !req.getNonce()) {
+    return {Decision::VALIDATE, nullptr};
+  }
+
+  auto keyIt = m_keys.find(keyLocator);
+  const KeyEntry* keyEntry = keyIt == m_keys.end() ? nullptr : &keyIt->second;
+  if (!isFresh(req, keyEntry)) {
+    return {Decision::REJECT, nullptr};
+  }
+
+  auto reqIt = m_requests.find(req.getProducerPrefix());
+  if (keyEntry == nullptr || !hasUsableKey(keyEntry->key, keyEntry->expiry, keyEntry->notAfter) ||
+      reqIt == m_requests.end() || reqIt->second.keyLocator != keyLocator ||
+      reqIt->second.request.getRvPrefix() != req.getRvPrefix()) {
+    return {Decision::VALIDATE, nullptr};
+  }
+
+  if (keyEntry->nonces.contains(*req.getNonce())) {
+    // most likely a false positive, the timestamp already rules out a replay
+    NDN_LOG_DEBUG("Possibly reused nonce under " << keyLocator);
+    return {Decision::VALIDATE, nullptr};
+  }
+  return {Decision::VERIFY, keyEntry->key};
+}
+
+bool
+FreshnessCache::accept(const Request& req, const Name& keyLocator)
+{
+  auto keyIt = m_keys.find(keyLocator);
+  if (!isFresh(req, keyIt == m_keys.end() ? nullptr : &keyIt->second)) {
+    return false;
+  }
+  // the key may have been evicted while the signature was checked
+  KeyEntry* entry = keyIt == m_keys.end() ? getOrCreateKey(keyLocator) : &keyIt->second;
+  if (entry == nullptr) {
+    // unrecorded, a replay would pass the full validator, which has not seen this request
+    return false;
+  }
+  record(req, keyLocator, *entry);
+  return true;
+}
+
+void
+FreshnessCache::insert(const Request& req, const Name& keyLocator, const security::Certificate& cert)
+{
+  if (m_options.capacity == 0 || !req.getTimestamp() || !req.getNonce()) {
+    return;
+  }
+
+  KeyEntry* entryPtr = getOrCreateKey(keyLocator);
+  if (entryPtr == nullptr) {
+    // the full validator has recorded this request, so a replay is still rejected
+    return;
+  }
+  KeyEntry& entry = *entryPtr;
+
+  auto key = make_shared<security::transform::PublicKey>();
+  try {
+    key->loadPkcs8(cert.getPublicKey());
+    entry.key = std::move(key);
+  }
+  catch (const security::transform::PublicKey::Error& e) {
+    NDN_LOG_DEBUG("Cannot load public key of " << cert.getName() << ": " << e.what());
+    entry.key = nullptr;
+  }
+  entry.expiry = time::steady_clock::now() + m_options.keyLifetime;
+  entry.notAfter = cert.getValidityPeriod().getPeriod().second;
+
+  if (*req.getTimestamp() > entry.lastTimestamp) {
+    record(req, keyLocator, entry);
+  }
+}
+
+FreshnessCache::KeyEntry*
+FreshnessCache::getOrCreateKey(const Name& keyLocator)
+{
+  auto it = m_keys.find(keyLocator);
+  if (it == m_keys.end()) {
+    if (m_keys.size() >= m_options.capacity && !evictKey()) {
+      return nullptr;
+    }
+    it = m_keys.emplace(keyLocator, m_options).first;
+    m_keyIndex.emplace(it->second.lastAccepted, keyLocator);
+  }
+  return &it->second;
+}
+
+bool
+FreshnessCache::isFresh(const Request& req, const KeyEntry* entry) const
+{
+  auto timestamp = *req.getTimestamp();
+  auto now = time::system_clock::now();
+  if (timestamp < now - m_options.gracePeriod || timestamp > now + m_options.gracePeriod) {
+    return false;
+  }
+  return entry == nullptr || timestamp > entry->lastTimestamp;
+}
+
+void
+FreshnessCache::record(const Request& req, const Name& keyLocator, KeyEntry& entry)
+{
+  auto now = time::steady_clock::now();
+  entry.lastTimestamp = *req.getTimestamp();
+  m_keyIndex.erase({entry.lastAccepted, keyLocator});
+  entry.lastAccepted = now;
+  m_keyIndex.emplace(now, keyLocator);
+  entry.nonces.add(*req.getNonce());
+
+  const Name& producerPrefix = req.getProducerPrefix();
+  auto reqIt = m_requests.find(producerPrefix);
+  if (reqIt == m_requests.end()) {
+    if (m_requests.size() >= m_options.capacity) {
+      evictRequest();
+    }
+    reqIt = m_requests.emplace(producerPrefix, RequestEntry()).first;
+  }
+  else {
+    m_requestIndex.erase({reqIt->second.lastAccepted, producerPrefix});
+  }
+  reqIt->second.request = req;
+  reqIt->second.keyLocator = keyLocator;
+  reqIt->second.lastAccepted = now;
+  m_requestIndex.emplace(now, producerPrefix);
+}
+
+bool
+FreshnessCache::evictKey()
+{
+  if (m_keyIndex.empty()) {
+    return false;
+  }
+  auto oldest = m_keyIndex.begin();
+  auto keyIt = m_keys.find(oldest->second);
+  if (keyIt->second.lastTimestamp + m_options.gracePeriod >= time::system_clock::now()) {
+    NDN_LOG_DEBUG("Cache full, least recently used key " << oldest->second << " is within the grace period");
+    return false;
+  }
+  m_keys.erase(keyIt);
+  m_keyIndex.erase(oldest);
+  return true;
+}
+
+void
+FreshnessCache::evictRequest()
+{
+  if (m_requestIndex.empty()) {
+    return;
+  }
+  auto oldest = m_requestIndex.begin();
+  m_requests.erase(oldest->second);
+  m_requestIndex.erase(oldest);
+}
+
+} // namespace rv
+} // namespace kite
+} // namespace ndn
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDN_TOOLS_KITE_RV_FRESHNESS_CACHE_HPP
+#define NDN_TOOLS_KITE_RV_FRESHNESS_CACHE_HPP
+
+#include "core/common.hpp"
+
+#include <ndn-cxx/kite/request.hpp>
+#include <ndn-cxx/security/certificate.hpp>
+#include <ndn-cxx/security/transform/public-key.hpp>
+
+#include <array>
+#include <map>
+#include <set>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+
+/**
+ * @brief Time-bucketed Bloom filter of signature nonces
+ *
+ * Nonces are added to the current bucket. The previous bucket is still consulted for one more
+ * interval, so a nonce is remembered for at least one interval and at most two.
+ */
+class NonceFilter
+{
+public:
+  NonceFilter(size_t nBits, time::nanoseconds interval);
+
+  /**
+   * @retval false @p nonce was not added in the last interval
+   * @retval true @p nonce may have been added, false positives are possible
+   */
+  bool
+  contains(span<const uint8_t> nonce) const;
+
+  void
+  add(span<const uint8_t> nonce);
+
+private:
+  /**
+   * @brief Number of buckets that are still current
+   */
+  size_t
+  getNLiveBuckets() const;
+
+  template<typename F>
+  void
+  forEachBit(span<const uint8_t> nonce, const F& f) const;
+
+private:
+  static constexpr size_t N_HASHES = 3;
+
+  size_t m_nBits;
+  time::nanoseconds m_interval;
+  time::steady_clock::time_point m_bucketStart;
+  std::array<std::vector<uint64_t>, 2> m_buckets; //!< current bucket first
+};
+
+/**
+ * @brief Replay and freshness cache for KITE requests
+ *
+ * The RV keeps one entry per producer prefix. The entry holds the last accepted Request, its
+ * RV prefix, and the KeyLocator it was signed with. A second table is keyed by that KeyLocator.
+ * It holds the public key that passed full validation, the newest accepted timestamp, and a
+ * NonceFilter of the signature nonces seen under the key.
+ *
+ * The validator's decision depends only on the request name and the KeyLocator. A refresh that
+ * matches a cached entry and passes the freshness checks therefore needs just one signature
+ * check against the cached key. These are the same freshness rules as
+ * ValidationPolicySignedInterest. The cache must see every request the RV accepts, since
+ * requests it accepts never reach the validator's own records.
+ */
+class FreshnessCache : noncopyable
+{
+public:
+  struct Options
+  {
+    time::nanoseconds keyLifetime = 1_h;    //!< how long a verified key is trusted
+    time::nanoseconds gracePeriod = 2_min;  //!< accepted distance between a timestamp and now
+    size_t capacity = 65536;                //!< maximum number of producer prefixes or keys
+    size_t nonceFilterBits = 8192;          //!< bits per NonceFilter bucket
+  };
+
+  enum class Decision {
+    VALIDATE, //!< unknown producer or key, or a possibly reused nonce: ask the full validator
+    VERIFY,   //!< check the signature against the returned key
+    REJECT,   //!< stale timestamp, the request is a replay or too old
+  };
+
+  struct Lookup
+  {
+    Decision decision;
+    shared_ptr<const security::transform::PublicKey> key; //!< set for VERIFY only
+  };
+
+  explicit
+  FreshnessCache(const Options& options);
+
+  /**
+   * @brief Decides how a decoded request signed under @p keyLocator is to be validated
+   */
+  Lookup
+  lookup(const Request& req, const Name& keyLocator) const;
+
+  /**
+   * @brief Records a request whose signature was verified against a key from lookup()
+   * @return false if the request became stale in the meantime, or its key was evicted and the
+   *         cache is too busy to record it; it must then be rejected
+   */
+  bool
+  accept(const Request& req, const Name& keyLocator);
+
+  /**
+   * @brief Records a request accepted by the full validator and caches the public key of @p cert
+   *
+   * The key is trusted until the earlier of its NotAfter and the key lifetime. Nothing is cached
+   * while the cache is full of keys used within the grace period.
+   */
+  void
+  insert(const Request& req, const Name& keyLocator, const security::Certificate& cert);
+
+  size_t
+  size() const
+  {
+    return m_requests.size();
+  }
+
+  size_t
+  getNKeys() const
+  {
+    return m_keys.size();
+  }
+
+private:
+  struct KeyEntry
+  {
+    explicit
+    KeyEntry(const Options& options)
+      : nonces(options.nonceFilterBits, options.gracePeriod)
+    {
+    }
+
+    shared_ptr<const security::transform::PublicKey> key;
+    time::steady_clock::time_point expiry;
+    time::system_clock::time_point notAfter;
+    time::system_clock::time_point lastTimestamp;
+    time::steady_clock::time_point lastAccepted;
+    NonceFilter nonces;
+  };
+
+  struct RequestEntry
+  {
+    Request request;
+    Name keyLocator;
+    time::steady_clock::time_point lastAccepted;
+  };
+
+  /**
+   * @return the entry of @p keyLocator, or nullptr if the cache is full and no key can be evicted
+   */
+  KeyEntry*
+  getOrCreateKey(const Name& keyLocator);
+
+  bool
+  isFresh(const Request& req, const KeyEntry* entry) const;
+
+  void
+  record(const Request& req, const Name& keyLocator, KeyEntry& entry);
+
+  /**
+   * @brief Drops the key with the least recently accepted request
+   *
+   * A key whose newest timestamp is within the grace period is kept, since dropping it would let
+   * a replay of its last request reach the full validator.
+   *
+   * @return whether a key was dropped
+   */
+  bool
+  evictKey();
+
+  /**
+   * @brief Drops the least recently accepted request
+   */
+  void
+  evictRequest();
+
+private:
+  using AcceptedIndex = std::set<std::pair<time::steady_clock::time_point, Name>>;
+
+  Options m_options;
+  std::map<Name, KeyEntry> m_keys;
+  std::map<Name, RequestEntry> m_requests;
+  AcceptedIndex m_keyIndex;     //!< (lastAccepted, keyLocator) of every key, oldest first
+  AcceptedIndex m_requestIndex; //!< (lastAccepted, producer prefix) of every request, oldest first
+};
+
+} // namespace rv
+} // namespace kite
+} // namespace ndn
+
+#endif // NDN_TOOLS_KITE_RV_FRESHNESS_CACHE_HPP
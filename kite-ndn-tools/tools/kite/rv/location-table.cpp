@@ -0,0 +1,312 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "location-table.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'K', 'I', 'T', 'E', 'L', 'O', 'C', '1'};
+
+// TLV types of snapshot records, from the application-specific range
+enum : uint32_t {
+  TLV_LOCATION = 160,
+  TLV_EXPIRY = 161,
+  TLV_TIMESTAMP = 162,
+  TLV_NONCE = 163,
+  TLV_FACE_ID = 164,
+};
+
+class FileDescriptor : noncopyable
+{
+public:
+  explicit
+  FileDescriptor(int fd)
+    : fd(fd)
+  {
+  }
+
+  ~FileDescriptor()
+  {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+public:
+  int fd;
+};
+
+[[noreturn]] void
+throwErrno(const std::string& what, const std::string& path)
+{
+  NDN_THROW(LocationTable::Error(what + " " + path + ": " + std::strerror(errno)));
+}
+
+Block
+encodeLocation(const Location& location)
+{
+  Block block(TLV_LOCATION);
+  block.push_back(location.producerPrefix.wireEncode());
+  block.push_back(location.rvPrefix.wireEncode());
+  block.push_back(encoding::makeNonNegativeIntegerBlock(TLV_EXPIRY,
+                                                        time::toUnixTimestamp(location.expiry).count()));
+  if (location.timestamp) {
+    block.push_back(encoding::makeNonNegativeIntegerBlock(TLV_TIMESTAMP,
+                                                          time::toUnixTimestamp(*location.timestamp).count()));
+  }
+  if (!location.nonce.empty()) {
+    block.push_back(encoding::makeBinaryBlock(TLV_NONCE, location.nonce));
+  }
+  if (location.faceId) {
+    block.push_back(encoding::makeNonNegativeIntegerBlock(TLV_FACE_ID, *location.faceId));
+  }
+  block.encode();
+  return block;
+}
+
+Location
+decodeLocation(const Block& block)
+{
+  block.parse();
+  if (block.elements_size() < 3) {
+    NDN_THROW(tlv::Error("Incomplete location record"));
+  }
+  auto element = block.elements_begin();
+
+  Location location;
+  location.producerPrefix.wireDecode(*element++);
+  location.rvPrefix.wireDecode(*element++);
+  if (element->type() != TLV_EXPIRY) {
+    NDN_THROW(tlv::Error("Location record without expiry"));
+  }
+  location.expiry = time::fromUnixTimestamp(time::milliseconds(encoding::readNonNegativeInteger(*element++)));
+
+  for (; element != block.elements_end(); ++element) {
+    switch (element->type()) {
+      case TLV_TIMESTAMP:
+        location.timestamp = time::fromUnixTimestamp(time::milliseconds(encoding::readNonNegativeInteger(*element)));
+        break;
+      case TLV_NONCE:
+        location.nonce.assign(element->value_begin(), element->value_end());
+        break;
+      case TLV_FACE_ID:
+        location.faceId = encoding::readNonNegativeInteger(*element);
+        break;
+      default:
+        break;
+    }
+  }
+  return location;
+}
+
+} // namespace
+
+const Location&
+LocationTable::update(Location location)
+{
+  auto it = m_locations.find(location.producerPrefix);
+  if (it != m_locations.end()) {
+    m_expiryIndex.erase({it->second.expiry, it->first});
+    it->second = std::move(location);
+  }
+  else {
+    Name key = location.producerPrefix;
+    it = m_locations.emplace(std::move(key), std::move(location)).first;
+  }
+  m_expiryIndex.emplace(it->second.expiry, it->first);
+  return it->second;
+}
+
+const Location*
+LocationTable::find(const Name& producerPrefix) const
+{
+  auto it = m_locations.find(producerPrefix);
+  return it == m_locations.end() ? nullptr : &it->second;
+}
+
+const Location*
+LocationTable::findLongestPrefixMatch(const Name& name) const
+{
+  for (ssize_t prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
+    auto it = m_locations.find(name.getPrefix(prefixLen));
+    if (it != m_locations.end()) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+bool
+LocationTable::erase(const Name& producerPrefix)
+{
+  auto it = m_locations.find(producerPrefix);
+  if (it == m_locations.end()) {
+    return false;
+  }
+  m_expiryIndex.erase({it->second.expiry, it->first});
+  m_locations.erase(it);
+  return true;
+}
+
+size_t
+LocationTable::sweep(time::system_clock::time_point now)
+{
+  size_t nErased = 0;
+  while (!m_expiryIndex.empty() && m_expiryIndex.begin()->first <= now) {
+    m_locations.erase(m_expiryIndex.begin()->second);
+    m_expiryIndex.erase(m_expiryIndex.begin());
+    ++nErased;
+  }
+  return nErased;
+}
+
+optional<time::system_clock::time_point>
+LocationTable::getNextExpiry() const
+{
+  if (m_expiryIndex.empty()) {
+    return nullopt;
+  }
+  return m_expiryIndex.begin()->first;
+}
+
+void
+LocationTable::saveSnapshot(const std::string& path) const
+{
+  std::vector<Block> records;
+  records.reserve(m_locations.size());
+  size_t fileSize = sizeof(SNAPSHOT_MAGIC);
+  for (const auto& item : m_locations) {
+    records.push_back(encodeLocation(item.second));
+    fileSize += records.back().size();
+  }
+
+  // write to a temporary file and rename it, so a crash never leaves a partial snapshot
+  std::string tmpPath = path + ".tmp";
+  FileDescriptor file(::open(tmpPath.data(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+  if (file.fd < 0) {
+    throwErrno("Cannot create", tmpPath);
+  }
+  if (::ftruncate(file.fd, fileSize) != 0) {
+    throwErrno("Cannot resize", tmpPath);
+  }
+
+  void* addr = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+  if (addr == MAP_FAILED) {
+    throwErrno("Cannot map", tmpPath);
+  }
+  auto* out = static_cast<uint8_t*>(addr);
+  std::memcpy(out, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  out += sizeof(SNAPSHOT_MAGIC);
+  for (const auto& record : records) {
+    std::memcpy(out, record.data(), record.size());
+    out += record.size();
+  }
+  int syncResult = ::msync(addr, fileSize, MS_SYNC);
+  ::munmap(addr, fileSize);
+  if (syncResult != 0) {
+    throwErrno("Cannot flush", tmpPath);
+  }
+
+  if (::rename(tmpPath.data(), path.data()) != 0) {
+    throwErrno("Cannot replace", path);
+  }
+}
+
+size_t
+LocationTable::loadSnapshot(const std::string& path, time::system_clock::time_point now)
+{
+  FileDescriptor file(::open(path.data(), O_RDONLY));
+  if (file.fd < 0) {
+    if (errno == ENOENT) {
+      return 0;
+    }
+    throwErrno("Cannot open", path);
+  }
+  struct stat st;
+  if (::fstat(file.fd, &st) != 0) {
+    throwErrno("Cannot stat", path);
+  }
+  size_t fileSize = static_cast<size_t>(st.st_size);
+  if (fileSize < sizeof(SNAPSHOT_MAGIC)) {
+    NDN_THROW(Error("Snapshot " + path + " is truncated"));
+  }
+
+  void* addr = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file.fd, 0);
+  if (addr == MAP_FAILED) {
+    throwErrno("Cannot map", path);
+  }
+  const auto* begin = static_cast<const uint8_t*>(addr);
+  auto unmap = [=] { ::munmap(addr, fileSize); };
+  if (std::memcmp(begin, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+    unmap();
+    NDN_THROW(Error("Snapshot " + path + " has an unknown format"));
+  }
+
+  // records are merged only after the whole file has been decoded
+  std::vector<Location> restored;
+  size_t offset = sizeof(SNAPSHOT_MAGIC);
+  try {
+    while (offset < fileSize) {
+      bool isOk = false;
+      Block block;
+      std::tie(isOk, block) = Block::fromBuffer(make_span(begin + offset, fileSize - offset));
+      if (!isOk || block.type() != TLV_LOCATION) {
+        NDN_THROW(Error("Snapshot " + path + " is corrupted at offset " + to_string(offset)));
+      }
+      offset += block.size();
+
+      auto location = decodeLocation(block);
+      if (location.expiry > now) {
+        restored.push_back(std::move(location));
+      }
+    }
+  }
+  catch (const tlv::Error& e) {
+    unmap();
+    NDN_THROW(Error("Snapshot " + path + " has a malformed record: " + e.what()));
+  }
+  catch (...) {
+    unmap();
+    throw;
+  }
+  unmap();
+
+  for (auto& location : restored) {
+    update(std::move(location));
+  }
+  return restored.size();
+}
+
+} // namespace rv
+} // namespace kite
+} // namespace ndn
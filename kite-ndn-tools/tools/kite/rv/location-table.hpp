@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015-2019, Harbin Institute of Technology.
+ *
+ * This file is part of ndn-tools (Named Data Networking Essential Tools).
+ * See AUTHORS.md for complete list of ndn-tools authors and contributors.
+ *
+ * ndn-tools is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-tools is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndn-tools, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDN_TOOLS_KITE_RV_LOCATION_TABLE_HPP
+#define NDN_TOOLS_KITE_RV_LOCATION_TABLE_HPP
+
+#include "core/common.hpp"
+
+#include <map>
+#include <set>
+
+namespace ndn {
+namespace kite {
+namespace rv {
+
+/**
+ * @brief Where and until when a mobile producer was last seen by the RV
+ */
+struct Location
+{
+  Name producerPrefix;                   //!< announced producer prefix
+  Name rvPrefix;                         //!< RV prefix the request was sent to
+  optional<uint64_t> faceId;             //!< incoming face of the request, if known
+  time::system_clock::time_point expiry; //!< end of the announced lifetime
+  optional<time::system_clock::time_point> timestamp; //!< timestamp of the request
+  std::vector<uint8_t> nonce;            //!< nonce of the request
+};
+
+/**
+ * @brief Mobile-producer location table of the RV, keyed by producer prefix
+ *
+ * Records are also indexed by expiry, so sweeping k expired records costs O(k log n).
+ * The table can be saved to and restored from a snapshot file, which lets a restarted RV
+ * resume without waiting for every producer to send a new request.
+ */
+class LocationTable : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /**
+   * @brief Inserts or replaces the location of @p location.producerPrefix
+   */
+  const Location&
+  update(Location location);
+
+  const Location*
+  find(const Name& producerPrefix) const;
+
+  /**
+   * @return location of the longest producer prefix of @p name, or nullptr
+   */
+  const Location*
+  findLongestPrefixMatch(const Name& name) const;
+
+  bool
+  erase(const Name& producerPrefix);
+
+  /**
+   * @brief Removes records that expire at or before @p now
+   * @return number of removed records
+   */
+  size_t
+  sweep(time::system_clock::time_point now = time::system_clock::now());
+
+  /**
+   * @return earliest expiry in the table, or nullopt if the table is empty
+   */
+  optional<time::system_clock::time_point>
+  getNextExpiry() const;
+
+  size_t
+  size() const
+  {
+    return m_locations.size();
+  }
+
+  /**
+   * @brief Atomically replaces @p path with a snapshot of the table
+   * @throw Error the snapshot cannot be written
+   */
+  void
+  saveSnapshot(const std::string& path) const;
+
+  /**
+   * @brief Merges the unexpired records of the snapshot at @p path into the table
+   * @return number of restored records, 0 if @p path does not exist
+   * @throw Error the snapshot is corrupted; the table is left unchanged
+   */
+  size_t
+  loadSnapshot(const std::string& path, time::system_clock::time_point now = time::system_clock::now());
+
+private:
+  std::map<Name, Location> m_locations;
+  std::set<std::pair<time::system_clock::time_point, Name>> m_expiryIndex;
+};
+
+} // namespace rv
+} // namespace kite
+} // namespace ndn
+
+#endif // NDN_TOOLS_KITE_RV_LOCATION_TABLE_HPP
@@ -37,7 +37,7 @@ public:
   Runner(const Options& options)
     : m_options(options)
     , m_rv(m_face, m_keyChain, options)
-    , m_signalSet(m_face.getIoService(), SIGINT)
+    , m_signalSet(m_face.getIoService(), SIGINT, SIGTERM)
   {
     m_signalSet.async_wait([this] (const auto& ec, auto) {
       if (ec != boost::asio::error::operation_aborted) {
@@ -79,9 +79,9 @@ private:
 static void
 usage(std::ostream& os, const std::string& programName, const po::options_description& options)
 {
-  os << "Usage: " << programName << " [options] <prefix>\n"
+  os << "Usage: " << programName << " [options] <prefix>...\n"
      << "\n"
-     << "Starts a NDN ping server that responds to Interests under name ndn:<prefix>/ping\n"
+     << "Starts a KITE rendezvous server that answers KITE requests under each <prefix>\n"
      << "\n"
      << options;
 }
@@ -93,7 +93,11 @@ main(int argc, char* argv[])
   options.sendInterest = false;
   options.sendData = false;
   options.sendNack = false;
-  std::string prefix;
+  std::vector<std::string> prefixes;
+  time::milliseconds::rep keyCacheLifetime = options.keyCacheLifetime.count();
+  time::milliseconds::rep defaultLifetime = options.defaultLifetime.count();
+  time::milliseconds::rep snapshotInterval = options.snapshotInterval.count();
+  std::string statusPrefix;
 
   po::options_description visibleDesc("Options");
   visibleDesc.add_options()
@@ -103,12 +107,29 @@ main(int argc, char* argv[])
     ("send-nack,n", po::bool_switch(&options.sendNack), "when receive interest to mp, send nack. just for test.")
     ("send-data,d", po::bool_switch(&options.sendData), "send data when receive mp interest. just for test")
     ("send-interest,i", po::bool_switch(&options.sendInterest), "send interest to mp. just for test.")
+    ("workers,w",   po::value<size_t>(&options.nWorkers)->default_value(options.nWorkers),
+                    "number of signature verification and signing threads (0 to use the main thread), "
+                    "each holds a copy of the RV signing keys")
+    ("validator-config", po::value<std::string>(&options.validatorConfig)->default_value(options.validatorConfig),
+                    "trust schema that KITE requests are validated against")
+    ("key-cache-lifetime", po::value<time::milliseconds::rep>(&keyCacheLifetime)->default_value(keyCacheLifetime),
+                    "how long a verified producer key is reused, in milliseconds (0 to disable)")
+    ("default-lifetime", po::value<time::milliseconds::rep>(&defaultLifetime)->default_value(defaultLifetime),
+                    "route lifetime announced when the producer does not request one, in milliseconds")
+    ("status-prefix,s", po::value<std::string>(&statusPrefix),
+                    "serve counters as Data under this prefix, e.g. /localhost/kiterv/status, "
+                    "and the location of a producer under <prefix>/location/<producer name>")
+    ("snapshot",    po::value<std::string>(&options.snapshotPath),
+                    "save the producer location table to this file periodically and on exit, "
+                    "and restore it on start")
+    ("snapshot-interval", po::value<time::milliseconds::rep>(&snapshotInterval)->default_value(snapshotInterval),
+                    "how often a changed location table is saved, in milliseconds")
     ("version,V",   "print program version and exit")
     ;
 
   po::options_description hiddenDesc;
   hiddenDesc.add_options()
-    ("prefix", po::value<std::string>(&prefix));
+    ("prefix", po::value<std::vector<std::string>>(&prefixes));
 
   po::positional_options_description posDesc;
   posDesc.add("prefix", -1);
@@ -157,12 +178,37 @@ main(int argc, char* argv[])
     return 1;
   }
 
-  if (prefix.empty()) {
+  if (prefixes.empty()) {
     std::cerr << "ERROR: no name prefix specified\n\n";
     usage(std::cerr, argv[0], visibleDesc);
     return 2;
   }
-  options.prefixes.push_back(prefix);
+  options.prefixes.assign(prefixes.begin(), prefixes.end());
+
+  if (keyCacheLifetime < 0) {
+    std::cerr << "ERROR: key cache lifetime cannot be negative\n\n";
+    usage(std::cerr, argv[0], visibleDesc);
+    return 2;
+  }
+  options.keyCacheLifetime = time::milliseconds(keyCacheLifetime);
+
+  if (defaultLifetime <= 0) {
+    std::cerr << "ERROR: default lifetime must be positive\n\n";
+    usage(std::cerr, argv[0], visibleDesc);
+    return 2;
+  }
+  options.defaultLifetime = time::milliseconds(defaultLifetime);
+
+  if (snapshotInterval <= 0) {
+    std::cerr << "ERROR: snapshot interval must be positive\n\n";
+    usage(std::cerr, argv[0], visibleDesc);
+    return 2;
+  }
+  options.snapshotInterval = time::milliseconds(snapshotInterval);
+
+  if (!statusPrefix.empty()) {
+    options.statusPrefix = statusPrefix;
+  }
 
   return Runner(options).run();
 }
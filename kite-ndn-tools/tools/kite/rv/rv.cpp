@@ -23,8 +23,11 @@
 
 #include <ndn-cxx/kite/ack.hpp>
 #include <ndn-cxx/kite/request.hpp>
+#include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
 #include <ndn-cxx/util/logger.hpp>
+#include <ndn-cxx/util/random.hpp>
 
 namespace ndn {
 namespace kite {
@@ -32,26 +35,67 @@ namespace rv {
 
 NDN_LOG_INIT(kite.rv);
 
-const char* CONF_PATH = "/usr/local/etc/ndn/rv.conf";
-
 Rv::Rv(Face& face, KeyChain& keyChain, const Options& options)
   : m_options(options)
   , m_face(face)
   , m_keyChain(keyChain)
   , m_validator(face)
+  , m_freshnessCache([&options] {
+      FreshnessCache::Options cacheOptions;
+      cacheOptions.keyLifetime = options.keyCacheLifetime;
+      return cacheOptions;
+    }())
+  , m_scheduler(face.getIoService())
+{
+  m_validator.load(m_options.validatorConfig);
+}
+
+Rv::~Rv()
 {
-  m_validator.load(CONF_PATH);
+  m_workers.reset();
 }
 
 void
 Rv::start()
 {
-  m_registeredPrefix = m_face.setInterestFilter(
-                       Name(m_options.prefixes[0]),
-                       bind(&Rv::onInterest, this, _2),
-                       [] (const auto&, const auto& reason) {
-                         NDN_THROW(std::runtime_error("Failed to register prefix: " + reason));
-                       });
+  m_signingCerts.clear();
+  for (const auto& prefix : m_options.prefixes) {
+    m_signingCerts.push_back(m_keyChain.getPib().getIdentity(prefix)
+                             .getDefaultKey().getDefaultCertificate().getName());
+  }
+  if (m_options.nWorkers > 0 && !setupWorkers()) {
+    m_workers.reset();
+  }
+
+  if (!m_options.snapshotPath.empty()) {
+    try {
+      auto nRestored = m_locations.loadSnapshot(m_options.snapshotPath);
+      NDN_LOG_INFO("Restored " << nRestored << " producer locations from " << m_options.snapshotPath);
+    }
+    catch (const LocationTable::Error& e) {
+      // the next save replaces the unusable file
+      NDN_LOG_WARN(e.what() << ", starting with an empty location table");
+    }
+    scheduleSweep();
+    scheduleSnapshot();
+  }
+
+  for (size_t i = 0; i < m_options.prefixes.size(); ++i) {
+    m_registeredPrefixes.push_back(m_face.setInterestFilter(
+      m_options.prefixes[i],
+      [this, i] (const auto&, const auto& interest) { this->onInterest(interest, i); },
+      [] (const auto&, const auto& reason) {
+        NDN_THROW(std::runtime_error("Failed to register prefix: " + reason));
+      }));
+  }
+  if (!m_options.statusPrefix.empty()) {
+    m_statusPrefix = m_face.setInterestFilter(
+      m_options.statusPrefix,
+      [this] (const auto&, const auto& interest) { this->onStatusInterest(interest); },
+      [] (const auto&, const auto& reason) {
+        NDN_THROW(std::runtime_error("Failed to register status prefix: " + reason));
+      });
+  }
   if(m_options.mpListen) {
   m_mpPrefix = m_face.setInterestFilter(
     Name(m_options.mpName),
@@ -65,18 +109,212 @@ Rv::start()
 void
 Rv::stop()
 {
-  m_registeredPrefix.unregister(); 
+  for (auto& handle : m_registeredPrefixes) {
+    handle.unregister();
+  }
+  m_registeredPrefixes.clear();
+  m_statusPrefix.unregister();
+  m_workers.reset();
+  m_alive = make_shared<int>();
+  m_sweepEvent.cancel();
+  m_snapshotEvent.cancel();
+  if (!m_options.snapshotPath.empty()) {
+    saveSnapshot();
+  }
 }
 
+bool
+Rv::setupWorkers()
+{
+  m_workers = make_unique<WorkerPool>(m_options.nWorkers);
+
+  // the password only protects the SafeBag while it is copied in memory
+  std::array<char, 16> pw;
+  random::generateSecureBytes(make_span(reinterpret_cast<uint8_t*>(pw.data()), pw.size()));
+  for (const auto& prefix : m_options.prefixes) {
+    try {
+      auto cert = m_keyChain.getPib().getIdentity(prefix).getDefaultKey().getDefaultCertificate();
+      auto safeBag = m_keyChain.exportSafeBag(cert, pw.data(), pw.size());
+      m_workers->importSigningKey(*safeBag, pw.data(), pw.size());
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_WARN("Cannot copy signing key of " << prefix << " to workers, signing on the Face thread: "
+                   << e.what());
+      return false;
+    }
+  }
+  return true;
+}
 
 void
-Rv::onInterest(const Interest& interest)
+Rv::onInterest(const Interest& interest, size_t prefixIndex)
 {
   afterReceive(interest.getName());
+  ++m_stats.nRequests;
+
+  Request req;
+  try {
+    req.decode(interest);
+  }
+  catch (const Request::Error& e) {
+    NDN_LOG_DEBUG("Malformed KITE request " << interest.getName() << ": " << e.what());
+    ++m_stats.nMalformed;
+    return;
+  }
+
+  // Request::decode() has checked that the request is signed
+  auto sigInfo = interest.getSignatureInfo();
+  const auto& keyLocator = sigInfo->getKeyLocator();
+  if (keyLocator.getType() == tlv::Name) {
+    auto lookup = m_freshnessCache.lookup(req, keyLocator.getName());
+    switch (lookup.decision) {
+      case FreshnessCache::Decision::REJECT:
+        NDN_LOG_DEBUG("Stale KITE request " << interest.getName());
+        ++m_stats.nStale;
+        ++m_stats.nRejected;
+        return;
+      case FreshnessCache::Decision::VERIFY:
+        verifyWithCachedKey(interest, req, prefixIndex, keyLocator.getName(), std::move(lookup.key));
+        return;
+      case FreshnessCache::Decision::VALIDATE:
+        break;
+    }
+  }
+
+  validate(interest, req, prefixIndex);
+}
 
+void
+Rv::validate(const Interest& interest, const Request& req, size_t prefixIndex)
+{
   m_validator.validate(interest,
-                       std::bind(&Rv::onSuccess, this, _1),
-                       std::bind(&Rv::onFailure, this, _1, _2));
+                       [this, req, prefixIndex] (const Interest& i) { onSuccess(i, req, prefixIndex); },
+                       [this] (const Interest& i, const auto& error) { onFailure(i, error); });
+}
+
+void
+Rv::verifyWithCachedKey(const Interest& interest, const Request& req, size_t prefixIndex,
+                        const Name& keyLocator, shared_ptr<const security::transform::PublicKey> key)
+{
+  if (m_workers == nullptr) {
+    bool isValid = false;
+    try {
+      isValid = security::verifySignature(interest, *key);
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_DEBUG("Cannot verify " << interest.getName() << ": " << e.what());
+    }
+    onCachedKeyVerified(interest, req, prefixIndex, keyLocator, isValid, nullopt);
+    return;
+  }
+
+  // the Ack is signed on the same worker, it is dropped if the request turns out to be stale
+  m_workers->post([this, alive = weak_ptr<int>(m_alive), interest, req, prefixIndex, keyLocator,
+                   key = std::move(key), certName = m_signingCerts[prefixIndex]] (KeyChain& keyChain) {
+    bool isValid = false;
+    optional<Data> ack;
+    try {
+      isValid = security::verifySignature(interest, *key);
+      if (isValid) {
+        ack = makeAck(interest, req, keyChain, certName);
+      }
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_DEBUG("Cannot process " << interest.getName() << ": " << e.what());
+    }
+    boost::asio::post(m_face.getIoService(), [=] {
+      if (alive.expired()) {
+        return;
+      }
+      onCachedKeyVerified(interest, req, prefixIndex, keyLocator, isValid, ack);
+    });
+  });
+}
+
+void
+Rv::onCachedKeyVerified(const Interest& interest, const Request& req, size_t prefixIndex,
+                        const Name& keyLocator, bool isValid, optional<Data> ack)
+{
+  if (!isValid) {
+    // let the full validator decide, it also refreshes the cached key
+    validate(interest, req, prefixIndex);
+    return;
+  }
+  if (!m_freshnessCache.accept(req, keyLocator)) {
+    NDN_LOG_DEBUG("KITE request " << interest.getName() << " became stale during verification");
+    ++m_stats.nStale;
+    ++m_stats.nRejected;
+    return;
+  }
+
+  ++m_stats.nCacheHits;
+  recordLocation(interest, req, prefixIndex);
+  if (ack) {
+    ++m_stats.nAcks;
+    m_face.put(*ack);
+  }
+  else {
+    sendAck(interest, req, prefixIndex);
+  }
+}
+
+void
+Rv::onStatusInterest(const Interest& interest)
+{
+  static const name::Component LOCATION_COMPONENT("location");
+  const Name& name = interest.getName();
+  size_t prefixSize = m_options.statusPrefix.size();
+  if (name.size() > prefixSize && name[prefixSize] == LOCATION_COMPONENT) {
+    onLocationInterest(interest, name.getSubName(prefixSize + 1));
+    return;
+  }
+
+  std::ostringstream os;
+  os << "prefixes=" << m_options.prefixes.size() << "\n"
+     << "requests=" << m_stats.nRequests << "\n"
+     << "malformed=" << m_stats.nMalformed << "\n"
+     << "validated=" << m_stats.nValidated << "\n"
+     << "cache-hits=" << m_stats.nCacheHits << "\n"
+     << "rejected=" << m_stats.nRejected << "\n"
+     << "stale=" << m_stats.nStale << "\n"
+     << "acks=" << m_stats.nAcks << "\n"
+     << "cached-keys=" << m_freshnessCache.getNKeys() << "\n"
+     << "cached-requests=" << m_freshnessCache.size() << "\n"
+     << "locations=" << m_locations.size() << "\n"
+     << "workers=" << (m_workers == nullptr ? 0 : m_workers->size()) << "\n"
+     << "worker-queue=" << (m_workers == nullptr ? 0 : m_workers->getNPending()) << "\n";
+  putStatus(interest, os.str());
+}
+
+void
+Rv::onLocationInterest(const Interest& interest, const Name& name)
+{
+  const Location* location = m_locations.findLongestPrefixMatch(name);
+  if (location == nullptr || location->expiry <= time::system_clock::now()) {
+    putStatus(interest, "", tlv::ContentType_Nack);
+    return;
+  }
+
+  std::ostringstream os;
+  os << "producer=" << location->producerPrefix << "\n"
+     << "rv=" << location->rvPrefix << "\n";
+  if (location->faceId) {
+    os << "face=" << *location->faceId << "\n";
+  }
+  os << "expires-in=" << time::duration_cast<time::milliseconds>(
+                           location->expiry - time::system_clock::now()).count() << "\n";
+  putStatus(interest, os.str());
+}
+
+void
+Rv::putStatus(const Interest& interest, const std::string& content, uint32_t contentType)
+{
+  Data data(interest.getName());
+  data.setContentType(contentType);
+  data.setFreshnessPeriod(1_s);
+  data.setContent(make_span(reinterpret_cast<const uint8_t*>(content.data()), content.size()));
+  m_keyChain.sign(data, security::signingWithSha256());
+  m_face.put(data);
 }
 
 void
@@ -109,32 +347,144 @@ Rv::onMpInterest(const Interest& interest)
 
 
 void
-Rv::onSuccess(const Interest& interest)
+Rv::onSuccess(const Interest& interest, const Request& req, size_t prefixIndex)
 {
   NDN_LOG_DEBUG("Verification success for: " << interest.getName());
+  ++m_stats.nValidated;
 
-  Request req;
-  req.decode(interest);
-  Ack ack;
-  PrefixAnnouncement pa;
-  pa.setAnnouncedName(req.getProducerPrefix());
+  auto sigInfo = interest.getSignatureInfo();
+  const auto& keyLocator = sigInfo->getKeyLocator();
+  if (keyLocator.getType() == tlv::Name) {
+    const security::Certificate* cert = m_validator.getVerifiedCertCache().find(keyLocator.getName());
+    if (cert == nullptr) {
+      cert = m_validator.getTrustAnchors().find(keyLocator.getName());
+    }
+    if (cert != nullptr) {
+      m_freshnessCache.insert(req, keyLocator.getName(), *cert);
+    }
+  }
+
+  recordLocation(interest, req, prefixIndex);
+  sendAck(interest, req, prefixIndex);
+}
+
+void
+Rv::recordLocation(const Interest& interest, const Request& req, size_t prefixIndex)
+{
+  Location location;
+  location.producerPrefix = req.getProducerPrefix();
+  location.rvPrefix = m_options.prefixes[prefixIndex];
+  auto incomingFaceId = interest.getTag<lp::IncomingFaceIdTag>();
+  if (incomingFaceId != nullptr) {
+    location.faceId = *incomingFaceId;
+  }
+  location.expiry = time::system_clock::now() + getAnnouncedLifetime(req);
+  location.timestamp = req.getTimestamp();
+  if (req.getNonce()) {
+    location.nonce = *req.getNonce();
+  }
+  const auto& record = m_locations.update(std::move(location));
+  m_hasUnsavedLocations = true;
+
+  if (!m_nextSweep || record.expiry < *m_nextSweep) {
+    scheduleSweep();
+  }
+}
+
+void
+Rv::scheduleSweep()
+{
+  m_nextSweep = m_locations.getNextExpiry();
+  if (!m_nextSweep) {
+    m_sweepEvent.cancel();
+    return;
+  }
+  auto delay = std::max<time::nanoseconds>(*m_nextSweep - time::system_clock::now(), 0_ns);
+  m_sweepEvent = m_scheduler.schedule(delay, [this] {
+    auto nErased = m_locations.sweep();
+    NDN_LOG_DEBUG("Expired " << nErased << " producer locations");
+    m_hasUnsavedLocations = m_hasUnsavedLocations || nErased > 0;
+    scheduleSweep();
+  });
+}
+
+void
+Rv::scheduleSnapshot()
+{
+  m_snapshotEvent = m_scheduler.schedule(m_options.snapshotInterval, [this] {
+    if (m_hasUnsavedLocations) {
+      saveSnapshot();
+    }
+    scheduleSnapshot();
+  });
+}
+
+void
+Rv::saveSnapshot()
+{
+  try {
+    m_locations.saveSnapshot(m_options.snapshotPath);
+    m_hasUnsavedLocations = false;
+  }
+  catch (const LocationTable::Error& e) {
+    NDN_LOG_WARN(e.what());
+  }
+}
+
+void
+Rv::sendAck(const Interest& interest, const Request& req, size_t prefixIndex)
+{
+  const Name& certName = m_signingCerts[prefixIndex];
+  if (m_workers == nullptr) {
+    ++m_stats.nAcks;
+    m_face.put(makeAck(interest, req, m_keyChain, certName));
+    return;
+  }
+
+  m_workers->post([this, alive = weak_ptr<int>(m_alive), interest, req, certName] (KeyChain& keyChain) {
+    try {
+      auto ack = makeAck(interest, req, keyChain, certName);
+      boost::asio::post(m_face.getIoService(), [this, alive, ack = std::move(ack)] {
+        if (alive.expired()) {
+          return;
+        }
+        ++m_stats.nAcks;
+        m_face.put(ack);
+      });
+    }
+    catch (const std::exception& e) {
+      NDN_LOG_DEBUG("Cannot sign Ack for " << interest.getName() << ": " << e.what());
+    }
+  });
+}
+
+time::milliseconds
+Rv::getAnnouncedLifetime(const Request& req) const
+{
   if (req.getExpiration()) {
     NDN_LOG_DEBUG("Has expiration: " << std::to_string(req.getExpiration()->count()) << " ms");
-    pa.setExpiration(*req.getExpiration());
-  }
-  else {
-    NDN_LOG_DEBUG("Expiration not set, setting to 1000 ms...");
-    pa.setExpiration(1000_ms);
+    return *req.getExpiration();
   }
+  NDN_LOG_DEBUG("Expiration not set, using " << m_options.defaultLifetime);
+  return m_options.defaultLifetime;
+}
 
+Data
+Rv::makeAck(const Interest& interest, const Request& req, KeyChain& keyChain, const Name& certName) const
+{
+  Ack ack;
+  PrefixAnnouncement pa;
+  pa.setAnnouncedName(req.getProducerPrefix());
+  pa.setExpiration(getAnnouncedLifetime(req));
   ack.setPrefixAnnouncement(pa);
 
-  m_face.put(ack.makeData(interest, m_keyChain, ndn::security::signingByIdentity(m_options.prefixes[0])));
+  return ack.makeData(interest, keyChain, ndn::security::signingByCertificate(certName));
 }
 
 void
 Rv::onFailure(const Interest& interest, const ValidationError& error)
 {
+  ++m_stats.nRejected;
   NDN_LOG_DEBUG("Verification failure for: " << interest.getName() << "\nError: " << error);
 }
 
@@ -23,7 +23,11 @@
 #define NDN_TOOLS_KITE_RV_HPP
 
 #include "core/common.hpp"
+#include "freshness-cache.hpp"
+#include "location-table.hpp"
+#include "tools/kite/common/worker-pool.hpp"
 
+#include <ndn-cxx/kite/request.hpp>
 #include <ndn-cxx/security/validator.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 
@@ -39,11 +43,33 @@ namespace rv {
 struct Options
 {
   std::vector<Name> prefixes; //!< prefixes to register
+  std::string validatorConfig = "/usr/local/etc/ndn/rv.conf"; //!< trust schema of KITE requests
   bool mpListen;
   bool sendNack;
   bool sendData;
   bool sendInterest;
   std::string mpName;
+  size_t nWorkers = 0;                    //!< verification and signing threads (0 == Face thread)
+  time::milliseconds keyCacheLifetime = 1_h; //!< how long a verified producer key is trusted
+  Name statusPrefix;                      //!< prefix of the stats endpoint (empty == disabled)
+  std::string snapshotPath;               //!< location table snapshot file (empty == not persisted)
+  time::milliseconds snapshotInterval = 1_min; //!< how often a changed location table is saved
+  /// route lifetime announced when the producer does not request one; routers may shorten it
+  time::milliseconds defaultLifetime = 5_min;
+};
+
+/**
+ * @brief Counters of an Rv
+ */
+struct Stats
+{
+  uint64_t nRequests = 0;  //!< KITE requests received
+  uint64_t nMalformed = 0; //!< requests that could not be decoded
+  uint64_t nValidated = 0; //!< requests accepted by the full validator
+  uint64_t nCacheHits = 0; //!< requests accepted with a cached producer key
+  uint64_t nRejected = 0;  //!< requests that failed validation
+  uint64_t nStale = 0;     //!< requests rejected by the freshness cache, included in nRejected
+  uint64_t nAcks = 0;      //!< Acks sent
 };
 
 /**
@@ -54,6 +80,11 @@ class Rv : noncopyable
 public:
   Rv(Face& face, KeyChain& keyChain, const Options& options);
 
+  /**
+   * @brief Joins the workers before the members they post back to go away
+   */
+  ~Rv();
+
   /**
    * @brief Signals when Interest received
    *
@@ -71,10 +102,26 @@ public:
 
   /**
    * @brief Unregister set interest filter
+   *
+   * The workers are joined, and results they have posted but the Face thread has not
+   * handled yet are dropped. The location table is then saved to Options::snapshotPath,
+   * where it is also saved every Options::snapshotInterval while it changes.
    */
   void
   stop();
 
+  const Stats&
+  getStats() const
+  {
+    return m_stats;
+  }
+
+  const LocationTable&
+  getLocationTable() const
+  {
+    return m_locations;
+  }
+
 private:
   /**
    * @brief Called when Interest received
@@ -82,7 +129,84 @@ private:
    * @param interest incoming Interest
    */
   void
-  onInterest(const Interest& interest);
+  onInterest(const Interest& interest, size_t prefixIndex);
+
+  /**
+   * @brief Serves the counters, or under `<statusPrefix>/location` the location of a producer
+   */
+  void
+  onStatusInterest(const Interest& interest);
+
+  /**
+   * @brief Replies with the location of the longest producer prefix of @p name,
+   *        or with an application Nack if no producer matches
+   */
+  void
+  onLocationInterest(const Interest& interest, const Name& name);
+
+  void
+  putStatus(const Interest& interest, const std::string& content, uint32_t contentType = tlv::ContentType_Blob);
+
+  /**
+   * @brief Validates a request with the full validator
+   */
+  void
+  validate(const Interest& interest, const Request& req, size_t prefixIndex);
+
+  /**
+   * @brief Checks the signature of a request against a key from the freshness cache
+   */
+  void
+  verifyWithCachedKey(const Interest& interest, const Request& req, size_t prefixIndex,
+                      const Name& keyLocator, shared_ptr<const security::transform::PublicKey> key);
+
+  /**
+   * @brief Accepts or re-validates a request after verifyWithCachedKey
+   * @param ack the Ack signed on a worker thread, if any
+   */
+  void
+  onCachedKeyVerified(const Interest& interest, const Request& req, size_t prefixIndex,
+                      const Name& keyLocator, bool isValid, optional<Data> ack);
+
+  /**
+   * @brief Copies the RV signing keys into the worker KeyChains
+   * @return false if a key cannot be exported, in which case Acks are signed on the Face thread
+   */
+  bool
+  setupWorkers();
+
+  /**
+   * @brief Signs the Ack for a validated request and sends it
+   */
+  void
+  sendAck(const Interest& interest, const Request& req, size_t prefixIndex);
+
+  /**
+   * @brief Remembers where the producer of an accepted request is attached
+   */
+  void
+  recordLocation(const Interest& interest, const Request& req, size_t prefixIndex);
+
+  void
+  scheduleSweep();
+
+  void
+  scheduleSnapshot();
+
+  void
+  saveSnapshot();
+
+  /**
+   * @return the lifetime requested by the producer, or Options::defaultLifetime
+   */
+  time::milliseconds
+  getAnnouncedLifetime(const Request& req) const;
+
+  /**
+   * @note Called from the worker threads, it only reads the immutable options
+   */
+  Data
+  makeAck(const Interest& interest, const Request& req, KeyChain& keyChain, const Name& certName) const;
 
   void
   onMpInterest(const Interest& interest);
@@ -98,7 +222,7 @@ private:
   // processKiteRequest(const Interest& interest);
 
   void
-  onSuccess(const Interest& interest);
+  onSuccess(const Interest& interest, const Request& req, size_t prefixIndex);
 
   void
   onFailure(const Interest& interest, const ValidationError& error);
@@ -116,10 +240,23 @@ private:
   const Options& m_options;
   Face& m_face;
   KeyChain& m_keyChain;
-  RegisteredPrefixHandle m_registeredPrefix;
+  std::vector<RegisteredPrefixHandle> m_registeredPrefixes;
+  RegisteredPrefixHandle m_statusPrefix;
   InterestFilterHandle m_mpPrefix;
   ndn::security::ValidatorConfig m_validator;
   PendingInterestHandle m_pendingInterest;
+  std::vector<Name> m_signingCerts; //!< default certificate of each served prefix
+  FreshnessCache m_freshnessCache;
+  unique_ptr<WorkerPool> m_workers;
+  /// expires when the Rv stops, worker results posted to the Face thread check it first
+  shared_ptr<int> m_alive = make_shared<int>();
+  Stats m_stats;
+  Scheduler m_scheduler;
+  LocationTable m_locations;
+  optional<time::system_clock::time_point> m_nextSweep;
+  scheduler::ScopedEventId m_sweepEvent;
+  bool m_hasUnsavedLocations = false;
+  scheduler::ScopedEventId m_snapshotEvent;
 };
 
 } // namespace rv
@@ -5,7 +5,7 @@ NFD1_INIT="nfdc route add /kite-test/rv tcp://${NFD2_ADDR}:6363"
 
 NFD2_INIT="NDN_LOG=kite.*=ALL kiterv /kite-test/rv "
 
-NFD1_TEST="NDN_LOG=kite.*=ALL kiteproducer -r /kite-test/rv -p /kite-test/alice -l 1000000"
+NFD1_TEST="NDN_LOG=kite.*=ALL kiteproducer -m -r /kite-test/rv -p /kite-test/alice -l 1000000"
 
 NFD3_TEST="ndnpeek $TEST_FILE$ -v -w 2000 -r /kite-test/rv"
 
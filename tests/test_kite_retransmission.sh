@@ -10,8 +10,8 @@ NFD2_INIT="NDN_LOG=kite.*=ALL kiterv /kite-test/rv"
 
 NFD1_TEST="ndnpeek $TEST_FILE$ -v -w 4000 -r /kite-test/rv"
 
-NFD3_TEST="NDN_LOG=kite.*=ALL kiteproducer -r /kite-test/rv -p /kite-test/alice -l 1000000 -a 1 >nfd3.log 2>&1"
-NFD4_TEST="NDN_LOG=kite.*=ALL kiteproducer -r /kite-test/rv -p /kite-test/alice -l 1000000 >nfd4.log 2>&1"
+NFD3_TEST="NDN_LOG=kite.*=ALL kiteproducer -m -r /kite-test/rv -p /kite-test/alice -l 1000000 -a 1 >nfd3.log 2>&1"
+NFD4_TEST="NDN_LOG=kite.*=ALL kiteproducer -m -r /kite-test/rv -p /kite-test/alice -l 1000000 >nfd4.log 2>&1"
 
 
 NFD3_CLEAR="\
@@ -7,7 +7,7 @@ NFD2_INIT="NDN_LOG=kite.*=ALL kiterv /kite-test/rv -m /kite-test/alice -l >nfd2.
 NFD3_INIT="nfdc route add /kite-test/rv tcp://${NFD2_ADDR}:6363"
 
 NFD1_TEST="ndnpeek $TEST_FILE$ -v -w 4000 -r /kite-test/rv"
-NFD3_TEST="NDN_LOG=kite.*=ALL kiteproducer -r /kite-test/rv -p /kite-test/alice -l 1000000 -a 1 >nfd3.log 2>&1"
+NFD3_TEST="NDN_LOG=kite.*=ALL kiteproducer -m -r /kite-test/rv -p /kite-test/alice -l 1000000 -a 1 >nfd3.log 2>&1"
 
 NFD1_CLEAR="
 nfdc cs erase / && \